@@ -379,13 +379,7 @@ void dCustomJoint::SubmitLinearRows(int activeRows, const dMatrix& matrix0, cons
 {
 	const dVector& p0 = matrix0.m_posit;
 	const dVector& p1 = matrix1.m_posit;
-	for (int i = 0; i < 3; i++) {
-		if (activeRows & (1 << i)) {
-			const dVector& dir = matrix1[i];
-			NewtonUserJointAddLinearRow(m_joint, &p0[0], &p1[0], &dir[0]);
-			NewtonUserJointSetRowStiffness(m_joint, m_stiffness);
-		}
-	}
+	NewtonUserJointAddLinearRows(m_joint, activeRows, &p0[0], &p1[0], &matrix1[0][0], m_stiffness);
 }
 
 void dCustomJoint::SetJointForceCalculation(bool mode)
@@ -58,6 +58,7 @@
 #include "dgGeneralVector.h"
 #include "dgGeneralMatrix.h"
 #include "dgAABBPolygonSoup.h"
+#include "dgPredicates.h"
 #include "dgSmallDeterminant.h"
 #include "dgPolygonSoupBuilder.h"
 #include "dgPolygonSoupDatabase.h"
@@ -24,11 +24,16 @@
 #include "dgStack.h"
 #include "dgList.h"
 #include "dgMatrix.h"
+#include "dgThreadHive.h"
 #include "dgAABBPolygonSoup.h"
 #include "dgPolygonSoupBuilder.h"
 
 
 #define DG_STACK_DEPTH 512
+#define DG_AABB_POLYGON_SOUP_IMAGE_SIGNATURE	0x31564264
+#define DG_AABB_POLYGON_SOUP_IMAGE_ALIGNMENT	16
+#define DG_AABB_POLYGON_SOUP_SAH_BINS			16
+#define DG_AABB_POLYGON_SOUP_MIN_SUBTREE		1024
 
 
 DG_MSC_VECTOR_ALIGMENT
@@ -139,11 +144,12 @@ class dgAABBPolygonSoup::dgNodeBuilder: public dgAABBPolygonSoup::dgNode
 class dgAABBPolygonSoup::dgSpliteInfo
 {
 	public:
-	dgSpliteInfo (dgNodeBuilder* const boxArray, dgInt32 boxCount)
+	dgSpliteInfo (dgNodeBuilder* const boxArray, dgInt32 boxCount, dgInt32 buildQuality)
 	{
 		dgVector minP ( dgFloat32 (1.0e15f)); 
 		dgVector maxP (-dgFloat32 (1.0e15f)); 
 
+		m_axis = 0;
 		if (boxCount == 2) {
 			m_axis = 1;
 			for (dgInt32 i = 0; i < boxCount; i ++) {
@@ -154,7 +160,11 @@ class dgAABBPolygonSoup::dgSpliteInfo
 				maxP = maxP.GetMax (p1); 
 			}
 
-		} else {
+		} else if (buildQuality == m_buildBestSah) {
+			m_axis = SurfaceAreaSplit (boxArray, boxCount, minP, maxP);
+		}
+
+		if (!m_axis) {
 			dgVector median (dgFloat32 (0.0f));
 			dgVector varian (dgFloat32 (0.0f));
 			for (dgInt32 i = 0; i < boxCount; i ++) {
@@ -227,6 +237,106 @@ class dgAABBPolygonSoup::dgSpliteInfo
 		m_p1 = maxP;
 	}
 
+	private:
+	static dgFloat32 BoxArea (const dgVector& p0, const dgVector& p1)
+	{
+		dgVector side0 ((p1 - p0) & dgVector::m_triplexMask);
+		dgVector side1 (side0.ShiftTripleLeft());
+		return side0.DotProduct(side1).GetScalar();
+	}
+
+	// binned surface area heuristic, return zero if the boxes can not be separated along the best axis
+	static dgInt32 SurfaceAreaSplit (dgNodeBuilder* const boxArray, dgInt32 boxCount, dgVector& minP, dgVector& maxP)
+	{
+		dgVector minCenter ( dgFloat32 (1.0e15f)); 
+		dgVector maxCenter (-dgFloat32 (1.0e15f)); 
+		for (dgInt32 i = 0; i < boxCount; i ++) {
+			const dgNodeBuilder& box = boxArray[i];
+			minP = minP.GetMin (box.m_p0); 
+			maxP = maxP.GetMax (box.m_p1); 
+			minCenter = minCenter.GetMin (box.m_origin); 
+			maxCenter = maxCenter.GetMax (box.m_origin); 
+		}
+
+		dgInt32 axis = 0;
+		dgVector extend ((maxCenter - minCenter) & dgVector::m_triplexMask);
+		for (dgInt32 i = 1; i < 3; i ++) {
+			if (extend[i] > extend[axis]) {
+				axis = i;
+			}
+		}
+		if (extend[axis] < dgFloat32 (1.0e-4f)) {
+			return 0;
+		}
+
+		dgInt32 binCount[DG_AABB_POLYGON_SOUP_SAH_BINS];
+		dgVector binP0[DG_AABB_POLYGON_SOUP_SAH_BINS];
+		dgVector binP1[DG_AABB_POLYGON_SOUP_SAH_BINS];
+		for (dgInt32 i = 0; i < DG_AABB_POLYGON_SOUP_SAH_BINS; i ++) {
+			binCount[i] = 0;
+			binP0[i] = dgVector ( dgFloat32 (1.0e15f)); 
+			binP1[i] = dgVector (-dgFloat32 (1.0e15f)); 
+		}
+
+		const dgFloat32 origin = minCenter[axis];
+		const dgFloat32 scale = dgFloat32 (DG_AABB_POLYGON_SOUP_SAH_BINS) * dgFloat32 (0.9999f) / extend[axis];
+		for (dgInt32 i = 0; i < boxCount; i ++) {
+			const dgNodeBuilder& box = boxArray[i];
+			const dgInt32 bin = dgClamp (dgInt32 ((box.m_origin[axis] - origin) * scale), 0, DG_AABB_POLYGON_SOUP_SAH_BINS - 1);
+			binCount[bin] ++;
+			binP0[bin] = binP0[bin].GetMin (box.m_p0);
+			binP1[bin] = binP1[bin].GetMax (box.m_p1);
+		}
+
+		dgFloat32 rightCost[DG_AABB_POLYGON_SOUP_SAH_BINS];
+		dgVector p0 ( dgFloat32 (1.0e15f)); 
+		dgVector p1 (-dgFloat32 (1.0e15f)); 
+		dgInt32 count = 0;
+		for (dgInt32 i = DG_AABB_POLYGON_SOUP_SAH_BINS - 1; i > 0; i --) {
+			count += binCount[i];
+			p0 = p0.GetMin (binP0[i]);
+			p1 = p1.GetMax (binP1[i]);
+			rightCost[i] = count ? BoxArea (p0, p1) * dgFloat32 (count) : dgFloat32 (0.0f);
+		}
+
+		dgInt32 bestBin = -1;
+		dgFloat32 bestCost = dgFloat32 (1.0e30f);
+		p0 = dgVector ( dgFloat32 (1.0e15f)); 
+		p1 = dgVector (-dgFloat32 (1.0e15f)); 
+		count = 0;
+		for (dgInt32 i = 0; i < DG_AABB_POLYGON_SOUP_SAH_BINS - 1; i ++) {
+			count += binCount[i];
+			p0 = p0.GetMin (binP0[i]);
+			p1 = p1.GetMax (binP1[i]);
+			if (count && (count < boxCount)) {
+				const dgFloat32 cost = BoxArea (p0, p1) * dgFloat32 (count) + rightCost[i + 1];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestBin = i;
+				}
+			}
+		}
+		if (bestBin < 0) {
+			return 0;
+		}
+
+		dgInt32 i0 = 0;
+		dgInt32 i1 = boxCount - 1;
+		while (i0 <= i1) {
+			const dgInt32 bin = dgClamp (dgInt32 ((boxArray[i0].m_origin[axis] - origin) * scale), 0, DG_AABB_POLYGON_SOUP_SAH_BINS - 1);
+			if (bin <= bestBin) {
+				i0 ++;
+			} else {
+				dgSwap (boxArray[i0], boxArray[i1]);
+				i1 --;
+			}
+		}
+		dgAssert (i0 > 0);
+		dgAssert (i0 < boxCount);
+		return i0;
+	}
+
+	public:
 	dgInt32 m_axis;
 	dgVector m_p0;
 	dgVector m_p1;
@@ -234,18 +344,65 @@ class dgAABBPolygonSoup::dgSpliteInfo
 
 
 
+class dgAABBPolygonSoup::dgSubTreeBuild
+{
+	public:
+	dgNodeBuilder* m_parent;
+	dgNodeBuilder* m_allocator;
+	dgInt32 m_firstBox;
+	dgInt32 m_lastBox;
+	bool m_isRight;
+};
+
+class dgAABBPolygonSoup::dgParallelBuild
+{
+	public:
+	dgParallelBuild (dgMemoryAllocator* const allocator, dgNodeBuilder* const leafArray, dgInt32 leafCount, dgInt32 threadCount, dgInt32 buildQuality)
+		:m_subTrees(allocator)
+		,m_leafArray(leafArray)
+		,m_grainSize(dgMax (leafCount / (threadCount * 8), DG_AABB_POLYGON_SOUP_MIN_SUBTREE))
+		,m_buildQuality(buildQuality)
+		,m_atomicIndex(0)
+		,m_subTreeCount(0)
+	{
+	}
+
+	void AddSubTree (dgNodeBuilder* const parent, bool isRight, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator)
+	{
+		dgSubTreeBuild& subTree = m_subTrees[m_subTreeCount];
+		subTree.m_parent = parent;
+		subTree.m_allocator = *allocator;
+		subTree.m_firstBox = firstBox;
+		subTree.m_lastBox = lastBox;
+		subTree.m_isRight = isRight;
+		*allocator = *allocator + (lastBox - firstBox);
+		m_subTreeCount ++;
+	}
+
+	dgArray<dgSubTreeBuild> m_subTrees;
+	dgNodeBuilder* m_leafArray;
+	dgInt32 m_grainSize;
+	dgInt32 m_buildQuality;
+	dgInt32 m_atomicIndex;
+	dgInt32 m_subTreeCount;
+};
+
 dgAABBPolygonSoup::dgAABBPolygonSoup ()
 	:dgPolygonSoupDatabase()
 	,m_nodesCount(0)
 	,m_indexCount(0)
 	,m_aabb(NULL)
 	,m_indices(NULL)
+	,m_mappedImage(false)
 {
 }
 
 dgAABBPolygonSoup::~dgAABBPolygonSoup ()
 {
-	if (m_aabb) {
+	if (m_mappedImage) {
+		// the image belongs to the application
+		m_localVertex = NULL;
+	} else if (m_aabb) {
 		dgFreeStack (m_aabb);
 		dgFreeStack (m_indices);
 	}
@@ -714,7 +871,7 @@ dgIntersectStatus dgAABBPolygonSoup::CalculateDisjointedFaceEdgeNormals (void* c
 
 
 
-dgAABBPolygonSoup::dgNodeBuilder* dgAABBPolygonSoup::BuildTopDown (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator) const
+dgAABBPolygonSoup::dgNodeBuilder* dgAABBPolygonSoup::BuildTopDown (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator, dgInt32 buildQuality) const
 {
 	dgAssert (firstBox >= 0);
 	dgAssert (lastBox >= 0);
@@ -722,23 +879,73 @@ dgAABBPolygonSoup::dgNodeBuilder* dgAABBPolygonSoup::BuildTopDown (dgNodeBuilder
 	if (lastBox == firstBox) {
 		return &leafArray[firstBox];
 	} else {
-		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1);
+		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1, buildQuality);
 
 		dgNodeBuilder* const parent = new (*allocator) dgNodeBuilder (info.m_p0, info.m_p1);
 		*allocator = *allocator + 1;
 
 		dgAssert (parent);
-		parent->m_right = BuildTopDown (leafArray, firstBox + info.m_axis, lastBox, allocator);
+		parent->m_right = BuildTopDown (leafArray, firstBox + info.m_axis, lastBox, allocator, buildQuality);
 		parent->m_right->m_parent = parent;
 
-		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + info.m_axis - 1, allocator);
+		parent->m_left = BuildTopDown (leafArray, firstBox, firstBox + info.m_axis - 1, allocator, buildQuality);
 		parent->m_left->m_parent = parent;
 		return parent;
 	}
 }
 
-void dgAABBPolygonSoup::Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild)
+// the top of the tree is split serially, sub trees below the grain size are built by the worker threads.
+// a sub tree of n leaves always takes n - 1 nodes, so each sub tree gets the same nodes the serial build would give it.
+dgAABBPolygonSoup::dgNodeBuilder* dgAABBPolygonSoup::BuildTopDownParallel (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator, dgParallelBuild& build) const
 {
+	if (lastBox == firstBox) {
+		return &leafArray[firstBox];
+	} else {
+		dgSpliteInfo info (&leafArray[firstBox], lastBox - firstBox + 1, build.m_buildQuality);
+
+		dgNodeBuilder* const parent = new (*allocator) dgNodeBuilder (info.m_p0, info.m_p1);
+		*allocator = *allocator + 1;
+
+		const dgInt32 split = firstBox + info.m_axis;
+		if ((lastBox - split + 1) > build.m_grainSize) {
+			parent->m_right = BuildTopDownParallel (leafArray, split, lastBox, allocator, build);
+			parent->m_right->m_parent = parent;
+		} else {
+			build.AddSubTree (parent, true, split, lastBox, allocator);
+		}
+
+		if ((split - firstBox) > build.m_grainSize) {
+			parent->m_left = BuildTopDownParallel (leafArray, firstBox, split - 1, allocator, build);
+			parent->m_left->m_parent = parent;
+		} else {
+			build.AddSubTree (parent, false, firstBox, split - 1, allocator);
+		}
+		return parent;
+	}
+}
+
+void dgAABBPolygonSoup::BuildSubTreesKernel (void* const context0, void* const context1, dgInt32 threadID)
+{
+	dgParallelBuild* const build = (dgParallelBuild*) context0;
+	const dgAABBPolygonSoup* const me = (dgAABBPolygonSoup*) context1;
+	const dgInt32 count = build->m_subTreeCount;
+	for (dgInt32 i = dgAtomicExchangeAndAdd (&build->m_atomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd (&build->m_atomicIndex, 1)) {
+		dgSubTreeBuild& subTree = build->m_subTrees[i];
+		dgNodeBuilder* allocator = subTree.m_allocator;
+		dgNodeBuilder* const root = me->BuildTopDown (build->m_leafArray, subTree.m_firstBox, subTree.m_lastBox, &allocator, build->m_buildQuality);
+		dgAssert ((allocator - subTree.m_allocator) == (subTree.m_lastBox - subTree.m_firstBox));
+		root->m_parent = subTree.m_parent;
+		if (subTree.m_isRight) {
+			subTree.m_parent->m_right = root;
+		} else {
+			subTree.m_parent->m_left = root;
+		}
+	}
+}
+
+void dgAABBPolygonSoup::Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild, dgThreadHive* const threadPool, dgInt32 buildQuality)
+{
+	dgAssert (!m_mappedImage);
 	if (builder.m_faceCount == 0) {
 		return;
 	}
@@ -780,10 +987,21 @@ void dgAABBPolygonSoup::Create (const dgPolygonSoupDatabaseBuilder& builder, boo
 	}
 
 	dgNodeBuilder* contructorAllocator = &constructor[allocatorIndex];
-	dgNodeBuilder* root = BuildTopDown (&constructor[0], 0, allocatorIndex - 1, &contructorAllocator);
+	dgNodeBuilder* root = NULL;
+	const dgInt32 threadCount = threadPool ? threadPool->GetThreadCount() : 1;
+	if ((threadCount > 1) && (allocatorIndex > 2 * DG_AABB_POLYGON_SOUP_MIN_SUBTREE)) {
+		dgParallelBuild build (builder.m_allocator, &constructor[0], allocatorIndex, threadCount, buildQuality);
+		root = BuildTopDownParallel (&constructor[0], 0, allocatorIndex - 1, &contructorAllocator, build);
+		for (dgInt32 i = 0; i < threadCount; i ++) {
+			threadPool->QueueJob (BuildSubTreesKernel, &build, this, "dgAABBPolygonSoup::BuildSubTrees");
+		}
+		threadPool->SynchronizationBarrier();
+	} else {
+		root = BuildTopDown (&constructor[0], 0, allocatorIndex - 1, &contructorAllocator, buildQuality);
+	}
 
 	dgAssert (root);
-	if (root->m_left) {
+	if (root->m_left && (buildQuality != m_buildFast)) {
 
 		dgAssert (root->m_right);
 		dgList<dgNodeBuilder*> list (builder.m_allocator);
@@ -983,6 +1201,156 @@ void dgAABBPolygonSoup::Deserialize (dgDeserialize callback, void* const userDat
 }
 
 
+void dgAABBPolygonSoup::CalculateImageLayout (dgImageHeader& header) const
+{
+	const dgInt32 align = DG_AABB_POLYGON_SOUP_IMAGE_ALIGNMENT - 1;
+	memset (&header, 0, sizeof (dgImageHeader));
+	header.m_signature = DG_AABB_POLYGON_SOUP_IMAGE_SIGNATURE;
+	header.m_vertexCount = m_aabb ? m_vertexCount : 0;
+	header.m_indexCount = m_aabb ? m_indexCount : 0;
+	header.m_nodesCount = m_aabb ? m_nodesCount : 0;
+	header.m_vertexOffset = (dgInt32 (sizeof (dgImageHeader)) + align) & ~align;
+	header.m_indexOffset = (header.m_vertexOffset + header.m_vertexCount * dgInt32 (sizeof (dgTriplex)) + align) & ~align;
+	header.m_nodesOffset = (header.m_indexOffset + header.m_indexCount * dgInt32 (sizeof (dgInt32)) + align) & ~align;
+	header.m_sizeInBytes = (header.m_nodesOffset + header.m_nodesCount * dgInt32 (sizeof (dgNode)) + align) & ~align;
+}
+
+dgInt32 dgAABBPolygonSoup::GetImageSize () const
+{
+	dgImageHeader header;
+	CalculateImageLayout (header);
+	return header.m_sizeInBytes;
+}
+
+void dgAABBPolygonSoup::SerializeImage (dgSerialize callback, void* const userData, dgInt32 imageUserData) const
+{
+	dgImageHeader header;
+	CalculateImageLayout (header);
+	header.m_userData = imageUserData;
+
+	char padding[DG_AABB_POLYGON_SOUP_IMAGE_ALIGNMENT];
+	memset (padding, 0, sizeof (padding));
+
+	dgInt32 offset = sizeof (dgImageHeader);
+	callback (userData, &header, sizeof (dgImageHeader));
+	callback (userData, padding, header.m_vertexOffset - offset);
+	if (header.m_vertexCount) {
+		callback (userData, m_localVertex, dgInt32 (sizeof (dgTriplex) * m_vertexCount));
+		offset = header.m_vertexOffset + dgInt32 (sizeof (dgTriplex) * m_vertexCount);
+		callback (userData, padding, header.m_indexOffset - offset);
+		callback (userData, m_indices, dgInt32 (sizeof (dgInt32) * m_indexCount));
+		offset = header.m_indexOffset + dgInt32 (sizeof (dgInt32) * m_indexCount);
+		callback (userData, padding, header.m_nodesOffset - offset);
+		callback (userData, m_aabb, dgInt32 (sizeof (dgNode) * m_nodesCount));
+		offset = header.m_nodesOffset + dgInt32 (sizeof (dgNode) * m_nodesCount);
+		callback (userData, padding, header.m_sizeInBytes - offset);
+	}
+}
+
+static bool dgImageArrayInRange (dgInt32 offset, dgInt32 count, dgInt32 strideInBytes, dgInt32 start, dgInt32 end)
+{
+	// 64 bit arithmetic, so a corrupted count can not wrap around the end of the image
+	if ((offset < start) || (count < 0) || (offset & (sizeof (dgInt32) - 1))) {
+		return false;
+	}
+	return (dgInt64 (offset) + dgInt64 (count) * strideInBytes) <= dgInt64 (end);
+}
+
+const dgAABBPolygonSoup::dgImageHeader* dgAABBPolygonSoup::GetImageHeader (const void* const image, dgInt32 sizeInBytes)
+{
+	if (!image || (sizeInBytes < dgInt32 (sizeof (dgImageHeader))) || (size_t (image) & (DG_AABB_POLYGON_SOUP_IMAGE_ALIGNMENT - 1))) {
+		return NULL;
+	}
+	const dgImageHeader* const header = (dgImageHeader*) image;
+	if (header->m_signature != DG_AABB_POLYGON_SOUP_IMAGE_SIGNATURE) {
+		return NULL;
+	}
+	if ((header->m_sizeInBytes < dgInt32 (sizeof (dgImageHeader))) || (header->m_sizeInBytes > sizeInBytes)) {
+		return NULL;
+	}
+
+	// the arrays follow the header in order and can not overlap
+	const dgInt32 headerSize = dgInt32 (sizeof (dgImageHeader));
+	if (!dgImageArrayInRange (header->m_vertexOffset, header->m_vertexCount, dgInt32 (sizeof (dgTriplex)), headerSize, header->m_indexOffset)) {
+		return NULL;
+	}
+	if (!dgImageArrayInRange (header->m_indexOffset, header->m_indexCount, dgInt32 (sizeof (dgInt32)), headerSize, header->m_nodesOffset)) {
+		return NULL;
+	}
+	if (!dgImageArrayInRange (header->m_nodesOffset, header->m_nodesCount, dgInt32 (sizeof (dgNode)), headerSize, header->m_sizeInBytes)) {
+		return NULL;
+	}
+
+	const dgInt32 vertexCount = header->m_vertexCount;
+	const dgInt32 indexCount = header->m_indexCount;
+	const dgInt32 nodesCount = header->m_nodesCount;
+	if (!vertexCount) {
+		// an empty image maps no arrays
+		return header;
+	}
+	if (!nodesCount) {
+		return NULL;
+	}
+
+	// the queries walk the tree without range checks, so every node and face reference is validated once here
+	const char* const base = (char*) image;
+	const dgInt32* const indices = (dgInt32*) &base[header->m_indexOffset];
+	const dgNode* const nodes = (dgNode*) &base[header->m_nodesOffset];
+	for (dgInt32 i = 0; i < nodesCount; i ++) {
+		const dgNode& node = nodes[i];
+		if ((node.m_indexBox0 < 0) || (node.m_indexBox0 >= vertexCount) || (node.m_indexBox1 < 0) || (node.m_indexBox1 >= vertexCount)) {
+			return NULL;
+		}
+		const dgNode::dgLeafNodePtr* const children[] = {&node.m_left, &node.m_right};
+		for (dgInt32 j = 0; j < 2; j ++) {
+			const dgNode::dgLeafNodePtr& child = *children[j];
+			if (child.IsLeaf()) {
+				// face format i0, i1, ... , id, normal, e0Normal, e1Normal, ... , faceSize
+				const dgInt32 count = dgInt32 (child.GetCount());
+				const dgInt32 index = dgInt32 (child.GetIndex());
+				if (count && ((index + 2 * count + 3) > indexCount)) {
+					return NULL;
+				}
+				const dgInt32* const face = &indices[index];
+				for (dgInt32 k = 0; k < count; k ++) {
+					if ((face[k] < 0) || (face[k] >= vertexCount) || (face[count + 2 + k] < 0) || (face[count + 2 + k] >= vertexCount)) {
+						return NULL;
+					}
+				}
+				if (count && ((face[count + 1] < 0) || (face[count + 1] >= vertexCount))) {
+					return NULL;
+				}
+			} else if ((dgInt32 (child.m_node) <= i) || (dgInt32 (child.m_node) >= nodesCount)) {
+				// children are enumerated after their parent, which also rules out cycles
+				return NULL;
+			}
+		}
+	}
+	return header;
+}
+
+void dgAABBPolygonSoup::MapImage (const dgImageHeader* const image)
+{
+	dgAssert (!m_aabb);
+	dgAssert (!m_localVertex);
+
+	const char* const base = (char*) image;
+	m_mappedImage = true;
+	m_strideInBytes = sizeof (dgTriplex);
+	m_vertexCount = image->m_vertexCount;
+	m_indexCount = image->m_indexCount;
+	m_nodesCount = image->m_nodesCount;
+	if (m_vertexCount) {
+		m_localVertex = (dgFloat32*) &base[image->m_vertexOffset];
+		m_indices = (dgInt32*) &base[image->m_indexOffset];
+		m_aabb = (dgNode*) &base[image->m_nodesOffset];
+	} else {
+		m_localVertex = NULL;
+		m_indices = NULL;
+		m_aabb = NULL;
+	}
+}
+
 dgVector dgAABBPolygonSoup::ForAllSectorsSupportVectex (const dgVector& dir) const
 {
 	dgVector supportVertex (dgFloat32 (0.0f));
@@ -27,12 +27,20 @@
 #include "dgPolygonSoupDatabase.h"
 
 
+class dgThreadHive;
 class dgPolygonSoupDatabaseBuilder;
 
 
 class dgAABBPolygonSoup: public dgPolygonSoupDatabase
 {
 	public:
+	enum dgBuildQuality
+	{
+		m_buildFast = 0,
+		m_buildDefault,
+		m_buildBestSah,
+	};
+
 	class dgNode
 	{
 		public:
@@ -186,18 +194,42 @@ class dgAABBPolygonSoup: public dgPolygonSoupDatabase
 		dgLeafNodePtr m_right;
 	};
 
+	// header of a relocatable image of the tree, all arrays are referenced by offset from the 
+	// start of the image so that a memory mapped file can be used in place without copying.
+	class dgImageHeader
+	{
+		public:
+		dgInt32 m_signature;
+		dgInt32 m_sizeInBytes;
+		dgInt32 m_vertexCount;
+		dgInt32 m_indexCount;
+		dgInt32 m_nodesCount;
+		dgInt32 m_vertexOffset;
+		dgInt32 m_indexOffset;
+		dgInt32 m_nodesOffset;
+		dgInt32 m_userData;
+		dgInt32 m_reserved[3];
+	};
+
 	class dgSpliteInfo;
 	class dgNodeBuilder;
+	class dgSubTreeBuild;
+	class dgParallelBuild;
 
 	virtual void GetAABB (dgVector& p0, dgVector& p1) const;
 	virtual void Serialize (dgSerialize callback, void* const userData) const;
 	virtual void Deserialize (dgDeserialize callback, void* const userData, dgInt32 revisionNumber);
 
+	dgInt32 GetImageSize () const;
+	void SerializeImage (dgSerialize callback, void* const userData, dgInt32 imageUserData) const;
+	static const dgImageHeader* GetImageHeader (const void* const image, dgInt32 sizeInBytes);
+
 	protected:
 	dgAABBPolygonSoup ();
 	virtual ~dgAABBPolygonSoup ();
 
-	void Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild);
+	void Create (const dgPolygonSoupDatabaseBuilder& builder, bool optimizedBuild, dgThreadHive* const threadPool = NULL, dgInt32 buildQuality = m_buildDefault);
+	void MapImage (const dgImageHeader* const image);
 	void CalculateAdjacendy ();
 	virtual void ForAllSectorsRayHit (const dgFastRayTest& ray, dgFloat32 maxT, dgRayIntersectCallback callback, void* const context) const;
 	virtual void ForAllSectors (const dgFastAABBInfo& obbAabb, const dgVector& boxDistanceTravel, dgFloat32 m_maxT, dgAABBIntersectCallback callback, void* const context) const;
@@ -232,17 +264,21 @@ class dgAABBPolygonSoup: public dgPolygonSoupDatabase
 	virtual dgVector ForAllSectorsSupportVectex (const dgVector& dir) const;
 
 	private:
-	dgNodeBuilder* BuildTopDown (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator) const;
+	dgNodeBuilder* BuildTopDown (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator, dgInt32 buildQuality) const;
+	dgNodeBuilder* BuildTopDownParallel (dgNodeBuilder* const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgNodeBuilder** const allocator, dgParallelBuild& build) const;
+	static void BuildSubTreesKernel (void* const context0, void* const context1, dgInt32 threadID);
 	dgFloat32 CalculateFaceMaxSize (const dgVector* const vertex, dgInt32 indexCount, const dgInt32* const indexArray) const;
 //	static dgIntersectStatus CalculateManifoldFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount);
 	static dgIntersectStatus CalculateDisjointedFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance);
 	static dgIntersectStatus CalculateAllFaceEdgeNormals (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount, dgFloat32 hitDistance);
 	void ImproveNodeFitness (dgNodeBuilder* const node) const;
+	void CalculateImageLayout (dgImageHeader& header) const;
 
 	dgInt32 m_nodesCount;
 	dgInt32 m_indexCount;
 	dgNode* m_aabb;
 	dgInt32* m_indices;
+	bool m_mappedImage;
 };
 
 
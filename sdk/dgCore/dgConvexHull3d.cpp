@@ -23,12 +23,12 @@
 #include "dgSort.h"
 #include "dgTree.h"
 #include "dgStack.h"
-#include "dgGoogol.h"
+#include "dgPredicates.h"
 #include "dgConvexHull3d.h"
-#include "dgSmallDeterminant.h"
 
 
 #define DG_CONVEXHULL_3D_VERTEX_CLUSTER_SIZE		8
+#define DG_CONVEXHULL_3D_LARGE_CLOUD			1024
 
 #ifdef	DG_OLD_CONVEXHULL_3D
 class dgConvexHull3d::dgNormalMap
@@ -129,6 +129,8 @@ dgConvexHull3DFace::dgConvexHull3DFace()
 	m_twin[0] = NULL;
 	m_twin[1] = NULL;
 	m_twin[2] = NULL;
+	m_boundaryNode = NULL;
+	m_conflict = -1;
 }
 
 dgFloat64 dgConvexHull3DFace::Evalue (const dgBigVector* const pointArray, const dgBigVector& point) const
@@ -136,36 +138,7 @@ dgFloat64 dgConvexHull3DFace::Evalue (const dgBigVector* const pointArray, const
 	const dgBigVector& p0 = pointArray[m_index[0]];
 	const dgBigVector& p1 = pointArray[m_index[1]];
 	const dgBigVector& p2 = pointArray[m_index[2]];
-
-	dgFloat64 matrix[3][3];
-	for (dgInt32 i = 0; i < 3; i ++) {
-		matrix[0][i] = p2[i] - p0[i];
-		matrix[1][i] = p1[i] - p0[i];
-		matrix[2][i] = point[i] - p0[i];
-	}
-
-	dgFloat64 error;
-	dgFloat64 det = Determinant3x3 (matrix, &error);
-
-	// the code use double, however the threshold for accuracy test is the machine precision of a float.
-	// by changing this to a smaller number, the code should run faster since many small test will be considered valid
-	// the precision must be a power of two no smaller than the machine precision of a double, (1<<48)
-	// float64(1<<30) can be a good value
-
-	// dgFloat64 precision	= dgFloat64 (1.0f) / dgFloat64 (1<<30);
-	dgFloat64 precision	 = dgFloat64 (1.0f) / dgFloat64 (1<<24);
-	dgFloat64 errbound = error * precision;
-	if (fabs(det) > errbound) {
-		return det;
-	}
-
-	dgGoogol exactMatrix[3][3];
-	for (dgInt32 i = 0; i < 3; i ++) {
-		exactMatrix[0][i] = dgGoogol(p2[i]) - dgGoogol(p0[i]);
-		exactMatrix[1][i] = dgGoogol(p1[i]) - dgGoogol(p0[i]);
-		exactMatrix[2][i] = dgGoogol(point[i]) - dgGoogol(p0[i]);
-	}
-	return Determinant3x3(exactMatrix);
+	return dgOrient3d (p1, p2, point, p0);
 }
 
 dgBigPlane dgConvexHull3DFace::GetPlaneEquation (const dgBigVector* const pointArray) const
@@ -405,6 +378,10 @@ dgInt32 dgConvexHull3d::GetUniquePoints(dgConvexHull3DVertex* const points, cons
 		}
 	}
 
+	if (count > DG_CONVEXHULL_3D_LARGE_CLOUD) {
+		count = RemoveInteriorPoints(points, count);
+	}
+
 	dgSort(points, count, ConvexCompareVertex);
 
 	dgInt32 indexCount = 0;
@@ -421,6 +398,91 @@ dgInt32 dgConvexHull3d::GetUniquePoints(dgConvexHull3DVertex* const points, cons
 	return count;
 }
 
+dgInt32 dgConvexHull3d::RemoveInteriorPoints(dgConvexHull3DVertex* const points, dgInt32 count) const
+{
+	// Akl-Toussaint heuristic: points inside the hull of a few extreme points can not be on the hull.
+	static const dgFloat64 directions[][3] = {
+		{ 1.0,  0.0,  0.0}, {-1.0,  0.0,  0.0}, { 0.0,  1.0,  0.0}, { 0.0, -1.0,  0.0}, { 0.0,  0.0,  1.0}, { 0.0,  0.0, -1.0},
+		{ 1.0,  1.0,  0.0}, { 1.0, -1.0,  0.0}, {-1.0,  1.0,  0.0}, {-1.0, -1.0,  0.0},
+		{ 1.0,  0.0,  1.0}, { 1.0,  0.0, -1.0}, {-1.0,  0.0,  1.0}, {-1.0,  0.0, -1.0},
+		{ 0.0,  1.0,  1.0}, { 0.0,  1.0, -1.0}, { 0.0, -1.0,  1.0}, { 0.0, -1.0, -1.0},
+		{ 1.0,  1.0,  1.0}, { 1.0,  1.0, -1.0}, { 1.0, -1.0,  1.0}, { 1.0, -1.0, -1.0},
+		{-1.0,  1.0,  1.0}, {-1.0,  1.0, -1.0}, {-1.0, -1.0,  1.0}, {-1.0, -1.0, -1.0}};
+	const dgInt32 directionCount = sizeof (directions) / sizeof (directions[0]);
+
+	dgFloat64 maxProj[directionCount];
+	dgInt32 extremes[directionCount];
+	for (dgInt32 j = 0; j < directionCount; j ++) {
+		maxProj[j] = dgFloat64 (-1.0e50);
+		extremes[j] = 0;
+	}
+
+	dgBigVector minP (points[0]);
+	dgBigVector maxP (points[0]);
+	for (dgInt32 i = 0; i < count; i ++) {
+		const dgBigVector& p = points[i];
+		minP = minP.GetMin(p);
+		maxP = maxP.GetMax(p);
+		for (dgInt32 j = 0; j < directionCount; j ++) {
+			dgFloat64 dist = p.m_x * directions[j][0] + p.m_y * directions[j][1] + p.m_z * directions[j][2];
+			if (dist > maxProj[j]) {
+				maxProj[j] = dist;
+				extremes[j] = i;
+			}
+		}
+	}
+
+	dgBigVector extremePoints[directionCount];
+	for (dgInt32 j = 0; j < directionCount; j ++) {
+		extremePoints[j] = points[extremes[j]] & dgBigVector::m_triplexMask;
+	}
+
+	dgConvexHull3d extremeHull (GetAllocator(), &extremePoints[0].m_x, sizeof (dgBigVector), directionCount, dgFloat64 (0.0f));
+	if (!extremeHull.GetCount()) {
+		return count;
+	}
+
+	dgInt32 planeCount = 0;
+	dgStack<dgBigPlane> planes (extremeHull.GetCount());
+	for (dgListNode* node = extremeHull.GetFirst(); node; node = node->GetNext()) {
+		planes[planeCount] = node->GetInfo().GetPlaneEquation (extremeHull.GetVertexPool());
+		planeCount ++;
+	}
+
+	dgBigVector size (maxP - minP);
+	const dgFloat64 margin = dgFloat64 (-1.0e-6f) * sqrt (size.DotProduct3(size));
+
+	dgInt32 outsideCount = 0;
+	for (dgInt32 i = 0; i < count; i ++) {
+		const dgBigVector& p = points[i];
+		bool inside = true;
+		for (dgInt32 j = 0; inside && (j < planeCount); j ++) {
+			inside = planes[j].Evalue(p) < margin;
+		}
+		if (!inside) {
+			points[outsideCount] = points[i];
+			outsideCount ++;
+		}
+	}
+	return outsideCount;
+}
+
+void dgConvexHull3d::AddConflicts(dgListNode** const faces, const dgBigPlane* const planes, dgInt32 faceCount, const dgConvexHull3DVertex* const points, const dgInt32* const pointList, dgInt32 pointCount, dgInt32* const nextConflict, dgFloat64 distTol) const
+{
+	for (dgInt32 i = 0; i < pointCount; i ++) {
+		const dgInt32 index = pointList[i];
+		const dgBigVector& p = points[index];
+		for (dgInt32 j = 0; j < faceCount; j ++) {
+			if (planes[j].Evalue(p) > distTol) {
+				dgConvexHull3DFace* const face = &faces[j]->GetInfo();
+				nextConflict[index] = face->m_conflict;
+				face->m_conflict = index;
+				break;
+			}
+		}
+	}
+}
+
 dgInt32 dgConvexHull3d::InitVertexArray(dgConvexHull3DVertex* const points, const dgFloat64* const vertexCloud, dgInt32 strideInBytes, dgInt32 count, void* const memoryPool, dgInt32 maxMemSize)
 {
 	count = GetUniquePoints(points, vertexCloud, strideInBytes, count, memoryPool, maxMemSize);
@@ -830,22 +892,47 @@ void dgConvexHull3d::CalculateConvexHull3d (dgConvexHull3dAABBTreeNode* vertexTr
 
 	dgList<dgListNode*> boundaryFaces(GetAllocator());
 
-	boundaryFaces.Append(f0Node);
-	boundaryFaces.Append(f1Node);
-	boundaryFaces.Append(f2Node);
-	boundaryFaces.Append(f3Node);
+	f0->m_boundaryNode = boundaryFaces.Append(f0Node);
+	f1->m_boundaryNode = boundaryFaces.Append(f1Node);
+	f2->m_boundaryNode = boundaryFaces.Append(f2Node);
+	f3->m_boundaryNode = boundaryFaces.Append(f3Node);
+
+	// for full hulls of large clouds each face keeps the list of points in front of it (quickhull outside sets),
+	// so that finding the furthest point and the visible faces do not have to search the entire cloud.
+	// reduced vertex count hulls still use the global support vertex, since that defines the approximation.
+	const bool useConflictLists = (count > DG_CONVEXHULL_3D_LARGE_CLOUD) && (maxVertexCount >= count);
+	const dgInt32 pointCount = count;
+	dgStack<dgInt32> nextConflictPool(useConflictLists ? pointCount : 1);
+	dgStack<dgInt32> conflictPointsPool(useConflictLists ? pointCount : 1);
+	dgInt32* const nextConflict = &nextConflictPool[0];
+	dgInt32* const conflictPoints = &conflictPointsPool[0];
+	if (useConflictLists) {
+		dgInt32 conflictCount = 0;
+		for (dgInt32 i = 0; i < pointCount; i ++) {
+			if (!points[i].m_mark) {
+				conflictPoints[conflictCount] = i;
+				conflictCount ++;
+			}
+		}
+		dgListNode* faces[] = {f0Node, f1Node, f2Node, f3Node};
+		dgBigPlane planes[] = {f0->GetPlaneEquation (&m_points[0]), f1->GetPlaneEquation (&m_points[0]), f2->GetPlaneEquation (&m_points[0]), f3->GetPlaneEquation (&m_points[0])};
+		AddConflicts(faces, planes, 4, points, conflictPoints, conflictCount, nextConflict, distTol);
+	}
+
 	count -= 4;
 	maxVertexCount -= 4;
 	dgInt32 currentIndex = 4;
 
-
-	dgStack<dgListNode*> stackPool(1024 + m_count);
-	dgStack<dgListNode*> coneListPool(1024 + m_count);
-	dgStack<dgListNode*> deleteListPool(1024 + m_count);
+	const dgInt32 poolSize = useConflictLists ? 1024 + 6 * pointCount : 1024 + m_count;
+	dgStack<dgListNode*> stackPool(poolSize);
+	dgStack<dgListNode*> coneListPool(poolSize);
+	dgStack<dgListNode*> deleteListPool(poolSize);
+	dgStack<dgBigPlane> conePlanesPool(useConflictLists ? poolSize : 1);
 
 	dgListNode** const stack = &stackPool[0];
 	dgListNode** const coneList = &stackPool[0];
 	dgListNode** const deleteList = &deleteListPool[0];
+	dgBigPlane* const conePlanes = &conePlanesPool[0];
 
 	while (boundaryFaces.GetCount() && count && (maxVertexCount > 0)) {
 		// my definition of the optimal convex hull of a given vertex count,
@@ -873,7 +960,24 @@ void dgConvexHull3d::CalculateConvexHull3d (dgConvexHull3dAABBTreeNode* vertexTr
 		dgConvexHull3DFace* const face = &faceNode->GetInfo();
 		dgBigPlane planeEquation (face->GetPlaneEquation (&m_points[0]));
 
-		dgInt32 index = SupportVertex (&vertexTree, points, planeEquation);
+		dgInt32 index = -1;
+		if (useConflictLists) {
+			dgFloat64 maxDist = dgFloat64 (-1.0e50);
+			for (dgInt32 i = face->m_conflict; i != -1; i = nextConflict[i]) {
+				dgFloat64 dist = planeEquation.Evalue(points[i]);
+				if (dist > maxDist) {
+					maxDist = dist;
+					index = i;
+				}
+			}
+			if (index == -1) {
+				boundaryFaces.Remove (face->m_boundaryNode);
+				face->m_boundaryNode = NULL;
+				continue;
+			}
+		} else {
+			index = SupportVertex (&vertexTree, points, planeEquation);
+		}
 		const dgBigVector& p = points[index];
 		dgFloat64 dist = planeEquation.Evalue(p);
 
@@ -929,9 +1033,8 @@ void dgConvexHull3d::CalculateConvexHull3d (dgConvexHull3dAABBTreeNode* vertexTr
 					if (!twinFace->m_mark) {
 						dgInt32 j1 = (j0 == 2) ? 0 : j0 + 1;
 						dgListNode* const newNode = AddFace (currentIndex, face1->m_index[j0], face1->m_index[j1]);
-						boundaryFaces.Addtop(newNode);
-
 						dgConvexHull3DFace* const newFace = &newNode->GetInfo();
+						newFace->m_boundaryNode = boundaryFaces.Addtop(newNode);
 						newFace->m_twin[1] = twinNode;
 						for (dgInt32 k = 0; k < 3; k ++) {
 							if (twinFace->m_twin[k] == node1) {
@@ -972,9 +1075,29 @@ void dgConvexHull3d::CalculateConvexHull3d (dgConvexHull3dAABBTreeNode* vertexTr
 				}
 			}
 
+			if (useConflictLists) {
+				dgInt32 conflictCount = 0;
+				for (dgInt32 i = 0; i < deletedCount; i ++) {
+					const dgConvexHull3DFace* const deletedFace = &deleteList[i]->GetInfo();
+					for (dgInt32 j = deletedFace->m_conflict; j != -1; j = nextConflict[j]) {
+						if (j != index) {
+							conflictPoints[conflictCount] = j;
+							conflictCount ++;
+						}
+					}
+				}
+				for (dgInt32 i = 0; i < newCount; i ++) {
+					conePlanes[i] = coneList[i]->GetInfo().GetPlaneEquation (&m_points[0]);
+				}
+				AddConflicts(coneList, conePlanes, newCount, points, conflictPoints, conflictCount, nextConflict, distTol);
+			}
+
 			for (dgInt32 i = 0; i < deletedCount; i ++) {
 				dgListNode* const node = deleteList[i];
-				boundaryFaces.Remove (node);
+				dgConvexHull3DFace* const deletedFace = &node->GetInfo();
+				if (deletedFace->m_boundaryNode) {
+					boundaryFaces.Remove (deletedFace->m_boundaryNode);
+				}
 				DeleteFace (node);
 			}
 
@@ -982,10 +1105,40 @@ void dgConvexHull3d::CalculateConvexHull3d (dgConvexHull3dAABBTreeNode* vertexTr
 			currentIndex ++;
 			count --;
 		} else {
-			boundaryFaces.Remove (faceNode);
+			boundaryFaces.Remove (face->m_boundaryNode);
+			face->m_boundaryNode = NULL;
+			face->m_conflict = -1;
 		}
 	}
 	m_count = currentIndex;
+
+	if (useConflictLists) {
+		// the furthest point of a face outside set may end up inside the final hull, remove those vertices
+		dgStack<dgInt32> remapPool(m_count);
+		dgInt32* const remap = &remapPool[0];
+		memset (remap, -1, remapPool.GetSizeInBytes());
+		for (dgListNode* node = GetFirst(); node; node = node->GetNext()) {
+			dgConvexHull3DFace* const face = &node->GetInfo();
+			remap[face->m_index[0]] = 0;
+			remap[face->m_index[1]] = 0;
+			remap[face->m_index[2]] = 0;
+		}
+		dgInt32 vertexCount = 0;
+		for (dgInt32 i = 0; i < m_count; i ++) {
+			if (remap[i] != -1) {
+				m_points[vertexCount] = m_points[i];
+				remap[i] = vertexCount;
+				vertexCount ++;
+			}
+		}
+		for (dgListNode* node = GetFirst(); node; node = node->GetNext()) {
+			dgConvexHull3DFace* const face = &node->GetInfo();
+			face->m_index[0] = remap[face->m_index[0]];
+			face->m_index[1] = remap[face->m_index[1]];
+			face->m_index[2] = remap[face->m_index[2]];
+		}
+		m_count = vertexCount;
+	}
 }
 
 
@@ -54,6 +54,8 @@ class dgConvexHull3DFace
 	private:
 	dgInt32 m_mark;
 	dgList<dgConvexHull3DFace>::dgListNode* m_twin[3];
+	dgList<dgList<dgConvexHull3DFace>::dgListNode*>::dgListNode* m_boundaryNode;
+	dgInt32 m_conflict;
 	friend class dgConvexHull3d;
 };
 
@@ -93,6 +95,8 @@ class dgConvexHull3d: public dgList<dgConvexHull3DFace>
 	dgFloat64 TetrahedrumVolume (const dgBigVector& p0, const dgBigVector& p1, const dgBigVector& p2, const dgBigVector& p3) const;
 
 	dgInt32 GetUniquePoints(dgConvexHull3DVertex* const points, const dgFloat64* const vertexCloud, dgInt32 strideInBytes, dgInt32 count, void* const memoryPool, dgInt32 maxMemSize);
+	dgInt32 RemoveInteriorPoints(dgConvexHull3DVertex* const points, dgInt32 count) const;
+	void AddConflicts(dgListNode** const faces, const dgBigPlane* const planes, dgInt32 faceCount, const dgConvexHull3DVertex* const points, const dgInt32* const pointList, dgInt32 pointCount, dgInt32* const nextConflict, dgFloat64 distTol) const;
 	dgConvexHull3dAABBTreeNode* BuildTree (dgConvexHull3dAABBTreeNode* const parent, dgConvexHull3DVertex* const points, dgInt32 count, dgInt32 baseIndex, dgInt8** const memoryPool, dgInt32& maxMemSize) const;
 	static dgInt32 ConvexCompareVertex(const dgConvexHull3DVertex* const A, const dgConvexHull3DVertex* const B, void* const context);
 	bool Sanity() const;
@@ -24,9 +24,8 @@
 #include "dgTree.h"
 #include "dgHeap.h"
 #include "dgStack.h"
-#include "dgGoogol.h"
+#include "dgPredicates.h"
 #include "dgConvexHull4d.h"
-#include "dgSmallDeterminant.h"
 
 #define DG_VERTEX_CLUMP_SIZE_4D		8 
 
@@ -203,6 +202,7 @@ void dgConvexHull4dTetraherum::Init (const dgConvexHull4dVector* const points, d
 	m_faces[3].m_index[3] = v2;
 
 	SetMark (0); 
+	m_boundaryNode = NULL;
 	for (dgInt32 i = 0; i < 4; i ++) {
 		m_faces[i].m_twin = NULL;
 	}
@@ -224,31 +224,7 @@ dgFloat64 dgConvexHull4dTetraherum::Evalue (const dgConvexHull4dVector* const po
 	const dgBigVector &p1 = pointArray[m_faces[0].m_index[1]];
 	const dgBigVector &p2 = pointArray[m_faces[0].m_index[2]];
 	const dgBigVector &p3 = pointArray[m_faces[0].m_index[3]];
-
-	dgFloat64 matrix[4][4];
-	for (dgInt32 i = 0; i < 4; i ++) {
-		matrix[0][i] = p1[i] - p0[i];
-		matrix[1][i] = p2[i] - p0[i];
-		matrix[2][i] = p3[i] - p0[i];
-		matrix[3][i] = point[i] - p0[i];
-	}
-
-	dgFloat64 error;
-	dgFloat64 det = Determinant4x4 (matrix, &error);
-	dgFloat64 precision  = dgFloat64 (1.0f) / dgFloat64 (1<<24);
-	dgFloat64 errbound = error * precision; 
-	if (fabs(det) > errbound) {
-		return det;
-	}
-
-	dgGoogol exactMatrix[4][4];
-	for (dgInt32 i = 0; i < 4; i ++) {
-		exactMatrix[0][i] = dgGoogol(p1[i]) - dgGoogol(p0[i]);
-		exactMatrix[1][i] = dgGoogol(p2[i]) - dgGoogol(p0[i]);
-		exactMatrix[2][i] = dgGoogol(p3[i]) - dgGoogol(p0[i]);
-		exactMatrix[3][i] = dgGoogol(point[i]) - dgGoogol(p0[i]);
-	}
-	return Determinant4x4(exactMatrix);
+	return dgOrient4d (p1, p2, p3, point, p0);
 }
 
 dgFloat64 dgConvexHull4dTetraherum::GetTetraVolume(const dgConvexHull4dVector* const points) const
@@ -257,66 +233,35 @@ dgFloat64 dgConvexHull4dTetraherum::GetTetraVolume(const dgConvexHull4dVector* c
 	const dgBigVector &p1 = points[m_faces[0].m_index[1]];
 	const dgBigVector &p2 = points[m_faces[0].m_index[2]];
 	const dgBigVector &p3 = points[m_faces[0].m_index[3]];
-
-	dgFloat64 matrix[3][3];
-	for (dgInt32 i = 0; i < 3; i++) {
-		matrix[0][i] = p2[i] - p0[i];
-		matrix[1][i] = p1[i] - p0[i];
-		matrix[2][i] = p3[i] - p0[i];
-	}
-
-	dgFloat64 error;
-	dgFloat64 det = Determinant3x3(matrix, &error);
-
-
-	dgFloat64 precision = dgFloat64(1.0f) / dgFloat64(1 << 24);
-	dgFloat64 errbound = error * precision;
-	if (fabs(det) > errbound) {
-		return det;
-	}
-
-	dgGoogol exactMatrix[3][3];
-	for (dgInt32 i = 0; i < 3; i++) {
-		exactMatrix[0][i] = dgGoogol(p2[i]) - dgGoogol(p0[i]);
-		exactMatrix[1][i] = dgGoogol(p1[i]) - dgGoogol(p0[i]);
-		exactMatrix[2][i] = dgGoogol(p3[i]) - dgGoogol(p0[i]);
-	}
-	return Determinant3x3(exactMatrix);
+	return dgOrient3d (p1, p2, p3, p0);
 }
 
 
 dgBigVector dgConvexHull4dTetraherum::CircumSphereCenter (const dgConvexHull4dVector* const pointArray) const
 {
-	dgGoogol matrix[4][4];
-
 	dgBigVector points[4];
 	points[0] = pointArray[m_faces[0].m_index[0]];
 	points[1] = pointArray[m_faces[0].m_index[1]];
 	points[2] = pointArray[m_faces[0].m_index[2]];
 	points[3] = pointArray[m_faces[0].m_index[3]];
 
-	for (dgInt32 i = 0; i < 4; i ++) {
-		for (dgInt32 j = 0; j < 3; j ++) {
-			matrix[i][j] = dgGoogol (points[i][j]);
-		}
-		matrix[i][3] = dgGoogol (1.0f);
-	}
-	dgGoogol det (Determinant4x4(matrix));
-	dgFloat64 invDen = dgFloat64 (1.0f) / (dgFloat64(det) * dgFloat64 (2.0f));
+	dgFloat64 det = dgOrient3dExact (points[0], points[1], points[2], points[3]);
+	dgFloat64 invDen = dgFloat64 (1.0f) / (det * dgFloat64 (2.0f));
 
 	dgBigVector centerOut;
 	dgFloat64 sign = dgFloat64 (1.0f);
 	for (dgInt32 k = 0; k < 3; k ++) {
+		dgBigVector minor[4];
 		for (dgInt32 i = 0; i < 4; i ++) {
-			matrix[i][0] = dgGoogol (points[i][3]);
+			minor[i][0] = points[i][3];
 			for (dgInt32 j = 0; j < 2; j ++) {
 				dgInt32 j1 = (j < k) ? j : j + 1; 
-				matrix[i][j + 1] = dgGoogol (points[i][j1]);
+				minor[i][j + 1] = points[i][j1];
 			}
-			matrix[i][3] = dgGoogol (1.0f);
+			minor[i][3] = dgFloat64 (0.0f);
 		}
-		dgGoogol det1 (Determinant4x4(matrix));
-		dgFloat64 val = dgFloat64 (det1) * sign;
+		dgFloat64 det1 = dgOrient3dExact (minor[0], minor[1], minor[2], minor[3]);
+		dgFloat64 val = det1 * sign;
 		sign *= dgFloat64 (-1.0f);
 		centerOut[k] = val * invDen; 
 	}
@@ -890,9 +835,8 @@ void dgConvexHull4d::InsertNewVertex(dgInt32 vertexIndex, dgListNode* const fron
 
 			if (perimeterFace->m_twin->GetInfo().GetMark() == mark) {
 				dgListNode* const newNode = AddFace (vertexIndex, perimeterFace->m_index[0], perimeterFace->m_index[1], perimeterFace->m_index[2]);
-				newFaces.Addtop(newNode);
-
 				dgConvexHull4dTetraherum* const newTetra = &newNode->GetInfo();
+				newTetra->m_boundaryNode = newFaces.Addtop(newNode);
 				newTetra->m_faces[2].m_twin = perimeterNode;
 				perimeterFace->m_twin = newNode;
 				coneList.Append (newNode);
@@ -977,6 +921,9 @@ dgInt32 dgConvexHull4d::AddVertex (const dgBigVector& vertex)
 		dgList<dgListNode*> deleteList(GetAllocator());
 		
 		InsertNewVertex(index, faceNode, deleteList, newFaces);
+		for (dgList<dgListNode*>::dgListNode* newNode = newFaces.GetFirst(); newNode; newNode = newNode->GetNext()) {
+			newNode->GetInfo()->GetInfo().m_boundaryNode = NULL;
+		}
 		for (dgList<dgListNode*>::dgListNode* deleteNode = deleteList.GetFirst(); deleteNode; deleteNode = deleteNode->GetNext()) {
 			dgListNode* const node = deleteNode->GetInfo();
 			DeleteFace (node); 
@@ -1011,8 +958,8 @@ void dgConvexHull4d::CalculateConvexHull (dgConvexHull4dAABBTreeNode* vertexTree
 	dgListNode* const nodes1 = AddFace (0, 1, 3, 2);
 
 	dgList<dgListNode*> boundaryFaces(GetAllocator());
-	boundaryFaces.Append(nodes0);
-	boundaryFaces.Append(nodes1);
+	nodes0->GetInfo().m_boundaryNode = boundaryFaces.Append(nodes0);
+	nodes1->GetInfo().m_boundaryNode = boundaryFaces.Append(nodes1);
 
 	LinkSibling (nodes0, nodes1);
 	LinkSibling (nodes0, nodes1);
@@ -1042,14 +989,18 @@ void dgConvexHull4d::CalculateConvexHull (dgConvexHull4dAABBTreeNode* vertexTree
 
 			for (dgList<dgListNode*>::dgListNode* deleteNode = deleteList.GetFirst(); deleteNode; deleteNode = deleteNode->GetNext()) {
 				dgListNode* const node = deleteNode->GetInfo();
-				boundaryFaces.Remove (node);
+				dgConvexHull4dTetraherum* const deletedFace = &node->GetInfo();
+				if (deletedFace->m_boundaryNode) {
+					boundaryFaces.Remove (deletedFace->m_boundaryNode);
+				}
 				DeleteFace (node); 
 			}
 
 			currentIndex ++;
 			count --;
 		} else {
-			boundaryFaces.Remove (faceNode);
+			boundaryFaces.Remove (face->m_boundaryNode);
+			face->m_boundaryNode = NULL;
 		}
 	}
 	m_count = currentIndex;
@@ -84,6 +84,7 @@ class dgConvexHull4dTetraherum
 
 	public:
 	dgTetrahedrumFace m_faces[4];
+	dgList<dgList<dgConvexHull4dTetraherum>::dgListNode*>::dgListNode* m_boundaryNode;
 	dgInt32 m_mark;
 	dgInt32 m_uniqueID;
 
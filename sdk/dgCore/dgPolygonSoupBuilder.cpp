@@ -29,6 +29,7 @@
 #include "dgMatrix.h"
 #include "dgMemory.h"
 #include "dgPolyhedra.h"
+#include "dgThreadHive.h"
 #include "dgPolygonSoupBuilder.h"
 
 #define DG_POINTS_RUN (512 * 1024)
@@ -80,6 +81,46 @@ class dgPolygonSoupDatabaseBuilder::dgFaceMap: public dgTree<dgFaceBucket, dgInt
 	}
 };
 
+class dgPolygonSoupDatabaseBuilder::dgOptimizeSegment
+{
+	public:
+	dgInt32 m_faceId;
+	dgInt32 m_faceStart;
+	dgInt32 m_faceCount;
+	dgPolygonSoupDatabaseBuilder* m_result;
+};
+
+class dgPolygonSoupDatabaseBuilder::dgOptimizeContext
+{
+	public:
+	dgOptimizeContext (dgMemoryAllocator* const allocator, const dgPolygonSoupDatabaseBuilder& source)
+		:m_faces(allocator)
+		,m_segments(allocator)
+		,m_source(source)
+		,m_faceCount(0)
+		,m_segmentCount(0)
+		,m_atomicIndex(0)
+	{
+	}
+
+	void AddSegment (dgInt32 faceId, dgInt32 faceStart, dgInt32 faceCount)
+	{
+		dgOptimizeSegment& segment = m_segments[m_segmentCount];
+		segment.m_faceId = faceId;
+		segment.m_faceStart = faceStart;
+		segment.m_faceCount = faceCount;
+		segment.m_result = NULL;
+		m_segmentCount ++;
+	}
+
+	dgArray<dgFaceInfo> m_faces;
+	dgArray<dgOptimizeSegment> m_segments;
+	const dgPolygonSoupDatabaseBuilder& m_source;
+	dgInt32 m_faceCount;
+	dgInt32 m_segmentCount;
+	dgInt32 m_atomicIndex;
+};
+
 class dgPolygonSoupDatabaseBuilder::dgPolySoupFilterAllocator: public dgPolyhedra
 {
 	public: 
@@ -493,17 +534,41 @@ void dgPolygonSoupDatabaseBuilder::OptimizeByIndividualFaces()
 }
 
 
-void dgPolygonSoupDatabaseBuilder::End(bool optimize)
+void dgPolygonSoupDatabaseBuilder::End(bool optimize, dgThreadHive* const threadPool)
 {
 	if (optimize) {
 		dgPolygonSoupDatabaseBuilder copy (*this);
 		dgFaceMap faceMap (m_allocator, copy);
 
-		Begin();
+		// split each face bucket in independent segments, segments are optimized 
+		// by the worker threads and added back in the same order of the serial build.
+		dgOptimizeContext context (m_allocator, copy);
 		dgFaceMap::Iterator iter (faceMap);
 		for (iter.Begin(); iter; iter ++) {
 			const dgFaceBucket& bucket = iter.GetNode()->GetInfo();
-			Optimize(iter.GetNode()->GetKey(), bucket, copy);
+			PartitionBucket(iter.GetNode()->GetKey(), bucket, copy, context);
+		}
+
+		Begin();
+		const dgInt32 threadCount = threadPool ? threadPool->GetThreadCount() : 1;
+		if ((threadCount > 1) && (context.m_segmentCount > 1)) {
+			for (dgInt32 i = 0; i < context.m_segmentCount; i ++) {
+				context.m_segments[i].m_result = new (m_allocator) dgPolygonSoupDatabaseBuilder (m_allocator);
+			}
+			for (dgInt32 i = 0; i < threadCount; i ++) {
+				threadPool->QueueJob (OptimizeSegmentsKernel, &context, NULL, "dgPolygonSoupDatabaseBuilder::OptimizeSegments");
+			}
+			threadPool->SynchronizationBarrier();
+			for (dgInt32 i = 0; i < context.m_segmentCount; i ++) {
+				dgPolygonSoupDatabaseBuilder* const result = context.m_segments[i].m_result;
+				AddFaces (*result);
+				delete result;
+			}
+		} else {
+			for (dgInt32 i = 0; i < context.m_segmentCount; i ++) {
+				const dgOptimizeSegment& segment = context.m_segments[i];
+				OptimizeSegment (segment.m_faceId, &context.m_faces[segment.m_faceStart], segment.m_faceCount, copy);
+			}
 		}
 	}
 	Finalize();
@@ -540,23 +605,95 @@ void dgPolygonSoupDatabaseBuilder::End(bool optimize)
 }
 
 
-void dgPolygonSoupDatabaseBuilder::Optimize(dgInt32 faceId, const dgFaceBucket& faceBucket, const dgPolygonSoupDatabaseBuilder& source)
+
+void dgPolygonSoupDatabaseBuilder::OptimizeSegmentsKernel (void* const context0, void* const context1, dgInt32 threadID)
 {
-	#define DG_MESH_PARTITION_SIZE (1024 * 4)
+	dgOptimizeContext* const context = (dgOptimizeContext*) context0;
+	const dgInt32 count = context->m_segmentCount;
+	for (dgInt32 i = dgAtomicExchangeAndAdd (&context->m_atomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd (&context->m_atomicIndex, 1)) {
+		const dgOptimizeSegment& segment = context->m_segments[i];
+		segment.m_result->OptimizeSegment (segment.m_faceId, &context->m_faces[segment.m_faceStart], segment.m_faceCount, context->m_source);
+	}
+}
 
+void dgPolygonSoupDatabaseBuilder::AddFaces (const dgPolygonSoupDatabaseBuilder& source)
+{
+	dgVector face[256];
+	dgInt32 faceIndex[256];
+	dgInt32 faceIndexNumber = 0;
+	for (dgInt32 i = 0; i < source.m_faceCount; i ++) {
+		dgInt32 indexCount = source.m_faceVertexCount[i] - 1;
+		for (dgInt32 j = 0; j < indexCount; j ++) {
+			dgInt32 index = source.m_vertexIndex[faceIndexNumber + j];
+			face[j] = source.m_vertexPoints[index];
+			faceIndex[j] = j;
+		}
+		dgInt32 faceArray = indexCount;
+		dgInt32 faceId = source.m_vertexIndex[faceIndexNumber + indexCount];
+		AddMesh (&face[0].m_x, indexCount, sizeof (dgVector), 1, &faceArray, faceIndex, &faceId, dgGetIdentityMatrix());
+
+		faceIndexNumber += (indexCount + 1); 
+	}
+}
+
+void dgPolygonSoupDatabaseBuilder::OptimizeSegment (dgInt32 faceId, const dgFaceInfo* const faceArray, dgInt32 faceCount, const dgPolygonSoupDatabaseBuilder& source)
+{
 	const dgInt32* const indexArray = &source.m_vertexIndex[0];
 	const dgBigVector* const points = &source.m_vertexPoints[0];
 
 	dgVector face[256];
 	dgInt32 faceIndex[256];
-	if (faceBucket.GetCount() >= DG_MESH_PARTITION_SIZE) {
-		dgStack<dgFaceBucket::dgListNode*> array(faceBucket.GetCount());
-		dgInt32 count = 0;
-		for (dgFaceBucket::dgListNode* node = faceBucket.GetFirst(); node; node = node->GetNext()) {
-			array[count] = node;
-			count ++;
+	dgPolygonSoupDatabaseBuilder tmpBuilder (m_allocator);
+	for (dgInt32 i = 0; i < faceCount; i ++) {
+		const dgFaceInfo& faceInfo = faceArray[i];
+
+		dgInt32 count = faceInfo.indexCount - 1;
+		dgInt32 start = faceInfo.indexStart;
+		dgAssert (faceId == indexArray[start + count]);
+		for (dgInt32 j = 0; j < count; j ++) {
+			dgInt32 index = indexArray[start + j];
+			face[j] = points[index];
+			faceIndex[j] = j;
 		}
+		dgInt32 faceIndexCount = count;
+		tmpBuilder.AddMesh (&face[0].m_x, count, sizeof (dgVector), 1, &faceIndexCount, &faceIndex[0], &faceId, dgGetIdentityMatrix()); 
+	}
+	tmpBuilder.FinalizeAndOptimize ();
+
+	dgInt32 faceIndexNumber = 0;
+	for (dgInt32 i = 0; i < tmpBuilder.m_faceCount; i ++) {
+		dgInt32 indexCount = tmpBuilder.m_faceVertexCount[i] - 1;
+		for (dgInt32 j = 0; j < indexCount; j ++) {
+			dgInt32 index = tmpBuilder.m_vertexIndex[faceIndexNumber + j];
+			face[j] = tmpBuilder.m_vertexPoints[index];
+			faceIndex[j] = j;
+		}
+		dgInt32 faceArray = indexCount;
+		AddMesh (&face[0].m_x, indexCount, sizeof (dgVector), 1, &faceArray, faceIndex, &faceId, dgGetIdentityMatrix());
+
+		faceIndexNumber += (indexCount + 1); 
+	}
+}
+
+void dgPolygonSoupDatabaseBuilder::PartitionBucket (dgInt32 faceId, const dgFaceBucket& faceBucket, const dgPolygonSoupDatabaseBuilder& source, dgOptimizeContext& context) const
+{
+	#define DG_MESH_PARTITION_SIZE (1024 * 4)
 
+	const dgInt32* const indexArray = &source.m_vertexIndex[0];
+	const dgBigVector* const points = &source.m_vertexPoints[0];
+
+	const dgInt32 base = context.m_faceCount;
+	dgInt32 count = 0;
+	for (dgFaceBucket::dgListNode* node = faceBucket.GetFirst(); node; node = node->GetNext()) {
+		context.m_faces[base + count] = node->GetInfo();
+		count ++;
+	}
+	context.m_faceCount += count;
+	dgFaceInfo* const array = &context.m_faces[base];
+
+	if (count < DG_MESH_PARTITION_SIZE) {
+		context.AddSegment (faceId, base, count);
+	} else {
 		dgInt32 stack = 1;
 		dgInt32 segments[32][2];
 			
@@ -569,43 +706,12 @@ void dgPolygonSoupDatabaseBuilder::Optimize(dgInt32 faceId, const dgFaceBucket&
 			dgInt32 faceCount = segments[stack][1];
 
 			if (faceCount <= DG_MESH_PARTITION_SIZE) {
-
-				dgPolygonSoupDatabaseBuilder tmpBuilder (m_allocator);
-				for (dgInt32 i = 0; i < faceCount; i ++) {
-					const dgFaceInfo& faceInfo = array[faceStart + i]->GetInfo();
-
-					dgInt32 count1 = faceInfo.indexCount - 1;
-					dgInt32 start1 = faceInfo.indexStart;
-					dgAssert (faceId == indexArray[start1 + count1]);
-					for (dgInt32 j = 0; j < count1; j ++) {
-						dgInt32 index = indexArray[start1 + j];
-						face[j] = points[index];
-						faceIndex[j] = j;
-					}
-					dgInt32 faceIndexCount = count1;
-					tmpBuilder.AddMesh (&face[0].m_x, count1, sizeof (dgVector), 1, &faceIndexCount, &faceIndex[0], &faceId, dgGetIdentityMatrix()); 
-				}
-				tmpBuilder.FinalizeAndOptimize ();
-
-				dgInt32 faceIndexNumber = 0;
-				for (dgInt32 i = 0; i < tmpBuilder.m_faceCount; i ++) {
-					dgInt32 indexCount = tmpBuilder.m_faceVertexCount[i] - 1;
-					for (dgInt32 j = 0; j < indexCount; j ++) {
-						dgInt32 index = tmpBuilder.m_vertexIndex[faceIndexNumber + j];
-						face[j] = tmpBuilder.m_vertexPoints[index];
-						faceIndex[j] = j;
-					}
-					dgInt32 faceArray = indexCount;
-					AddMesh (&face[0].m_x, indexCount, sizeof (dgVector), 1, &faceArray, faceIndex, &faceId, dgGetIdentityMatrix());
-
-					faceIndexNumber += (indexCount + 1); 
-				}
-
+				context.AddSegment (faceId, base + faceStart, faceCount);
 			} else {
 				dgBigVector median (dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f));
 				dgBigVector varian (dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f), dgFloat32 (0.0f));
 				for (dgInt32 i = 0; i < faceCount; i ++) {
-					const dgFaceInfo& faceInfo = array[faceStart + i]->GetInfo();
+					const dgFaceInfo& faceInfo = array[faceStart + i];
 					dgInt32 count1 = faceInfo.indexCount - 1;
 					dgInt32 start1 = faceInfo.indexStart;
 					dgBigVector p0 (dgFloat32 ( 1.0e10f), dgFloat32 ( 1.0e10f), dgFloat32 ( 1.0e10f), dgFloat32 (0.0f));
@@ -640,7 +746,7 @@ void dgPolygonSoupDatabaseBuilder::Optimize(dgInt32 faceId, const dgFaceBucket&
 
 				for (dgInt32 i = 0; i < lastFace; i ++) {
 					dgInt32 side = 0;
-					const dgFaceInfo& faceInfo = array[faceStart + i]->GetInfo();
+					const dgFaceInfo& faceInfo = array[faceStart + i];
 
 					dgInt32 start1 = faceInfo.indexStart;
 					dgInt32 count1 = faceInfo.indexCount - 1;
@@ -673,38 +779,6 @@ void dgPolygonSoupDatabaseBuilder::Optimize(dgInt32 faceId, const dgFaceBucket&
 				stack ++;
 			}
 		}
-	
-	} else {
-		dgPolygonSoupDatabaseBuilder tmpBuilder (m_allocator);
-		for (dgFaceBucket::dgListNode* node = faceBucket.GetFirst(); node; node = node->GetNext()) {
-			const dgFaceInfo& faceInfo = node->GetInfo();
-
-			dgInt32 count = faceInfo.indexCount - 1;
-			dgInt32 start = faceInfo.indexStart;
-			dgAssert (faceId == indexArray[start + count]);
-			for (dgInt32 j = 0; j < count; j ++) {
-				dgInt32 index = indexArray[start + j];
-				face[j] = points[index];
-				faceIndex[j] = j;
-			}
-			dgInt32 faceIndexCount = count;
-			tmpBuilder.AddMesh (&face[0].m_x, count, sizeof (dgVector), 1, &faceIndexCount, &faceIndex[0], &faceId, dgGetIdentityMatrix()); 
-		}
-		tmpBuilder.FinalizeAndOptimize ();
-
-		dgInt32 faceIndexNumber = 0;
-		for (dgInt32 i = 0; i < tmpBuilder.m_faceCount; i ++) {
-			dgInt32 indexCount = tmpBuilder.m_faceVertexCount[i] - 1;
-			for (dgInt32 j = 0; j < indexCount; j ++) {
-				dgInt32 index = tmpBuilder.m_vertexIndex[faceIndexNumber + j];
-				face[j] = tmpBuilder.m_vertexPoints[index];
-				faceIndex[j] = j;
-			}
-			dgInt32 faceArray = indexCount;
-			AddMesh (&face[0].m_x, indexCount, sizeof (dgVector), 1, &faceArray, faceIndex, &faceId, dgGetIdentityMatrix());
-
-			faceIndexNumber += (indexCount + 1); 
-		}
 	}
 }
 
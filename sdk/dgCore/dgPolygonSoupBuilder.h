@@ -34,6 +34,8 @@
 #include "dgIntersections.h"
 
 
+class dgThreadHive;
+
 class AdjacentdFace
 {
 	public:
@@ -48,6 +50,8 @@ class dgPolygonSoupDatabaseBuilder
 	class dgFaceMap;
 	class dgFaceInfo;
 	class dgFaceBucket;
+	class dgOptimizeSegment;
+	class dgOptimizeContext;
 	class dgPolySoupFilterAllocator;
 	public:
 
@@ -58,14 +62,17 @@ class dgPolygonSoupDatabaseBuilder
 	DG_CLASS_ALLOCATOR(allocator)
 
 	void Begin();
-	void End(bool optimize);
+	void End(bool optimize, dgThreadHive* const threadPool = NULL);
 	void AddMesh (const dgFloat32* const vertex, dgInt32 vertexCount, dgInt32 strideInBytes, dgInt32 faceCount, 
 		          const dgInt32* const faceArray, const dgInt32* const indexArray, const dgInt32* const faceTagsData, const dgMatrix& worldMatrix); 
 
 	void SavePLY(const char* const fileName) const;
 
 	private:
-	void Optimize(dgInt32 faceId, const dgFaceBucket& faceBucket, const dgPolygonSoupDatabaseBuilder& source);
+	void PartitionBucket (dgInt32 faceId, const dgFaceBucket& faceBucket, const dgPolygonSoupDatabaseBuilder& source, dgOptimizeContext& context) const;
+	void OptimizeSegment (dgInt32 faceId, const dgFaceInfo* const faceArray, dgInt32 faceCount, const dgPolygonSoupDatabaseBuilder& source);
+	void AddFaces (const dgPolygonSoupDatabaseBuilder& source);
+	static void OptimizeSegmentsKernel (void* const context0, void* const context1, dgInt32 threadID);
 
 	void Finalize();
 	void FinalizeAndOptimize();
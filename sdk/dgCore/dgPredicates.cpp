@@ -0,0 +1,371 @@
+/* Copyright (c) <2003-2019> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgStdafx.h"
+#include "dgPredicates.h"
+#include "dgSmallDeterminant.h"
+
+// the arithmetic below assumes ieee double precision with round to nearest, 
+// callers building hulls already set the fpu to double precision.
+#define DG_PREDICATE_EPSILON		dgFloat64 (1.1102230246251565e-16)
+#define DG_PREDICATE_SPLITTER		dgFloat64 (134217729.0)
+
+// static error bounds of the floating point filters, in units of the permanent of the matrix
+#define DG_ORIENT3D_ERROR_BOUND		((dgFloat64 (7.0) + dgFloat64 (56.0) * DG_PREDICATE_EPSILON) * DG_PREDICATE_EPSILON)
+#define DG_ORIENT4D_ERROR_BOUND		((dgFloat64 (16.0) + dgFloat64 (256.0) * DG_PREDICATE_EPSILON) * DG_PREDICATE_EPSILON)
+
+// worst case expansion lengths
+#define DG_ORIENT3D_EXPANSION_SIZE	96
+#define DG_ORIENT4D_EXPANSION_SIZE	(5 * 2 * DG_ORIENT3D_EXPANSION_SIZE)
+
+DG_INLINE static void dgFastTwoSum (dgFloat64 a, dgFloat64 b, dgFloat64& x, dgFloat64& y)
+{
+	x = a + b;
+	dgFloat64 bvirt = x - a;
+	y = b - bvirt;
+}
+
+DG_INLINE static void dgTwoSum (dgFloat64 a, dgFloat64 b, dgFloat64& x, dgFloat64& y)
+{
+	x = a + b;
+	dgFloat64 bvirt = x - a;
+	dgFloat64 avirt = x - bvirt;
+	dgFloat64 bround = b - bvirt;
+	dgFloat64 around = a - avirt;
+	y = around + bround;
+}
+
+DG_INLINE static void dgTwoDiff (dgFloat64 a, dgFloat64 b, dgFloat64& x, dgFloat64& y)
+{
+	x = a - b;
+	dgFloat64 bvirt = a - x;
+	dgFloat64 avirt = x + bvirt;
+	dgFloat64 bround = bvirt - b;
+	dgFloat64 around = a - avirt;
+	y = around + bround;
+}
+
+DG_INLINE static void dgSplit (dgFloat64 a, dgFloat64& hi, dgFloat64& lo)
+{
+	dgFloat64 c = DG_PREDICATE_SPLITTER * a;
+	dgFloat64 abig = c - a;
+	hi = c - abig;
+	lo = a - hi;
+}
+
+DG_INLINE static void dgTwoProductPresplit (dgFloat64 a, dgFloat64 b, dgFloat64 bhi, dgFloat64 blo, dgFloat64& x, dgFloat64& y)
+{
+	x = a * b;
+	dgFloat64 ahi;
+	dgFloat64 alo;
+	dgSplit (a, ahi, alo);
+	dgFloat64 err1 = x - (ahi * bhi);
+	dgFloat64 err2 = err1 - (alo * bhi);
+	dgFloat64 err3 = err2 - (ahi * blo);
+	y = (alo * blo) - err3;
+}
+
+DG_INLINE static void dgTwoProduct (dgFloat64 a, dgFloat64 b, dgFloat64& x, dgFloat64& y)
+{
+	dgFloat64 bhi;
+	dgFloat64 blo;
+	dgSplit (b, bhi, blo);
+	dgTwoProductPresplit (a, b, bhi, blo, x, y);
+}
+
+// exact a1 * b1 - a0 * b0 as a four components expansion
+static void dgTwoTwoProductDiff (dgFloat64 a1, dgFloat64 b1, dgFloat64 a0, dgFloat64 b0, dgFloat64* const h)
+{
+	dgFloat64 p1;
+	dgFloat64 p0;
+	dgFloat64 q1;
+	dgFloat64 q0;
+	dgTwoProduct (a1, b1, p1, p0);
+	dgTwoProduct (a0, b0, q1, q0);
+
+	dgFloat64 i;
+	dgFloat64 j;
+	dgFloat64 k;
+	dgTwoDiff (p0, q0, i, h[0]);
+	dgTwoSum (p1, i, j, k);
+	dgTwoDiff (k, q1, i, h[1]);
+	dgTwoSum (j, i, h[3], h[2]);
+}
+
+// h = e + f, both inputs are non overlapping expansions sorted by increasing magnitude. 
+static dgInt32 dgExpansionSum (dgInt32 elen, const dgFloat64* const e, dgInt32 flen, const dgFloat64* const f, dgFloat64* const h)
+{
+	dgFloat64 q;
+	dgFloat64 qnew;
+	dgFloat64 hh;
+
+	dgInt32 eindex = 0;
+	dgInt32 findex = 0;
+	dgFloat64 enow = e[0];
+	dgFloat64 fnow = f[0];
+	if ((fnow > enow) == (fnow > -enow)) {
+		q = enow;
+		eindex ++;
+		enow = (eindex < elen) ? e[eindex] : dgFloat64 (0.0f);
+	} else {
+		q = fnow;
+		findex ++;
+		fnow = (findex < flen) ? f[findex] : dgFloat64 (0.0f);
+	}
+
+	dgInt32 hindex = 0;
+	if ((eindex < elen) && (findex < flen)) {
+		if ((fnow > enow) == (fnow > -enow)) {
+			dgFastTwoSum (enow, q, qnew, hh);
+			eindex ++;
+			enow = (eindex < elen) ? e[eindex] : dgFloat64 (0.0f);
+		} else {
+			dgFastTwoSum (fnow, q, qnew, hh);
+			findex ++;
+			fnow = (findex < flen) ? f[findex] : dgFloat64 (0.0f);
+		}
+		q = qnew;
+		if (hh != dgFloat64 (0.0f)) {
+			h[hindex] = hh;
+			hindex ++;
+		}
+		while ((eindex < elen) && (findex < flen)) {
+			if ((fnow > enow) == (fnow > -enow)) {
+				dgTwoSum (q, enow, qnew, hh);
+				eindex ++;
+				enow = (eindex < elen) ? e[eindex] : dgFloat64 (0.0f);
+			} else {
+				dgTwoSum (q, fnow, qnew, hh);
+				findex ++;
+				fnow = (findex < flen) ? f[findex] : dgFloat64 (0.0f);
+			}
+			q = qnew;
+			if (hh != dgFloat64 (0.0f)) {
+				h[hindex] = hh;
+				hindex ++;
+			}
+		}
+	}
+
+	for (; eindex < elen; eindex ++) {
+		dgTwoSum (q, e[eindex], qnew, hh);
+		q = qnew;
+		if (hh != dgFloat64 (0.0f)) {
+			h[hindex] = hh;
+			hindex ++;
+		}
+	}
+
+	for (; findex < flen; findex ++) {
+		dgTwoSum (q, f[findex], qnew, hh);
+		q = qnew;
+		if (hh != dgFloat64 (0.0f)) {
+			h[hindex] = hh;
+			hindex ++;
+		}
+	}
+
+	if ((q != dgFloat64 (0.0f)) || (hindex == 0)) {
+		h[hindex] = q;
+		hindex ++;
+	}
+	return hindex;
+}
+
+// h = e * b
+static dgInt32 dgExpansionScale (dgInt32 elen, const dgFloat64* const e, dgFloat64 b, dgFloat64* const h)
+{
+	dgFloat64 bhi;
+	dgFloat64 blo;
+	dgFloat64 q;
+	dgFloat64 hh;
+	dgSplit (b, bhi, blo);
+	dgTwoProductPresplit (e[0], b, bhi, blo, q, hh);
+
+	dgInt32 hindex = 0;
+	if (hh != dgFloat64 (0.0f)) {
+		h[hindex] = hh;
+		hindex ++;
+	}
+	for (dgInt32 i = 1; i < elen; i ++) {
+		dgFloat64 product1;
+		dgFloat64 product0;
+		dgFloat64 sum;
+		dgTwoProductPresplit (e[i], b, bhi, blo, product1, product0);
+		dgTwoSum (q, product0, sum, hh);
+		if (hh != dgFloat64 (0.0f)) {
+			h[hindex] = hh;
+			hindex ++;
+		}
+		dgFastTwoSum (product1, sum, q, hh);
+		if (hh != dgFloat64 (0.0f)) {
+			h[hindex] = hh;
+			hindex ++;
+		}
+	}
+	if ((q != dgFloat64 (0.0f)) || (hindex == 0)) {
+		h[hindex] = q;
+		hindex ++;
+	}
+	return hindex;
+}
+
+static dgFloat64 dgExpansionEstimate (dgInt32 elen, const dgFloat64* const e)
+{
+	dgFloat64 q = e[0];
+	for (dgInt32 i = 1; i < elen; i ++) {
+		q += e[i];
+	}
+	return q;
+}
+
+// exact determinant [a - d, b - d, c - d], computed from the original coordinates so that no difference is rounded
+static dgInt32 dgOrient3dExpansion (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d, dgFloat64* const deter)
+{
+	dgFloat64 ab[4];
+	dgFloat64 bc[4];
+	dgFloat64 cd[4];
+	dgFloat64 da[4];
+	dgFloat64 ac[4];
+	dgFloat64 bd[4];
+	dgTwoTwoProductDiff (a.m_x, b.m_y, b.m_x, a.m_y, ab);
+	dgTwoTwoProductDiff (b.m_x, c.m_y, c.m_x, b.m_y, bc);
+	dgTwoTwoProductDiff (c.m_x, d.m_y, d.m_x, c.m_y, cd);
+	dgTwoTwoProductDiff (d.m_x, a.m_y, a.m_x, d.m_y, da);
+	dgTwoTwoProductDiff (a.m_x, c.m_y, c.m_x, a.m_y, ac);
+	dgTwoTwoProductDiff (b.m_x, d.m_y, d.m_x, b.m_y, bd);
+
+	dgFloat64 temp8[8];
+	dgFloat64 abc[12];
+	dgFloat64 bcd[12];
+	dgFloat64 cda[12];
+	dgFloat64 dab[12];
+	dgInt32 templen = dgExpansionSum (4, cd, 4, da, temp8);
+	const dgInt32 cdalen = dgExpansionSum (templen, temp8, 4, ac, cda);
+	templen = dgExpansionSum (4, da, 4, ab, temp8);
+	const dgInt32 dablen = dgExpansionSum (templen, temp8, 4, bd, dab);
+	for (dgInt32 i = 0; i < 4; i ++) {
+		bd[i] = -bd[i];
+		ac[i] = -ac[i];
+	}
+	templen = dgExpansionSum (4, ab, 4, bc, temp8);
+	const dgInt32 abclen = dgExpansionSum (templen, temp8, 4, ac, abc);
+	templen = dgExpansionSum (4, bc, 4, cd, temp8);
+	const dgInt32 bcdlen = dgExpansionSum (templen, temp8, 4, bd, bcd);
+
+	dgFloat64 adet[24];
+	dgFloat64 bdet[24];
+	dgFloat64 cdet[24];
+	dgFloat64 ddet[24];
+	const dgInt32 alen = dgExpansionScale (bcdlen, bcd, a.m_z, adet);
+	const dgInt32 blen = dgExpansionScale (cdalen, cda, -b.m_z, bdet);
+	const dgInt32 clen = dgExpansionScale (dablen, dab, c.m_z, cdet);
+	const dgInt32 dlen = dgExpansionScale (abclen, abc, -d.m_z, ddet);
+
+	dgFloat64 abdet[48];
+	dgFloat64 cddet[48];
+	const dgInt32 ablen = dgExpansionSum (alen, adet, blen, bdet, abdet);
+	const dgInt32 cdlen = dgExpansionSum (clen, cdet, dlen, ddet, cddet);
+	return dgExpansionSum (ablen, abdet, cdlen, cddet, deter);
+}
+
+dgFloat64 dgOrient3dExact (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d)
+{
+	dgFloat64 deter[DG_ORIENT3D_EXPANSION_SIZE];
+	const dgInt32 deterlen = dgOrient3dExpansion (a, b, c, d, deter);
+	return dgExpansionEstimate (deterlen, deter);
+}
+
+dgFloat64 dgOrient3d (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d)
+{
+	const dgFloat64 adx = a.m_x - d.m_x;
+	const dgFloat64 bdx = b.m_x - d.m_x;
+	const dgFloat64 cdx = c.m_x - d.m_x;
+	const dgFloat64 ady = a.m_y - d.m_y;
+	const dgFloat64 bdy = b.m_y - d.m_y;
+	const dgFloat64 cdy = c.m_y - d.m_y;
+	const dgFloat64 adz = a.m_z - d.m_z;
+	const dgFloat64 bdz = b.m_z - d.m_z;
+	const dgFloat64 cdz = c.m_z - d.m_z;
+
+	const dgFloat64 bdxcdy = bdx * cdy;
+	const dgFloat64 cdxbdy = cdx * bdy;
+	const dgFloat64 cdxady = cdx * ady;
+	const dgFloat64 adxcdy = adx * cdy;
+	const dgFloat64 adxbdy = adx * bdy;
+	const dgFloat64 bdxady = bdx * ady;
+
+	const dgFloat64 det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+	const dgFloat64 permanent = (dgAbs(bdxcdy) + dgAbs(cdxbdy)) * dgAbs(adz) + (dgAbs(cdxady) + dgAbs(adxcdy)) * dgAbs(bdz) + (dgAbs(adxbdy) + dgAbs(bdxady)) * dgAbs(cdz);
+	const dgFloat64 errbound = DG_ORIENT3D_ERROR_BOUND * permanent;
+	if ((det > errbound) || (-det > errbound)) {
+		return det;
+	}
+	return dgOrient3dExact (a, b, c, d);
+}
+
+dgFloat64 dgOrient4d (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d, const dgBigVector& e)
+{
+	dgFloat64 matrix[4][4];
+	for (dgInt32 i = 0; i < 4; i ++) {
+		matrix[0][i] = a[i] - e[i];
+		matrix[1][i] = b[i] - e[i];
+		matrix[2][i] = c[i] - e[i];
+		matrix[3][i] = d[i] - e[i];
+	}
+
+	dgFloat64 permanent;
+	const dgFloat64 det = Determinant4x4 (matrix, &permanent);
+	const dgFloat64 errbound = DG_ORIENT4D_ERROR_BOUND * permanent;
+	if ((det > errbound) || (-det > errbound)) {
+		return det;
+	}
+
+	// expand the 5x5 determinant [p, w, 1] along the w column, 
+	// each minor is an exact 3d orientation of the remaining four points.
+	const dgBigVector* const points[] = {&a, &b, &c, &d, &e};
+
+	dgInt32 deterlen = 0;
+	dgFloat64 deter[DG_ORIENT4D_EXPANSION_SIZE];
+	dgFloat64 sum[DG_ORIENT4D_EXPANSION_SIZE];
+	dgFloat64 minor[DG_ORIENT3D_EXPANSION_SIZE];
+	dgFloat64 term[2 * DG_ORIENT3D_EXPANSION_SIZE];
+	for (dgInt32 i = 0; i < 5; i ++) {
+		const dgBigVector* quad[4];
+		for (dgInt32 j = 0, k = 0; j < 5; j ++) {
+			if (j != i) {
+				quad[k] = points[j];
+				k ++;
+			}
+		}
+		const dgInt32 minorlen = dgOrient3dExpansion (*quad[0], *quad[1], *quad[2], *quad[3], minor);
+		const dgFloat64 w = (i & 1) ? points[i]->m_w : -points[i]->m_w;
+		const dgInt32 termlen = dgExpansionScale (minorlen, minor, w, term);
+		if (deterlen) {
+			deterlen = dgExpansionSum (deterlen, deter, termlen, term, sum);
+			memcpy (deter, sum, deterlen * sizeof (dgFloat64));
+		} else {
+			deterlen = termlen;
+			memcpy (deter, term, deterlen * sizeof (dgFloat64));
+		}
+	}
+	return dgExpansionEstimate (deterlen, deter);
+}
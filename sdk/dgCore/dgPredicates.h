@@ -0,0 +1,43 @@
+/* Copyright (c) <2003-2019> <Julio Jerez, Newton Game Dynamics>
+* 
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* 
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef __dgPREDICATES__
+#define __dgPREDICATES__
+
+#include "dgStdafx.h"
+#include "dgVector.h"
+
+// adaptive geometric predicates, after J. R. Shewchuk "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric Predicates".
+// a floating point filter with a static error bound resolves the common case, 
+// only near degenerate configurations are evaluated with exact expansion arithmetic.
+// the sign of the returned value is always exact.
+
+// determinant of the 3x3 matrix [a - d, b - d, c - d] using the x, y, z components
+dgFloat64 dgOrient3d (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d);
+
+// determinant of the 4x4 matrix [a - e, b - e, c - e, d - e] using the x, y, z, w components, 
+// for points lifted to the paraboloid this is the in sphere test.
+dgFloat64 dgOrient4d (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d, const dgBigVector& e);
+
+// same as dgOrient3d but always evaluated exactly, the result is the exact determinant rounded to a double
+dgFloat64 dgOrient3dExact (const dgBigVector& a, const dgBigVector& b, const dgBigVector& c, const dgBigVector& d);
+
+#endif
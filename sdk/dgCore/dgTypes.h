@@ -560,6 +560,17 @@ DG_INLINE void* dgInterlockedExchange(void** const ptr, void* value)
 	#endif
 }
 
+DG_INLINE void* dgInterlockedCompareExchange(void** const ptr, void* const newValue, void* const comparand)
+{
+	#if (defined (_WIN_32_VER) || defined (_WIN_64_VER) || defined (__MINGW32__) || defined (__MINGW64__))
+		return _InterlockedCompareExchangePointer(ptr, newValue, comparand);
+	#elif (defined (_POSIX_VER) || defined (_POSIX_VER_64) ||defined (_MACOSX_VER))
+		return __sync_val_compare_and_swap(ptr, comparand, newValue);
+	#else
+		#error "dgInterlockedCompareExchange implementation required"
+	#endif
+}
+
 
 DG_INLINE dgInt32 dgInterlockedTest(dgInt32* const ptr, dgInt32 value)
 {
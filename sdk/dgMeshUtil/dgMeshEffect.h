@@ -339,6 +339,7 @@ class dgMeshEffect: public dgPolyhedra, public dgRefCounter
 	//bool PlaneClip (const dgBigPlane& plane);
 	
 	dgMeshEffect* ConvexMeshIntersection (const dgMeshEffect* const convexMesh) const;
+	void ConvexMeshIntersection (dgThreadHive* const threadPool, dgInt32 count, const dgMeshEffect* const* const convexMeshArray, dgMeshEffect** const output) const;
 
 	dgMeshEffect* GetFirstLayer ();
 	dgMeshEffect* GetNextLayer (dgMeshEffect* const layer);
@@ -418,6 +419,7 @@ class dgMeshEffect: public dgPolyhedra, public dgRefCounter
 
 	dgMeshEffect* CreateSimplification (dgInt32 maxVertexCount, dgReportProgress reportProgressCallback, void* const userData) const;
 	dgMeshEffect* CreateConvexApproximation (dgFloat32 maxConcavity, dgFloat32 backFaceDistanceFactor, dgInt32 maxHullOuputCount, dgInt32 maxVertexPerHull, dgReportProgress reportProgressCallback, void* const userData) const;
+	dgMeshEffect* CreateVoxelConvexApproximation (dgThreadHive* const threadPool, dgInt32 voxelResolution, dgFloat32 maxConcavity, dgInt32 maxHullOuputCount, dgInt32 maxVertexPerHull, dgReportProgress reportProgressCallback, void* const userData) const;
 
 	dgMeshEffect* CreateTetrahedraIsoSurface() const;
 	void CreateTetrahedraLinearBlendSkinWeightsChannel (const dgMeshEffect* const tetrahedraMesh);
@@ -498,6 +500,7 @@ class dgMeshEffect: public dgPolyhedra, public dgRefCounter
 	friend class dgConvexHull4d;
 	friend class dgBooleanMeshBVH;
 	friend class dgHACDClusterGraph;
+	friend class dgVoxelConvexDecomposition;
 	friend class dgTriangleAnglesToUV;
 	friend class dgTetraIsoSufaceStuffing;
 	friend class dgCollisionCompoundFractured;
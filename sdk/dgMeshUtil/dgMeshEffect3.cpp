@@ -1369,3 +1369,723 @@ dgMeshEffect* dgMeshEffect::CreateConvexApproximation(dgFloat32 maxConcavity, dg
 
 	return partition;
 }
+
+
+#define DG_VOXEL_MIN_RESOLUTION		8
+#define DG_VOXEL_MAX_RESOLUTION		256
+#define DG_VOXEL_SPLIT_CANDIDATES	16
+#define DG_VOXEL_SEARCH_ROWS		16
+#define DG_VOXEL_SEARCH_VERTEX		128
+#define DG_VOXEL_SPLIT_OVERSHOOT	2
+#define DG_VOXEL_BALANCE_WEIGHT		dgFloat64 (0.05f)
+
+class dgVoxelConvexDecomposition
+{
+	public:
+	enum dgVoxelState
+	{
+		m_empty = 0,
+		m_surface,
+		m_exterior,
+	};
+
+	class dgVoxelPart
+	{
+		public:
+		dgVoxelPart()
+			:m_voxels()
+			,m_hull()
+			,m_voxelCount(0)
+			,m_hullCount(0)
+			,m_volume(dgFloat64 (0.0f))
+			,m_hullVolume(dgFloat64 (0.0f))
+			,m_concavity(dgFloat64 (0.0f))
+		{
+		}
+
+		dgArray<dgInt32> m_voxels;
+		dgArray<dgBigVector> m_hull;
+		dgInt32 m_boxP0[3];
+		dgInt32 m_boxP1[3];
+		dgInt32 m_voxelCount;
+		dgInt32 m_hullCount;
+		dgFloat64 m_volume;
+		dgFloat64 m_hullVolume;
+		dgFloat64 m_concavity;
+	};
+
+	class dgSplitPlane
+	{
+		public:
+		dgInt32 m_axis;
+		dgInt32 m_index;
+		dgFloat64 m_cost;
+	};
+
+	class dgSplitContext
+	{
+		public:
+		dgVoxelConvexDecomposition* m_me;
+		const dgVoxelPart* m_part;
+		dgSplitPlane* m_planes;
+		dgInt32 m_planeCount;
+		dgInt32 m_rowStride;
+		dgInt32 m_nextPlane;
+	};
+
+	class dgHullContext
+	{
+		public:
+		dgVoxelConvexDecomposition* m_me;
+		dgVoxelPart** m_parts;
+		dgFloat64* m_costs;
+		dgInt32 m_count;
+		dgInt32 m_stride;
+		dgInt32 m_row;
+		dgInt32 m_nextItem;
+	};
+
+	dgVoxelConvexDecomposition (const dgMeshEffect& mesh, dgThreadHive* const threadPool, dgInt32 resolution, dgFloat32 maxConcavity, dgInt32 maxHullCount, dgInt32 maxVertexPerHull, dgReportProgress reportProgressCallback, void* const userData)
+		:m_allocator(mesh.GetAllocator())
+		,m_threadPool(threadPool)
+		,m_grid(mesh.GetAllocator())
+		,m_parts(mesh.GetAllocator())
+		,m_origin(dgFloat64 (0.0f))
+		,m_voxelSize(dgFloat64 (0.0f))
+		,m_voxelVolume(dgFloat64 (0.0f))
+		,m_totalVolume(dgFloat64 (0.0f))
+		,m_maxConcavity(maxConcavity)
+		,m_maxHullCount(maxHullCount)
+		,m_maxVertexPerHull(maxVertexPerHull)
+		,m_reportProgressCallback(reportProgressCallback)
+		,m_reportProgressUserData(userData)
+	{
+		m_size[0] = 0;
+		m_size[1] = 0;
+		m_size[2] = 0;
+		Voxelize (mesh, resolution);
+	}
+
+	dgMeshEffect* CreatePartitionMesh ()
+	{
+		if (!m_totalVolume || !ReportProgress (dgFloat32 (0.1f))) {
+			return NULL;
+		}
+		if (!Decompose ()) {
+			return NULL;
+		}
+		
+		dgInt32 count = m_parts.GetCount();
+		dgStack<dgVoxelPart*> partPool (count);
+		dgVoxelPart** const parts = &partPool[0];
+		dgInt32 index = 0;
+		for (dgList<dgVoxelPart>::dgListNode* node = m_parts.GetFirst(); node; node = node->GetNext()) {
+			parts[index] = &node->GetInfo();
+			index ++;
+		}
+
+		dgHullContext context;
+		context.m_me = this;
+		context.m_parts = parts;
+		context.m_costs = NULL;
+		context.m_count = count;
+		context.m_stride = count;
+		context.m_row = -1;
+		context.m_nextItem = 0;
+		ParallelFor (BuildHullKernel, &context, "dgVoxelConvexDecomposition::BuildHull");
+
+		count = MergeHulls (parts, count);
+		if (!count) {
+			return NULL;
+		}
+
+		dgMeshEffect* const partition = new (m_allocator) dgMeshEffect (m_allocator);
+		partition->BeginBuild();
+		dgInt32 layer = 0;
+		for (dgInt32 i = 0; i < count; i ++) {
+			const dgVoxelPart* const part = parts[i];
+			dgMeshEffect convexMesh (m_allocator, &part->m_hull[0].m_x, part->m_hullCount, sizeof (dgBigVector), dgFloat64 (0.0f));
+			if (convexMesh.GetCount()) {
+				for (dgInt32 j = 0; j < convexMesh.m_points.m_vertex.m_count; j++) {
+					convexMesh.m_points.m_layers[j] = layer;
+				}
+				partition->MergeFaces(&convexMesh);
+				layer++;
+			}
+		}
+		partition->EndBuild(dgFloat64(1.0e-5f));
+		ReportProgress (dgFloat32 (1.0f));
+		return partition;
+	}
+
+	private:
+	bool ReportProgress (dgFloat32 progress) const
+	{
+		return m_reportProgressCallback ? m_reportProgressCallback (progress, m_reportProgressUserData) : true;
+	}
+
+	void ParallelFor (dgWorkerThreadTaskCallback kernel, void* const context, const char* const name)
+	{
+		if (m_threadPool) {
+			const dgInt32 threadCount = dgMax (m_threadPool->GetThreadCount(), 1);
+			for (dgInt32 i = 0; i < threadCount; i ++) {
+				m_threadPool->QueueJob (kernel, context, NULL, name);
+			}
+			m_threadPool->SynchronizationBarrier();
+		} else {
+			kernel (context, NULL, 0);
+		}
+	}
+
+	DG_INLINE dgInt32 GetIndex (dgInt32 x, dgInt32 y, dgInt32 z) const
+	{
+		return (z * m_size[1] + y) * m_size[0] + x;
+	}
+
+	DG_INLINE void GetCoordinate (dgInt32 index, dgInt32* const coord) const
+	{
+		coord[0] = index % m_size[0];
+		index /= m_size[0];
+		coord[1] = index % m_size[1];
+		coord[2] = index / m_size[1];
+	}
+
+	static bool AxisOverlap (const dgBigVector& axis, const dgBigVector& v0, const dgBigVector& v1, const dgBigVector& v2, const dgBigVector& halfSize)
+	{
+		const dgFloat64 p0 = axis.DotProduct(v0).GetScalar();
+		const dgFloat64 p1 = axis.DotProduct(v1).GetScalar();
+		const dgFloat64 p2 = axis.DotProduct(v2).GetScalar();
+		const dgFloat64 r = halfSize.m_x * dgAbs (axis.m_x) + halfSize.m_y * dgAbs (axis.m_y) + halfSize.m_z * dgAbs (axis.m_z);
+		return (dgMin (p0, dgMin (p1, p2)) <= r) && (dgMax (p0, dgMax (p1, p2)) >= -r);
+	}
+
+	// separating axis test of a triangle against an axis aligned box centered at the origin
+	static bool TriangleBoxOverlap (const dgBigVector& v0, const dgBigVector& v1, const dgBigVector& v2, const dgBigVector& halfSize)
+	{
+		const dgBigVector edges[] = {v1 - v0, v2 - v1, v0 - v2};
+		const dgBigVector axis[] = {dgBigVector (dgFloat64 (1.0f), dgFloat64 (0.0f), dgFloat64 (0.0f), dgFloat64 (0.0f)), 
+									dgBigVector (dgFloat64 (0.0f), dgFloat64 (1.0f), dgFloat64 (0.0f), dgFloat64 (0.0f)), 
+									dgBigVector (dgFloat64 (0.0f), dgFloat64 (0.0f), dgFloat64 (1.0f), dgFloat64 (0.0f))};
+		for (dgInt32 i = 0; i < 3; i ++) {
+			for (dgInt32 j = 0; j < 3; j ++) {
+				if (!AxisOverlap (axis[i].CrossProduct(edges[j]), v0, v1, v2, halfSize)) {
+					return false;
+				}
+			}
+		}
+		for (dgInt32 i = 0; i < 3; i ++) {
+			if (!AxisOverlap (axis[i], v0, v1, v2, halfSize)) {
+				return false;
+			}
+		}
+		return AxisOverlap (edges[0].CrossProduct(edges[1]), v0, v1, v2, halfSize);
+	}
+
+	void RasterizeTriangle (const dgBigVector& p0, const dgBigVector& p1, const dgBigVector& p2)
+	{
+		const dgFloat64 invVoxelSize = dgFloat64 (1.0f) / m_voxelSize;
+		const dgBigVector halfSize (m_voxelSize * dgFloat64 (0.5f + 1.0e-6f));
+		dgInt32 box0[3];
+		dgInt32 box1[3];
+		for (dgInt32 i = 0; i < 3; i ++) {
+			const dgFloat64 minValue = dgMin (p0[i], dgMin (p1[i], p2[i]));
+			const dgFloat64 maxValue = dgMax (p0[i], dgMax (p1[i], p2[i]));
+			box0[i] = dgClamp (dgInt32 (dgFloor ((minValue - m_origin[i]) * invVoxelSize)) - 1, 1, m_size[i] - 2);
+			box1[i] = dgClamp (dgInt32 (dgFloor ((maxValue - m_origin[i]) * invVoxelSize)) + 1, 1, m_size[i] - 2);
+		}
+
+		for (dgInt32 z = box0[2]; z <= box1[2]; z ++) {
+			for (dgInt32 y = box0[1]; y <= box1[1]; y ++) {
+				for (dgInt32 x = box0[0]; x <= box1[0]; x ++) {
+					const dgInt32 index = GetIndex (x, y, z);
+					if (m_grid[index] != m_surface) {
+						dgBigVector center (m_origin + dgBigVector (dgFloat64 (x) + dgFloat64 (0.5f), dgFloat64 (y) + dgFloat64 (0.5f), dgFloat64 (z) + dgFloat64 (0.5f), dgFloat64 (0.0f)).Scale (m_voxelSize));
+						center.m_w = dgFloat64 (0.0f);
+						if (TriangleBoxOverlap (p0 - center, p1 - center, p2 - center, halfSize)) {
+							m_grid[index] = m_surface;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void Voxelize (const dgMeshEffect& mesh, dgInt32 resolution)
+	{
+		const dgInt32 vertexCount = mesh.GetVertexCount();
+		if (!vertexCount) {
+			return;
+		}
+		const dgBigVector* const points = (dgBigVector*) mesh.GetVertexPool();
+		dgBigVector minBox (points[0]);
+		dgBigVector maxBox (points[0]);
+		for (dgInt32 i = 1; i < vertexCount; i ++) {
+			minBox = minBox.GetMin (points[i]);
+			maxBox = maxBox.GetMax (points[i]);
+		}
+		const dgBigVector extent (maxBox - minBox);
+		const dgFloat64 maxExtent = dgMax (extent.m_x, dgMax (extent.m_y, extent.m_z));
+		if (maxExtent < dgFloat64 (1.0e-6f)) {
+			return;
+		}
+
+		// pad the grid by one empty voxel on each side so that the exterior is connected
+		m_voxelSize = maxExtent / resolution;
+		m_voxelVolume = m_voxelSize * m_voxelSize * m_voxelSize;
+		m_origin = minBox - dgBigVector (m_voxelSize);
+		m_origin.m_w = dgFloat64 (0.0f);
+		for (dgInt32 i = 0; i < 3; i ++) {
+			m_size[i] = dgInt32 (dgFloor (extent[i] / m_voxelSize)) + 3;
+		}
+		const dgInt32 gridCount = m_size[0] * m_size[1] * m_size[2];
+		m_grid.Resize (gridCount);
+		memset (&m_grid[0], m_empty, gridCount * sizeof (dgUnsigned8));
+
+		dgInt32 mark = mesh.IncLRU();
+		dgPolyhedra::Iterator iter (mesh);
+		for (iter.Begin(); iter; iter ++) {
+			dgEdge* const edge = &iter.GetNode()->GetInfo();
+			if ((edge->m_mark != mark) && (edge->m_incidentFace > 0)) {
+				const dgBigVector& p0 = points[edge->m_incidentVertex];
+				dgBigVector p1 (points[edge->m_next->m_incidentVertex]);
+				edge->m_mark = mark;
+				edge->m_next->m_mark = mark;
+				for (dgEdge* ptr = edge->m_next->m_next; ptr != edge; ptr = ptr->m_next) {
+					const dgBigVector& p2 = points[ptr->m_incidentVertex];
+					ptr->m_mark = mark;
+					RasterizeTriangle (p0, p1, p2);
+					p1 = p2;
+				}
+			}
+		}
+
+		// flood fill the exterior from the padding corner, whatever is left is surface or interior
+		dgStack<dgInt32> stackPool (gridCount);
+		dgInt32* const stack = &stackPool[0];
+		dgInt32 stackIndex = 1;
+		stack[0] = 0;
+		m_grid[0] = m_exterior;
+		const dgInt32 neighbors[] = {1, -1, m_size[0], -m_size[0], m_size[0] * m_size[1], -m_size[0] * m_size[1]};
+		while (stackIndex) {
+			stackIndex --;
+			const dgInt32 index = stack[stackIndex];
+			dgInt32 coord[3];
+			GetCoordinate (index, coord);
+			for (dgInt32 i = 0; i < 6; i ++) {
+				const dgInt32 axis = i >> 1;
+				const dgInt32 step = (i & 1) ? -1 : 1;
+				const dgInt32 value = coord[axis] + step;
+				if ((value >= 0) && (value < m_size[axis])) {
+					const dgInt32 neighbor = index + neighbors[i];
+					if (m_grid[neighbor] == m_empty) {
+						m_grid[neighbor] = m_exterior;
+						stack[stackIndex] = neighbor;
+						stackIndex ++;
+					}
+				}
+			}
+		}
+
+		dgVoxelPart& root = m_parts.Append()->GetInfo();
+		root.m_voxels.SetAllocator (m_allocator);
+		root.m_hull.SetAllocator (m_allocator);
+		for (dgInt32 i = 0; i < 3; i ++) {
+			root.m_boxP0[i] = m_size[i];
+			root.m_boxP1[i] = -1;
+		}
+		for (dgInt32 i = 0; i < gridCount; i ++) {
+			if (m_grid[i] != m_exterior) {
+				AddVoxel (root, i);
+			}
+		}
+		m_totalVolume = root.m_volume;
+		if (m_totalVolume > dgFloat64 (0.0f)) {
+			CalculateConcavity (root);
+		}
+	}
+
+	void AddVoxel (dgVoxelPart& part, dgInt32 index) const
+	{
+		dgInt32 coord[3];
+		GetCoordinate (index, coord);
+		for (dgInt32 i = 0; i < 3; i ++) {
+			part.m_boxP0[i] = dgMin (part.m_boxP0[i], coord[i]);
+			part.m_boxP1[i] = dgMax (part.m_boxP1[i], coord[i]);
+		}
+		part.m_voxels[part.m_voxelCount] = index;
+		part.m_voxelCount ++;
+		part.m_volume += m_voxelVolume;
+	}
+
+	dgInt32 GetRowStride (const dgVoxelPart& part) const
+	{
+		const dgInt32 rows = dgMax (part.m_boxP1[1] - part.m_boxP0[1], part.m_boxP1[2] - part.m_boxP0[2]) + 1;
+		return dgMax (rows / DG_VOXEL_SEARCH_ROWS, 1);
+	}
+
+	// the hull of a voxel set is the hull of the end caps of each row along the x axis, 
+	// rows are bucketed in blocks of rowStride x rowStride which gives a slightly conservative hull. 
+	// when axis is not negative only the voxels on one side of the split plane are considered.
+	dgInt32 GetHullPoints (const dgVoxelPart& part, dgInt32 axis, dgInt32 plane, bool leftSide, dgInt32 rowStride, dgArray<dgBigVector>& points, dgFloat64& volume) const
+	{
+		const dgInt32 y0 = part.m_boxP0[1];
+		const dgInt32 z0 = part.m_boxP0[2];
+		const dgInt32 rowsY = (part.m_boxP1[1] - y0) / rowStride + 1;
+		const dgInt32 rowsZ = (part.m_boxP1[2] - z0) / rowStride + 1;
+		dgStack<dgInt32> rowMinPool (rowsY * rowsZ);
+		dgStack<dgInt32> rowMaxPool (rowsY * rowsZ);
+		dgInt32* const rowMin = &rowMinPool[0];
+		dgInt32* const rowMax = &rowMaxPool[0];
+		for (dgInt32 i = 0; i < rowsY * rowsZ; i ++) {
+			rowMin[i] = 0x7fffffff;
+			rowMax[i] = -1;
+		}
+
+		dgInt32 voxelCount = 0;
+		for (dgInt32 i = 0; i < part.m_voxelCount; i ++) {
+			dgInt32 coord[3];
+			GetCoordinate (part.m_voxels[i], coord);
+			if ((axis < 0) || ((coord[axis] < plane) == leftSide)) {
+				const dgInt32 row = ((coord[2] - z0) / rowStride) * rowsY + (coord[1] - y0) / rowStride;
+				rowMin[row] = dgMin (rowMin[row], coord[0]);
+				rowMax[row] = dgMax (rowMax[row], coord[0]);
+				voxelCount ++;
+			}
+		}
+		volume = voxelCount * m_voxelVolume;
+
+		dgInt32 count = 0;
+		for (dgInt32 z = 0; z < rowsZ; z ++) {
+			const dgFloat64 za = dgFloat64 (z0 + z * rowStride);
+			const dgFloat64 zb = dgFloat64 (dgMin (z0 + (z + 1) * rowStride, part.m_boxP1[2] + 1));
+			for (dgInt32 y = 0; y < rowsY; y ++) {
+				const dgInt32 row = z * rowsY + y;
+				if (rowMax[row] >= 0) {
+					const dgFloat64 ya = dgFloat64 (y0 + y * rowStride);
+					const dgFloat64 yb = dgFloat64 (dgMin (y0 + (y + 1) * rowStride, part.m_boxP1[1] + 1));
+					const dgFloat64 xa = dgFloat64 (rowMin[row]);
+					const dgFloat64 xb = dgFloat64 (rowMax[row] + 1);
+					points[count + 0] = dgBigVector (xa, ya, za, dgFloat64 (0.0f));
+					points[count + 1] = dgBigVector (xa, yb, za, dgFloat64 (0.0f));
+					points[count + 2] = dgBigVector (xa, ya, zb, dgFloat64 (0.0f));
+					points[count + 3] = dgBigVector (xa, yb, zb, dgFloat64 (0.0f));
+					points[count + 4] = dgBigVector (xb, ya, za, dgFloat64 (0.0f));
+					points[count + 5] = dgBigVector (xb, yb, za, dgFloat64 (0.0f));
+					points[count + 6] = dgBigVector (xb, ya, zb, dgFloat64 (0.0f));
+					points[count + 7] = dgBigVector (xb, yb, zb, dgFloat64 (0.0f));
+					count += 8;
+				}
+			}
+		}
+
+		for (dgInt32 i = 0; i < count; i ++) {
+			points[i] = m_origin + points[i].Scale (m_voxelSize);
+			points[i].m_w = dgFloat64 (0.0f);
+		}
+		return count;
+	}
+
+	dgFloat64 CalculateHullVolume (const dgBigVector* const points, dgInt32 count, dgInt32 maxVertexCount, dgArray<dgBigVector>* const hullPoints = NULL, dgInt32* const hullCount = NULL) const
+	{
+		if (count < 4) {
+			return dgFloat64 (0.0f);
+		}
+		dgConvexHull3d hull (m_allocator, &points[0].m_x, sizeof (dgBigVector), count, dgFloat64 (0.0f), maxVertexCount);
+		if (!hull.GetCount()) {
+			return dgFloat64 (0.0f);
+		}
+		if (hullPoints) {
+			// the vertex pool can still hold interior points, only keep the ones referenced by a face
+			const dgInt32 vertexCount = hull.GetVertexCount();
+			dgStack<dgInt8> mask (vertexCount);
+			memset (&mask[0], 0, vertexCount * sizeof (dgInt8));
+			for (dgConvexHull3d::dgListNode* node = hull.GetFirst(); node; node = node->GetNext()) {
+				const dgConvexHull3DFace& face = node->GetInfo();
+				mask[face.m_index[0]] = 1;
+				mask[face.m_index[1]] = 1;
+				mask[face.m_index[2]] = 1;
+			}
+			dgInt32 count = 0;
+			for (dgInt32 i = 0; i < vertexCount; i ++) {
+				if (mask[i]) {
+					(*hullPoints)[count] = hull.GetVertex(i);
+					count ++;
+				}
+			}
+			*hullCount = count;
+		}
+		dgFloat64 volume;
+		dgFloat64 area;
+		hull.CalculateVolumeAndSurfaceArea (volume, area);
+		return volume;
+	}
+
+	void CalculateConcavity (dgVoxelPart& part) const
+	{
+		dgFloat64 volume;
+		dgArray<dgBigVector> points (m_allocator);
+		const dgInt32 count = GetHullPoints (part, -1, 0, true, GetRowStride (part), points, volume);
+		const dgFloat64 hullVolume = CalculateHullVolume (&points[0], count, DG_VOXEL_SEARCH_VERTEX);
+		part.m_concavity = dgMax (hullVolume - part.m_volume, dgFloat64 (0.0f)) / m_totalVolume;
+	}
+
+	dgFloat64 CalculateSplitCost (const dgVoxelPart& part, const dgSplitPlane& plane, dgInt32 rowStride) const
+	{
+		dgFloat64 volume[2];
+		dgFloat64 concavity[2];
+		dgArray<dgBigVector> points (m_allocator);
+		for (dgInt32 i = 0; i < 2; i ++) {
+			const dgInt32 count = GetHullPoints (part, plane.m_axis, plane.m_index, i ? false : true, rowStride, points, volume[i]);
+			const dgFloat64 hullVolume = CalculateHullVolume (&points[0], count, DG_VOXEL_SEARCH_VERTEX);
+			concavity[i] = dgMax (hullVolume - volume[i], dgFloat64 (0.0f));
+		}
+		return (concavity[0] + concavity[1] + DG_VOXEL_BALANCE_WEIGHT * dgAbs (volume[0] - volume[1])) / m_totalVolume;
+	}
+
+	static void SplitCostKernel (void* const context, void* const, dgInt32 threadID)
+	{
+		dgSplitContext* const data = (dgSplitContext*) context;
+		for (dgInt32 i = dgAtomicExchangeAndAdd (&data->m_nextPlane, 1); i < data->m_planeCount; i = dgAtomicExchangeAndAdd (&data->m_nextPlane, 1)) {
+			data->m_planes[i].m_cost = data->m_me->CalculateSplitCost (*data->m_part, data->m_planes[i], data->m_rowStride);
+		}
+	}
+
+	bool SplitPart (dgList<dgVoxelPart>& pending, dgList<dgVoxelPart>::dgListNode* const node)
+	{
+		const dgVoxelPart& part = node->GetInfo();
+		dgSplitPlane planes[3 * DG_VOXEL_SPLIT_CANDIDATES];
+		dgInt32 planeCount = 0;
+		for (dgInt32 axis = 0; axis < 3; axis ++) {
+			const dgInt32 step = (part.m_boxP1[axis] - part.m_boxP0[axis] + DG_VOXEL_SPLIT_CANDIDATES) / DG_VOXEL_SPLIT_CANDIDATES;
+			for (dgInt32 index = part.m_boxP0[axis] + step; index <= part.m_boxP1[axis]; index += step) {
+				planes[planeCount].m_axis = axis;
+				planes[planeCount].m_index = index;
+				planes[planeCount].m_cost = dgFloat64 (1.0e20f);
+				planeCount ++;
+			}
+		}
+		if (!planeCount) {
+			return false;
+		}
+
+		dgSplitContext context;
+		context.m_me = this;
+		context.m_part = &part;
+		context.m_planes = planes;
+		context.m_planeCount = planeCount;
+		context.m_rowStride = GetRowStride (part);
+		context.m_nextPlane = 0;
+		ParallelFor (SplitCostKernel, &context, "dgVoxelConvexDecomposition::SplitCost");
+
+		dgInt32 bestPlane = 0;
+		for (dgInt32 i = 1; i < planeCount; i ++) {
+			if (planes[i].m_cost < planes[bestPlane].m_cost) {
+				bestPlane = i;
+			}
+		}
+
+		const dgInt32 axis = planes[bestPlane].m_axis;
+		const dgInt32 plane = planes[bestPlane].m_index;
+		dgVoxelPart* const children[] = {&pending.Append()->GetInfo(), &pending.Append()->GetInfo()};
+		for (dgInt32 i = 0; i < 2; i ++) {
+			children[i]->m_voxels.SetAllocator (m_allocator);
+			children[i]->m_hull.SetAllocator (m_allocator);
+			for (dgInt32 j = 0; j < 3; j ++) {
+				children[i]->m_boxP0[j] = m_size[j];
+				children[i]->m_boxP1[j] = -1;
+			}
+		}
+		for (dgInt32 i = 0; i < part.m_voxelCount; i ++) {
+			dgInt32 coord[3];
+			GetCoordinate (part.m_voxels[i], coord);
+			AddVoxel (*children[(coord[axis] < plane) ? 0 : 1], part.m_voxels[i]);
+		}
+		CalculateConcavity (*children[0]);
+		CalculateConcavity (*children[1]);
+		pending.Remove (node);
+		return true;
+	}
+
+	bool Decompose ()
+	{
+		// keep splitting the most concave part, overshooting the hull budget so that the merge pass has room to choose
+		const dgInt32 maxPartCount = m_maxHullCount * DG_VOXEL_SPLIT_OVERSHOOT;
+		dgList<dgVoxelPart> pending (m_allocator);
+		dgList<dgVoxelPart>::dgListNode* const root = m_parts.GetFirst();
+		m_parts.Unlink (root);
+		pending.Append (root);
+
+		dgFloat64 acceptedVolume = dgFloat64 (0.0f);
+		while (pending.GetCount()) {
+			dgList<dgVoxelPart>::dgListNode* bestNode = pending.GetFirst();
+			for (dgList<dgVoxelPart>::dgListNode* node = bestNode->GetNext(); node; node = node->GetNext()) {
+				if (node->GetInfo().m_concavity > bestNode->GetInfo().m_concavity) {
+					bestNode = node;
+				}
+			}
+			const dgVoxelPart& part = bestNode->GetInfo();
+			const bool accept = (part.m_concavity <= m_maxConcavity) || ((pending.GetCount() + m_parts.GetCount()) >= maxPartCount) || (part.m_voxelCount < 2);
+			if (accept || !SplitPart (pending, bestNode)) {
+				acceptedVolume += part.m_volume;
+				pending.Unlink (bestNode);
+				m_parts.Append (bestNode);
+			}
+			if (!ReportProgress (dgFloat32 (0.1f + 0.7f * acceptedVolume / m_totalVolume))) {
+				return false;
+			}
+		}
+		m_grid.Clear();
+		return true;
+	}
+
+	void BuildHull (dgVoxelPart& part) const
+	{
+		dgFloat64 volume;
+		dgArray<dgBigVector> points (m_allocator);
+		const dgInt32 count = GetHullPoints (part, -1, 0, true, 1, points, volume);
+		part.m_hullCount = 0;
+		part.m_hullVolume = CalculateHullVolume (&points[0], count, m_maxVertexPerHull, &part.m_hull, &part.m_hullCount);
+		part.m_voxels.Clear();
+	}
+
+	static void BuildHullKernel (void* const context, void* const, dgInt32 threadID)
+	{
+		dgHullContext* const data = (dgHullContext*) context;
+		for (dgInt32 i = dgAtomicExchangeAndAdd (&data->m_nextItem, 1); i < data->m_count; i = dgAtomicExchangeAndAdd (&data->m_nextItem, 1)) {
+			data->m_me->BuildHull (*data->m_parts[i]);
+		}
+	}
+
+	dgFloat64 CalculateMergeCost (const dgVoxelPart& part0, const dgVoxelPart& part1) const
+	{
+		dgArray<dgBigVector> points (m_allocator);
+		for (dgInt32 i = 0; i < part0.m_hullCount; i ++) {
+			points[i] = part0.m_hull[i];
+		}
+		for (dgInt32 i = 0; i < part1.m_hullCount; i ++) {
+			points[part0.m_hullCount + i] = part1.m_hull[i];
+		}
+		const dgFloat64 hullVolume = CalculateHullVolume (&points[0], part0.m_hullCount + part1.m_hullCount, DG_VOXEL_SEARCH_VERTEX);
+		return (hullVolume - part0.m_volume - part1.m_volume) / m_totalVolume;
+	}
+
+	static void MergeCostKernel (void* const context, void* const, dgInt32 threadID)
+	{
+		dgHullContext* const data = (dgHullContext*) context;
+		const dgInt32 itemCount = (data->m_row >= 0) ? data->m_count : data->m_count * data->m_count;
+		for (dgInt32 i = dgAtomicExchangeAndAdd (&data->m_nextItem, 1); i < itemCount; i = dgAtomicExchangeAndAdd (&data->m_nextItem, 1)) {
+			const dgInt32 row = (data->m_row >= 0) ? data->m_row : i / data->m_count;
+			const dgInt32 column = (data->m_row >= 0) ? i : i % data->m_count;
+			if (row != column) {
+				const dgInt32 i0 = dgMin (row, column);
+				const dgInt32 i1 = dgMax (row, column);
+				if ((data->m_row >= 0) || (row < column)) {
+					const dgFloat64 cost = data->m_me->CalculateMergeCost (*data->m_parts[i0], *data->m_parts[i1]);
+					data->m_costs[i0 * data->m_stride + i1] = cost;
+					data->m_costs[i1 * data->m_stride + i0] = cost;
+				}
+			}
+		}
+	}
+
+	dgInt32 MergeHulls (dgVoxelPart** const parts, dgInt32 count)
+	{
+		dgInt32 stride = count;
+		for (dgInt32 i = 0; i < count; i ++) {
+			if (parts[i]->m_hullCount < 4) {
+				parts[i] = parts[count - 1];
+				count --;
+				i --;
+			}
+		}
+		if (count <= 1) {
+			return count;
+		}
+
+		dgStack<dgFloat64> costPool (stride * stride);
+		dgFloat64* const costs = &costPool[0];
+
+		dgHullContext context;
+		context.m_me = this;
+		context.m_parts = parts;
+		context.m_costs = costs;
+		context.m_count = count;
+		context.m_stride = stride;
+		context.m_row = -1;
+		context.m_nextItem = 0;
+		ParallelFor (MergeCostKernel, &context, "dgVoxelConvexDecomposition::MergeCost");
+
+		const dgInt32 startCount = count;
+		dgArray<dgBigVector> points (m_allocator);
+		while (count > 1) {
+			dgInt32 i0 = 0;
+			dgInt32 i1 = 1;
+			for (dgInt32 i = 0; i < count; i ++) {
+				for (dgInt32 j = i + 1; j < count; j ++) {
+					if (costs[i * stride + j] < costs[i0 * stride + i1]) {
+						i0 = i;
+						i1 = j;
+					}
+				}
+			}
+			if ((count <= m_maxHullCount) && (costs[i0 * stride + i1] > m_maxConcavity)) {
+				break;
+			}
+
+			dgVoxelPart& part0 = *parts[i0];
+			const dgVoxelPart& part1 = *parts[i1];
+			for (dgInt32 i = 0; i < part0.m_hullCount; i ++) {
+				points[i] = part0.m_hull[i];
+			}
+			for (dgInt32 i = 0; i < part1.m_hullCount; i ++) {
+				points[part0.m_hullCount + i] = part1.m_hull[i];
+			}
+			part0.m_volume += part1.m_volume;
+			part0.m_hullVolume = CalculateHullVolume (&points[0], part0.m_hullCount + part1.m_hullCount, m_maxVertexPerHull, &part0.m_hull, &part0.m_hullCount);
+
+			// move the last part into the free slot
+			count --;
+			parts[i1] = parts[count];
+			for (dgInt32 i = 0; i < count; i ++) {
+				costs[i1 * stride + i] = costs[count * stride + i];
+				costs[i * stride + i1] = costs[i * stride + count];
+			}
+
+			context.m_count = count;
+			context.m_row = i0;
+			context.m_nextItem = 0;
+			ParallelFor (MergeCostKernel, &context, "dgVoxelConvexDecomposition::MergeCost");
+
+			if (!ReportProgress (dgFloat32 (0.8f + 0.2f * (startCount - count) / startCount))) {
+				return 0;
+			}
+		}
+		return count;
+	}
+
+	dgMemoryAllocator* m_allocator;
+	dgThreadHive* m_threadPool;
+	dgArray<dgUnsigned8> m_grid;
+	dgList<dgVoxelPart> m_parts;
+	dgBigVector m_origin;
+	dgFloat64 m_voxelSize;
+	dgFloat64 m_voxelVolume;
+	dgFloat64 m_totalVolume;
+	dgFloat64 m_maxConcavity;
+	dgInt32 m_size[3];
+	dgInt32 m_maxHullCount;
+	dgInt32 m_maxVertexPerHull;
+	dgReportProgress m_reportProgressCallback;
+	void* m_reportProgressUserData;
+};
+
+dgMeshEffect* dgMeshEffect::CreateVoxelConvexApproximation (dgThreadHive* const threadPool, dgInt32 voxelResolution, dgFloat32 maxConcavity, dgInt32 maxHullOuputCount, dgInt32 maxVertexPerHull, dgReportProgress reportProgressCallback, void* const userData) const
+{
+	voxelResolution = dgClamp (voxelResolution, DG_VOXEL_MIN_RESOLUTION, DG_VOXEL_MAX_RESOLUTION);
+	maxConcavity = dgMax (maxConcavity, dgFloat32 (1.0e-5f));
+	maxHullOuputCount = dgMax (maxHullOuputCount, 1);
+	maxVertexPerHull = dgMax (maxVertexPerHull, 4);
+
+	dgVoxelConvexDecomposition decomposition (*this, threadPool, voxelResolution, maxConcavity, maxHullOuputCount, maxVertexPerHull, reportProgressCallback, userData);
+	return decomposition.CreatePartitionMesh();
+}
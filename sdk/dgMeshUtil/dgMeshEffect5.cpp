@@ -332,6 +332,57 @@ dgMeshEffect* dgMeshEffect::ConvexMeshIntersection (const dgMeshEffect* const co
 	return convexIntersection;
 }
 
+class dgConvexMeshIntersectionBatch
+{
+	public:
+	static void IntersectionKernel (void* const context, void* const, dgInt32 threadID)
+	{
+		dgConvexMeshIntersectionBatch* const batch = (dgConvexMeshIntersectionBatch*) context;
+		for (dgInt32 i = dgAtomicExchangeAndAdd(&batch->m_nextMesh, 1); i < batch->m_count; i = dgAtomicExchangeAndAdd(&batch->m_nextMesh, 1)) {
+			const dgMeshEffect* const convexMesh = batch->m_convexMeshArray[i];
+			batch->m_output[i] = NULL;
+
+			// cells that do not touch the mesh bounding box are empty, skip the mesh copy
+			dgBigVector boxP0;
+			dgBigVector boxP1;
+			convexMesh->CalculateAABB (boxP0, boxP1);
+			if ((boxP0.m_x <= batch->m_boxP1.m_x) && (boxP0.m_y <= batch->m_boxP1.m_y) && (boxP0.m_z <= batch->m_boxP1.m_z) &&
+				(boxP1.m_x >= batch->m_boxP0.m_x) && (boxP1.m_y >= batch->m_boxP0.m_y) && (boxP1.m_z >= batch->m_boxP0.m_z)) {
+				batch->m_output[i] = batch->m_mesh->ConvexMeshIntersection (convexMesh);
+			}
+		}
+	}
+
+	const dgMeshEffect* m_mesh;
+	const dgMeshEffect* const* m_convexMeshArray;
+	dgMeshEffect** m_output;
+	dgBigVector m_boxP0;
+	dgBigVector m_boxP1;
+	dgInt32 m_count;
+	dgInt32 m_nextMesh;
+};
+
+void dgMeshEffect::ConvexMeshIntersection (dgThreadHive* const threadPool, dgInt32 count, const dgMeshEffect* const* const convexMeshArray, dgMeshEffect** const output) const
+{
+	dgConvexMeshIntersectionBatch batch;
+	batch.m_mesh = this;
+	batch.m_convexMeshArray = convexMeshArray;
+	batch.m_output = output;
+	batch.m_count = count;
+	batch.m_nextMesh = 0;
+	CalculateAABB (batch.m_boxP0, batch.m_boxP1);
+
+	if (threadPool) {
+		const dgInt32 threadCount = dgMax (threadPool->GetThreadCount(), 1);
+		for (dgInt32 i = 0; i < threadCount; i ++) {
+			threadPool->QueueJob (dgConvexMeshIntersectionBatch::IntersectionKernel, &batch, NULL, "dgMeshEffect::ConvexMeshIntersection");
+		}
+		threadPool->SynchronizationBarrier();
+	} else {
+		dgConvexMeshIntersectionBatch::IntersectionKernel (&batch, NULL, 0);
+	}
+}
+
 
 void dgMeshEffect::ClipMesh (const dgMatrix& matrix, const dgMeshEffect* const clipMesh, dgMeshEffect** const back, dgMeshEffect** const front) const
 {
@@ -235,6 +235,81 @@ void NewtonSetContactMergeTolerance (const NewtonWorld* const newtonWorld, dFloa
 	world->SetContactMergeTolerance(tolerance);
 }
 
+/*!
+  Return non zero if the world creates its shapes in the process wide shared shape cache.
+
+  @param *newtonWorld Pointer to the Newton world.
+
+  See also: ::NewtonWorldSetSharedShapeCache
+*/
+int NewtonWorldGetSharedShapeCache (const NewtonWorld* const newtonWorld)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	return world->GetSharedShapeCache() ? 1 : 0;
+}
+
+/*!
+  Make the world create convex shapes and tree collisions in the process wide shared shape cache.
+
+  @param *newtonWorld Pointer to the Newton world.
+  @param state 1 to share shapes with all other worlds that enable the cache, 0 to keep a private cache (default).
+
+  @return Nothing.
+
+  Shapes in the shared cache are identified by their geometry, so the same box, convex hull or tree collision
+  created by any number of worlds is stored once and released when the last instance using it is destroyed.
+  Shared shapes are allocated outside the world memory pool, so they can outlive the world that created them.
+  A tree collision becomes shared when *NewtonTreeCollisionEndBuild* is called, after that it must be treated as read only,
+  including its debug and ray cast callbacks, since they are seen by every world that uses the shape.
+  Changing the state only affects shapes created afterward.
+
+  See also: ::NewtonGetSharedShapeCacheInfo
+*/
+void NewtonWorldSetSharedShapeCache (const NewtonWorld* const newtonWorld, int state)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	world->SetSharedShapeCache(state ? true : false);
+}
+
+/*!
+  Get the statistics of the process wide shared shape cache.
+
+  @param *shapeCount number of unique shapes in the cache.
+  @param *instanceCount number of collision instances referencing the cached shapes.
+  @param *hitCount number of times a shape creation was served by an existing shape.
+  @param *missCount number of shapes added to the cache.
+  @param *memoryUsed memory in bytes used by the cached shapes.
+
+  @return Nothing.
+
+  Any of the pointers can be NULL.
+
+  See also: ::NewtonWorldSetSharedShapeCache
+*/
+void NewtonGetSharedShapeCacheInfo (int* const shapeCount, int* const instanceCount, int* const hitCount, int* const missCount, int* const memoryUsed)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionShapeCacheStats stats;
+	dgCollisionShapeCache::GetCache().GetStats(stats);
+	if (shapeCount) {
+		*shapeCount = stats.m_shapeCount;
+	}
+	if (instanceCount) {
+		*instanceCount = stats.m_instanceCount;
+	}
+	if (hitCount) {
+		*hitCount = stats.m_hitCount;
+	}
+	if (missCount) {
+		*missCount = stats.m_missCount;
+	}
+	if (memoryUsed) {
+		*memoryUsed = stats.m_memoryUsed;
+	}
+}
+
 
 /*!
   Reset all internal engine states.
@@ -262,6 +337,34 @@ void NewtonInvalidateCache(const NewtonWorld* const newtonWorld)
 	world->FlushCache();
 }
 
+/*!
+  Translate the whole world by an offset without rebuilding the broadphase.
+
+  @param *newtonWorld Pointer to the Newton world.
+  @param *offset pointer to an array of at least three floats with the translation to add to every body.
+
+  Use this function to keep the region of interest close to the origin in large worlds, where single
+  precision positions lose resolution. Body matrices, collision shapes, broadphase boxes and cached
+  contacts are moved, so the simulation continues exactly as before the shift.
+
+  This is a single world wide rebase, the solver does not use per island local frames. Only the bodies
+  close to the new origin gain resolution, islands far from it keep the precision of their world
+  positions.
+
+  Joints that keep world space targets, like kinematic controllers, must be shifted by the application.
+  The transform callback is called for every body on the next update.
+
+  This function must be called outside of a Newton Update.
+
+  See also: ::NewtonInvalidateCache
+*/
+void NewtonWorldShiftOrigin(const NewtonWorld* const newtonWorld, const dFloat* const offset)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	world->ShiftOrigin(dgVector(offset[0], offset[1], offset[2], dgFloat32(0.0f)));
+}
+
 void NewtonSetJointSerializationCallbacks (const NewtonWorld* const newtonWorld, NewtonOnJointSerializationCallback serializeJoint, NewtonOnJointDeserializationCallback deserializeJoint)
 {
 	TRACE_FUNCTION(__FUNCTION__);
@@ -617,6 +720,90 @@ int NewtonGetSolverIterations(const NewtonWorld* const newtonWorld)
 	return world->GetSolverIterations();
 }
 
+/*!
+  Set the upper limit of solver iterations for islands that are still converging.
+
+  @param *newtonWorld is the pointer to the Newton world
+  @param maxIterations maximum number of iteration per island, zero or any value below the solver iterations disables it.
+
+  @return Nothing
+
+  After executing the number of iterations set by NewtonSetSolverIterations, an island whose joints residual acceleration 
+  is still above the tolerance keeps iterating, but only while each pass reduces the residual by at least ten percent, 
+  and never beyond maxIterations. Islands that are at rest or that converge early are not affected, so the extra work
+  is spent only on islands where bodies are actually moving.
+
+  The limit is ignored by solver plugins selected with *NewtonSelectPlugin*, they always run the 
+  iterations set by NewtonSetSolverIterations.
+*/
+void NewtonSetSolverMaxIterations(const NewtonWorld* const newtonWorld, int maxIterations)
+{
+	Newton* const world = (Newton *)newtonWorld;
+
+	TRACE_FUNCTION(__FUNCTION__);
+	world->SetSolverMaxIterations(maxIterations);
+}
+
+/*!
+  Get the upper limit of solver iterations per island.
+*/
+int NewtonGetSolverMaxIterations(const NewtonWorld* const newtonWorld)
+{
+	Newton* const world = (Newton *)newtonWorld;
+
+	TRACE_FUNCTION(__FUNCTION__);
+	return world->GetSolverMaxIterations();
+}
+
+/*!
+  Return the number of islands solved by the last world update.
+
+  @param *newtonWorld is the pointer to the Newton world
+
+  @return islands count, or zero while the world is updating.
+
+  See also: NewtonWorldGetSolverIslandStats
+*/
+int NewtonWorldGetSolverIslandCount(const NewtonWorld* const newtonWorld)
+{
+	Newton* const world = (Newton *)newtonWorld;
+
+	TRACE_FUNCTION(__FUNCTION__);
+	return world->GetSolverIslandCount();
+}
+
+/*!
+  Get the convergence stats of an island solved by the last world update.
+
+  @param *newtonWorld is the pointer to the Newton world
+  @param islandIndex index of the island, from 0 to NewtonWorldGetSolverIslandCount - 1.
+  @param *bodyCount pointer to receive the number of bodies in the island.
+  @param *jointCount pointer to receive the number of joints and contacts in the island.
+  @param *passes pointer to receive the number of solver iterations executed for the island in the last sub step, added over the four integration stages.
+  @param *residual pointer to receive the sum over the island joints of the squared residual acceleration left after the last iteration, largest over the integration stages of the last sub step.
+
+  @return 1 if the island index is valid, 0 otherwise.
+
+  islands solved by the parallel solver are merged, they all report the same passes and residual. 
+  Islands with no joints and islands that were at rest report zero passes. 
+  Islands solved by a solver plugin selected with *NewtonSelectPlugin* also report zero passes and residual.
+*/
+int NewtonWorldGetSolverIslandStats(const NewtonWorld* const newtonWorld, int islandIndex, int* const bodyCount, int* const jointCount, int* const passes, dFloat* const residual)
+{
+	Newton* const world = (Newton *)newtonWorld;
+
+	TRACE_FUNCTION(__FUNCTION__);
+	const dgBodyCluster* const island = world->GetSolverIsland(islandIndex);
+	if (!island) {
+		return 0;
+	}
+	*bodyCount = island->m_bodyCount - 1;
+	*jointCount = island->m_jointCount;
+	*passes = island->m_solverPasses;
+	*residual = dFloat (island->m_solverResidual);
+	return 1;
+}
+
 
 /*!
   Advance the simulation by a user defined amount of time.
@@ -680,6 +867,90 @@ int NewtonGetNumberOfSubsteps (const NewtonWorld* const newtonWorld)
 	return world->GetSubsteps ();
 }
 
+/*!
+  Enable or disable lightweight sub steps.
+
+  @param *newtonWorld is the pointer to the Newton world
+  @param state 1 to run lightweight sub steps, 0 to run the full pipeline on each sub step.
+
+  @return Nothing
+
+  When enabled and the world has more than one sub step (see NewtonSetNumberOfSubsteps), only the first sub step 
+  calls the force and torque callbacks, updates the broad phase and calculates contacts. The following sub steps keep 
+  the external forces and the contact joints of the first one; each contact point is moved with the bodies and its 
+  penetration is corrected by the relative normal displacement, before the solver runs again.
+  This gives most of the stiffness of sub stepping at a fraction of the cost, but pre update listeners are called 
+  once per step, and new contacts are not found until the next step.
+*/
+void NewtonSetLightweightSubsteps (const NewtonWorld* const newtonWorld, int state)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	world->SetLightweightSubsteps (state ? true : false);
+}
+
+/*!
+  Return 1 if lightweight sub steps are enabled.
+
+  See also: NewtonSetLightweightSubsteps
+*/
+int NewtonGetLightweightSubsteps (const NewtonWorld* const newtonWorld)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	return world->GetLightweightSubsteps () ? 1 : 0;
+}
+
+/*!
+  Return the largest number of vertices any thread has requested from the mesh query scratch pool.
+
+  @param *newtonWorld Pointer to the Newton world.
+
+  Height fields and other procedural meshes write the polygons touched by a convex shape into per thread, 
+  growth only scratch buffers. The application can read this value after running a representative scene 
+  and pass it to ::NewtonReserveMeshQueryScratch at load time, so that contact calculation never allocates.
+*/
+int NewtonGetMeshQueryScratchHighWaterMark (const NewtonWorld* const newtonWorld)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	return world->GetMeshScratchPool().GetHighWaterMark();
+}
+
+/*!
+  Return the number of bytes held by the mesh query scratch pool.
+
+  @param *newtonWorld Pointer to the Newton world.
+
+  This is the capacity of the per thread scratch buffers, not the part in use by the last query. 
+  The buffers are never shrunk, so the value only grows until the world is destroyed.
+
+  See also: ::NewtonGetMeshQueryScratchHighWaterMark, ::NewtonReserveMeshQueryScratch
+*/
+int NewtonGetMeshQueryScratchMemoryUsed (const NewtonWorld* const newtonWorld)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	return world->GetMeshScratchPool().GetMemoryUsed();
+}
+
+/*!
+  Grow the mesh query scratch buffer of every thread to hold at least a number of vertices.
+
+  @param *newtonWorld Pointer to the Newton world.
+  @param vertexCount number of vertices, usually the value returned by ::NewtonGetMeshQueryScratchHighWaterMark.
+
+  Call this at load time, outside of a Newton Update. Buffers already larger than the request are left as they are.
+
+  See also: ::NewtonGetMeshQueryScratchMemoryUsed
+*/
+void NewtonReserveMeshQueryScratch (const NewtonWorld* const newtonWorld, int vertexCount)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	world->GetMeshScratchPool().Reserve(vertexCount);
+}
+
 
 
 /*!
@@ -994,6 +1265,15 @@ void NewtonWorldSetCollisionConstructorDestructorCallback (const NewtonWorld* co
 	world->SetCollisionInstanceConstructorDestructor((dgWorld::OnCollisionInstanceDuplicate) constructor, (dgWorld::OnCollisionInstanceDestroy)destructor);
 }
 
+// the callback is called from the broadphase worker threads, once per frame for each moving body with lod proxies.
+// it returns the level to use, level zero is the full detail shape.
+void NewtonWorldSetCollisionLodCallback (const NewtonWorld* const newtonWorld, NewtonCollisionLodCallback callback)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	world->SetCollisionLodCallback((dgWorld::OnCollisionLodSelect) callback);
+}
+
 void* NewtonWorldAddListener(const NewtonWorld* const newtonWorld, const char* const nameId, void* const listenerUserData)
 {
 	TRACE_FUNCTION(__FUNCTION__);
@@ -2488,8 +2768,8 @@ void* NewtonCompoundCollisionAddSubCollision (NewtonCollision* const compoundCol
 	
 	dgCollisionInstance* const compoundInstance = (dgCollisionInstance*) compoundCollision;
 	dgCollisionInstance* const compoundInstanceChild = (dgCollisionInstance*) convexCollision;
-	if (compoundInstance->IsType (dgCollision::dgCollisionCompound_RTTI) && compoundInstanceChild->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetChildShape();
+	if (compoundInstance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI) && compoundInstanceChild->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetLodShape(0);
 		return collision->AddCollision (compoundInstanceChild);
 	}
 	return NULL;
@@ -2500,8 +2780,8 @@ void NewtonCompoundCollisionRemoveSubCollision (NewtonCollision* const compoundC
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		dgCollisionInstance* const childCollision = collision->GetCollisionFromNode((dgCollisionCompound::dgTreeArray::dgTreeNode*)collisionNode);
 		if (childCollision && childCollision->IsType(dgCollision::dgCollisionConvexShape_RTTI)) {
 			collision->RemoveCollision ((dgCollisionCompound::dgTreeArray::dgTreeNode*)collisionNode);
@@ -2513,8 +2793,8 @@ void NewtonCompoundCollisionRemoveSubCollisionByIndex (NewtonCollision* const co
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		NewtonCompoundCollisionRemoveSubCollision (compoundCollision, collision->FindNodeByIndex(nodeIndex));
 	}
 }
@@ -2524,8 +2804,8 @@ void NewtonCompoundCollisionSetSubCollisionMatrix (NewtonCollision* const compou
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const compoundInstance = (dgCollisionInstance*) compoundCollision;
-	if (compoundInstance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetChildShape();
+	if (compoundInstance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetLodShape(0);
 		collision->SetCollisionMatrix((dgCollisionCompound::dgTreeArray::dgTreeNode*)collisionNode, dgMatrix(matrix));
 	}
 }
@@ -2535,8 +2815,8 @@ void NewtonCompoundCollisionBeginAddRemove (NewtonCollision* const compoundColli
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		collision->BeginAddRemove();
 	}
 }
@@ -2545,9 +2825,11 @@ void NewtonCompoundCollisionEndAddRemove (NewtonCollision* const compoundCollisi
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		collision->EndAddRemove();
+		// proxies built from the old compound are stale, the instance goes back to the full detail shape
+		instance->RemoveLodShapes();
 	}
 }
 
@@ -2556,8 +2838,8 @@ void* NewtonCompoundCollisionGetFirstNode (NewtonCollision* const compoundCollis
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		return collision->GetFirstNode();
 	}
 	return NULL;
@@ -2567,8 +2849,8 @@ void* NewtonCompoundCollisionGetNextNode (NewtonCollision* const compoundCollisi
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		return collision->GetNextNode((dgCollisionCompound::dgTreeArray::dgTreeNode*)node);
 	}
 	return NULL;
@@ -2578,8 +2860,8 @@ void* NewtonCompoundCollisionGetNodeByIndex (NewtonCollision* const compoundColl
 {
 	TRACE_FUNCTION(__FUNCTION__);	
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		return collision->FindNodeByIndex(index);
 	}
 	return NULL;
@@ -2589,8 +2871,8 @@ int NewtonCompoundCollisionGetNodeIndex (NewtonCollision* const compoundCollisio
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) compoundCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		return collision->GetNodeIndex((dgCollisionCompound::dgTreeArray::dgTreeNode*)node);
 	}
 	return -1;
@@ -2601,8 +2883,8 @@ NewtonCollision* NewtonCompoundCollisionGetCollisionFromNode (NewtonCollision* c
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const compoundInstance = (dgCollisionInstance*) compoundCollision;
-	if (compoundInstance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetChildShape();
+	if (compoundInstance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) compoundInstance->GetLodShape(0);
 		return (NewtonCollision*) collision->GetCollisionFromNode((dgCollisionCompound::dgTreeArray::dgTreeNode*)node);
 	}
 	return NULL;
@@ -2678,8 +2960,8 @@ NewtonCollision* NewtonFracturedCompoundPlaneClip (const NewtonCollision* const
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		dgWorld* const world = (dgWorld*)collision->GetWorld();
 		dgCollisionCompoundFractured* const newCompound = compound->PlaneClip(dgVector (plane[0], plane[1], plane[2], plane[3]));
 		if (newCompound) {
@@ -2698,8 +2980,8 @@ void NewtonFracturedCompoundSetCallbacks (const NewtonCollision* const fractured
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		compound->SetCallbacks ((dgCollisionCompoundFractured::OnEmitFractureChunkCallBack) emitFracfuredChunk, (dgCollisionCompoundFractured::OnEmitNewCompundFractureCallBack) emitFracturedCompound, (dgCollisionCompoundFractured::OnReconstructFractureMainMeshCallBack) regenerateMainMeshCallback);
 	}
 }
@@ -2709,8 +2991,8 @@ int NewtonFracturedCompoundNeighborNodeList (const NewtonCollision* const fractu
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		return  compound->GetFirstNiegborghArray ((dgCollisionCompound::dgTreeArray::dgTreeNode*)collisionNode, (dgCollisionCompound::dgTreeArray::dgTreeNode**) nodesArray, maxCount);
 	}
 	return 0;
@@ -2723,21 +3005,46 @@ int NewtonFracturedCompoundIsNodeFreeToDetach (const NewtonCollision* const frac
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		return compound->IsNodeSaseToDetach((dgCollisionCompound::dgTreeArray::dgTreeNode*)collisionNode) ? 1 : 0;
 	}
 	return 0;
 }
 
+/*!
+  Detach a batch of chunks from the fractured compound of a body.
+
+  @param *fracturedBody body using a fractured compound collision.
+  @param **collisionNodes array of compound nodes to detach.
+  @param count number of nodes in the array.
+
+  @return number of chunks detached.
+
+  Each chunk becomes a dynamic body sharing the baked convex hull of its node, and chunks left disconnected 
+  from the main structure are detached too. The compound tree, the main mesh and the mass of the body are 
+  rebuilt once for the whole batch. Must not be called during a world update.
+*/
+int NewtonFracturedCompoundDetachNodes (const NewtonBody* const fracturedBody, void** const collisionNodes, int count)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgBody* const body = (dgBody*) fracturedBody;
+	dgCollisionInstance* const collision = body->GetCollision();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
+		return compound->DetachChunks (body, (dgCollisionCompound::dgTreeArray::dgTreeNode**) collisionNodes, count);
+	}
+	return 0;
+}
+
 NewtonFracturedCompoundMeshPart* NewtonFracturedCompoundGetFirstSubMesh(const NewtonCollision* const fracturedCompound)
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	NewtonFracturedCompoundMeshPart* mesh = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		mesh = (NewtonFracturedCompoundMeshPart*) compound->GetFirstMesh();
 	}
 	return mesh;
@@ -2749,8 +3056,8 @@ NewtonFracturedCompoundMeshPart* NewtonFracturedCompoundGetNextSubMesh(const New
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	NewtonFracturedCompoundMeshPart* mesh = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		mesh = (NewtonFracturedCompoundMeshPart*) compound->GetNextMesh((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) subMesh);
 	}
 	return mesh;
@@ -2762,8 +3069,8 @@ NewtonFracturedCompoundMeshPart* NewtonFracturedCompoundGetMainMesh (const Newto
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	NewtonFracturedCompoundMeshPart* mesh = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		mesh = (NewtonFracturedCompoundMeshPart*) compound->GetMainMesh();
 	}
 	return mesh;
@@ -2776,8 +3083,8 @@ int NewtonFracturedCompoundCollisionGetVertexCount (const NewtonCollision* const
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	dgInt32 count = 0;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		count = compound->GetVertecCount((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) meshOwner);
 	}
 	return count;
@@ -2790,8 +3097,8 @@ const dFloat* NewtonFracturedCompoundCollisionGetVertexPositions (const NewtonCo
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	const dgFloat32* points = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		points = compound->GetVertexPositions((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) meshOwner);
 	}
 	return points;
@@ -2804,8 +3111,8 @@ const dFloat* NewtonFracturedCompoundCollisionGetVertexNormals (const NewtonColl
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	const dgFloat32* points = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		points = compound->GetVertexNormal((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) meshOwner);
 	}
 	return points;
@@ -2817,8 +3124,8 @@ const dFloat* NewtonFracturedCompoundCollisionGetVertexUVs (const NewtonCollisio
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
 
 	const dgFloat32* points = NULL;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
-		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetChildShape();
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision->GetLodShape(0);
 		points = compound->GetVertexUVs((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) meshOwner);
 	}
 	return points;
@@ -2830,7 +3137,7 @@ int NewtonFracturedCompoundMeshPartGetIndexStream (const NewtonCollision* const
 
 	dgInt32 count = 0;
 	dgCollisionInstance* const collision = (dgCollisionInstance*) fracturedCompound;
-	if (collision->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
+	if (collision->GetLodShape(0)->IsType (dgCollision::dgCollisionCompoundBreakable_RTTI)) {
 		dgCollisionCompoundFractured* const compound = (dgCollisionCompoundFractured*) collision;
 		count = compound->GetSegmentIndexStream ((dgCollisionCompoundFractured::dgConectivityGraph::dgListNode*) meshOwner, (dgCollisionCompoundFractured::dgMesh::dgListNode*) segment, index);
 	}
@@ -3184,6 +3491,58 @@ NewtonCollision* NewtonCreateTreeCollisionFromMesh (const NewtonWorld* const new
 }
 
 
+/*!
+  Create a collision tree that uses a tree image in place.
+
+  @param *newtonWorld is the pointer to the Newton world.
+  @param *image pointer to an image written by *NewtonTreeCollisionSerializeImage*, usually a memory mapped file. It must be 16 bytes aligned.
+  @param sizeInBytes size of the image.
+  @param shapeID collision shape ID.
+
+  @return Pointer to the collision tree, or NULL if the image is not valid.
+
+  The image is not copied, the application must keep it alive until the collision is destroyed.
+  The image is only read, unless the application changes face attributes with *NewtonTreeCollisionSetFaceAttribute*.
+
+  See also: ::NewtonTreeCollisionSerializeImage, ::NewtonTreeCollisionGetImageSize
+*/
+NewtonCollision* NewtonCreateTreeCollisionFromImage (const NewtonWorld* const newtonWorld, const void* const image, int sizeInBytes, int shapeID)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	dgCollisionInstance* const collision =  world->CreateBVHFromImage (image, sizeInBytes);
+	if (collision) {
+		collision->SetUserDataID(dgUnsigned32 (shapeID));
+	}
+	return (NewtonCollision*) collision;
+}
+
+int NewtonTreeCollisionGetImageSize (const NewtonCollision* const treeCollision)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionBVH* const collision = (dgCollisionBVH*) ((dgCollisionInstance*)treeCollision)->GetChildShape();
+	dgAssert (collision->IsType (dgCollision::dgCollisionBVH_RTTI));
+	return collision->GetImageSize();
+}
+
+/*!
+  Write a relocatable image of a collision tree, it can be saved to a file and later loaded with *NewtonCreateTreeCollisionFromImage*.
+
+  @param *treeCollision is the pointer to the collision tree.
+  @param serializeFunction function called to write the image.
+  @param *serializeHandle user data passed to the serialize function.
+
+  The image is in native byte order and floating point format.
+*/
+void NewtonTreeCollisionSerializeImage (const NewtonCollision* const treeCollision, NewtonSerializeCallback serializeFunction, void* const serializeHandle)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionBVH* const collision = (dgCollisionBVH*) ((dgCollisionInstance*)treeCollision)->GetChildShape();
+	dgAssert (collision->IsType (dgCollision::dgCollisionBVH_RTTI));
+	collision->SerializeImage ((dgSerialize) serializeFunction, serializeHandle);
+}
+
+
 /*!
   set a function call back to be call during the face query of a collision tree.
 
@@ -3318,9 +3677,39 @@ void NewtonTreeCollisionAddFace(const NewtonCollision* const treeCollision, int
 void NewtonTreeCollisionEndBuild(const NewtonCollision* const treeCollision, int optimize)
 {
 	TRACE_FUNCTION(__FUNCTION__);
-	dgCollisionBVH* const collision = (dgCollisionBVH*) ((dgCollisionInstance*)treeCollision)->GetChildShape();
+	dgCollisionInstance* const instance = (dgCollisionInstance*)treeCollision;
+	dgCollisionBVH* const collision = (dgCollisionBVH*) instance->GetChildShape();
 	dgAssert (collision->IsType (dgCollision::dgCollisionBVH_RTTI));
 	collision->EndBuild(optimize);
+	((dgWorld*) instance->GetWorld())->ShareCollisionShape (instance);
+}
+
+/*!
+  Finalize the construction of the polygonal mesh using the world worker threads.
+
+  @param *newtonWorld is the pointer to the Newton world.
+  @param *treeCollision is the pointer to the collision tree.
+  @param optimize flag that indicates to Newton whether it should optimize this mesh, same as *NewtonTreeCollisionEndBuild*.
+  @param buildQuality one of NEWTON_TREE_BUILD_FAST, NEWTON_TREE_BUILD_DEFAULT or NEWTON_TREE_BUILD_BEST_SAH.
+
+  @return Nothing.
+
+  The face optimization and the lower levels of the tree are built in parallel, the result is the same runtime format of *NewtonTreeCollisionEndBuild*.
+  NEWTON_TREE_BUILD_DEFAULT builds the same tree as *NewtonTreeCollisionEndBuild*, NEWTON_TREE_BUILD_FAST skips the tree rotation passes
+  and NEWTON_TREE_BUILD_BEST_SAH splits the nodes with a binned surface area heuristic.
+  This function can not be called while the world is updating.
+
+  See also: ::NewtonTreeCollisionEndBuild
+*/
+void NewtonTreeCollisionEndBuildParallel (const NewtonWorld* const newtonWorld, const NewtonCollision* const treeCollision, int optimize, int buildQuality)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	dgCollisionInstance* const instance = (dgCollisionInstance*)treeCollision;
+	dgCollisionBVH* const collision = (dgCollisionBVH*) instance->GetChildShape();
+	dgAssert (collision->IsType (dgCollision::dgCollisionBVH_RTTI));
+	collision->EndBuild(optimize, world, dgClamp (buildQuality, dgInt32 (dgAABBPolygonSoup::m_buildFast), dgInt32 (dgAABBPolygonSoup::m_buildBestSah)));
+	world->ShareCollisionShape (instance);
 }
 
 
@@ -3472,6 +3861,79 @@ int NewtonTreeCollisionGetVertexListTriangleListInAABB(const NewtonCollision* co
 
 
 
+/*!
+  Create a height field collision geometry whose elevation is streamed in pages.
+
+  @param *newtonWorld Pointer to the Newton world.
+  @param minElevation, maxElevation conservative elevation range of the whole field, before vertical scale.
+  @param pageProvider callback that fills a page of elevation and attribute samples.
+  @param memoryBudgetInBytes maximum memory used by resident pages.
+
+  Each paged height field owns a loader thread. Contact queries queue the pages around the box of the 
+  colliding body to that thread, so the provider is usually called ahead of time and off the solver threads.
+  The provider may therefore be called from the loader thread, a solver thread or the thread calling 
+  *NewtonHeightFieldUpdatePageResidency*, but never for the same page concurrently.
+  A page a query needs that is still missing is loaded on the calling thread while the budget allows;
+  otherwise the cells collide as a flat patch at their lowest elevation. Pages are only evicted in
+  *NewtonHeightFieldUpdatePageResidency*, which must be called outside *NewtonUpdate* and collision queries, 
+  but may overlap *NewtonHeightFieldPrefetchPages* and the loader thread.
+  *NewtonCollisionGetInfo* reports NULL elevation and attribute maps for a paged height field.
+
+  @return Pointer to the collision.
+*/
+NewtonCollision* NewtonCreatePagedHeightFieldCollision (const NewtonWorld* const newtonWorld, int width, int height, int gridsDiagonals, int elevationdatType, 
+														dFloat minElevation, dFloat maxElevation, dFloat verticalScale, dFloat horizontalScale_x, dFloat horizontalScale_z, 
+														NewtonHeightFieldPageProvider pageProvider, void* const providerUserData, int memoryBudgetInBytes, int shapeID)
+{
+	Newton* const world = (Newton *)newtonWorld;
+
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const collision = world->CreatePagedHeightField(width, height, gridsDiagonals, elevationdatType, minElevation, maxElevation, verticalScale, horizontalScale_x, horizontalScale_z, 
+																		 (dgCollisionHeightFieldPageProvider) pageProvider, providerUserData, memoryBudgetInBytes);
+	collision->SetUserDataID(dgUnsigned32 (shapeID));
+	return (NewtonCollision*) collision;
+}
+
+/*!
+  Queue the pages of a paged height field overlapping a box in local space to the shape loader thread.
+  It returns immediately, and can be used to prefetch pages ahead of bodies the contact queries have not reached yet.
+*/
+void NewtonHeightFieldPrefetchPages (const NewtonCollision* const heightField, const dFloat* const p0, const dFloat* const p1)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const collision = (dgCollisionInstance*)heightField;
+	if (collision->IsType (dgCollision::dgCollisionHeightField_RTTI)) {
+		dgCollisionHeightField* const shape = (dgCollisionHeightField*) collision->GetChildShape();
+		shape->PrefetchPages (dgVector (p0[0], p0[1], p0[2], dgFloat32 (0.0f)), dgVector (p1[0], p1[1], p1[2], dgFloat32 (0.0f)));
+	}
+}
+
+void NewtonHeightFieldUpdatePageResidency (const NewtonCollision* const heightField)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const collision = (dgCollisionInstance*)heightField;
+	if (collision->IsType (dgCollision::dgCollisionHeightField_RTTI)) {
+		dgCollisionHeightField* const shape = (dgCollisionHeightField*) collision->GetChildShape();
+		shape->UpdatePageResidency ();
+	}
+}
+
+void NewtonHeightFieldGetPageStats (const NewtonCollision* const heightField, int* const residentPages, int* const requestedPages, int* const memoryUsed, int* const fallbackCells)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const collision = (dgCollisionInstance*)heightField;
+	dgCollisionHeightField::dgPageStats stats;
+	memset (&stats, 0, sizeof (stats));
+	if (collision->IsType (dgCollision::dgCollisionHeightField_RTTI)) {
+		dgCollisionHeightField* const shape = (dgCollisionHeightField*) collision->GetChildShape();
+		shape->GetPageStats (stats);
+	}
+	*residentPages = stats.m_residentPages;
+	*requestedPages = stats.m_requestedPages;
+	*memoryUsed = stats.m_memoryUsed;
+	*fallbackCells = stats.m_fallbackCells;
+}
+
 /*!
   Create a height field collision geometry.
 
@@ -3543,8 +4005,8 @@ void NewtonSceneCollisionRemoveSubCollisionByIndex (NewtonCollision* const scene
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) sceneCollision;
-	if (instance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
-		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetChildShape();
+	if (instance->GetLodShape(0)->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgCollisionCompound* const collision = (dgCollisionCompound*) instance->GetLodShape(0);
 		NewtonSceneCollisionRemoveSubCollision (sceneCollision, collision->FindNodeByIndex(nodeIndex));
 	}
 }
@@ -3917,14 +4379,14 @@ int NewtonCollisionGetType(const NewtonCollision* const collision)
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*) collision;
-	return instance->GetCollisionPrimityType();
+	return instance->GetLodShape(0)->GetCollisionPrimityType();
 }
 
 int NewtonCollisionIsConvexShape(const NewtonCollision* const collision)
 {
 	TRACE_FUNCTION(__FUNCTION__);
 	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
-	return instance->IsType (dgCollision::dgCollisionConvexShape_RTTI) ? 1 : 0;
+	return instance->GetLodShape(0)->IsType (dgCollision::dgCollisionConvexShape_RTTI) ? 1 : 0;
 }
 
 int NewtonCollisionIsStaticShape (const NewtonCollision* const collision)
@@ -3934,6 +4396,47 @@ int NewtonCollisionIsStaticShape (const NewtonCollision* const collision)
 	return (instance->IsType(dgCollision::dgCollisionMesh_RTTI) || instance->IsType(dgCollision::dgCollisionScene_RTTI)) ? 1 : 0;
 }
 
+// build a simplified proxy of the full detail shape and append it as the next level.
+// only convex and compound shapes are supported, return the new level or -1 on failure.
+// editing a compound with NewtonCompoundCollisionEndAddRemove or detaching fractured chunks drops all proxies.
+int NewtonCollisionAddLod (const NewtonWorld* const newtonWorld, const NewtonCollision* const collision, int lodType, int maxVertexCount)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *) newtonWorld;
+	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
+	dgCollisionInstance::dgLodType type = (lodType == NEWTON_COLLISION_LOD_BOUNDING_BOX) ? dgCollisionInstance::m_lodBoundingBox : dgCollisionInstance::m_lodConvexHull;
+	return world->CreateCollisionLod(instance, type, maxVertexCount);
+}
+
+void NewtonCollisionRemoveLods (const NewtonCollision* const collision)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
+	instance->RemoveLodShapes();
+}
+
+int NewtonCollisionGetLodCount (const NewtonCollision* const collision)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
+	return instance->GetLodCount();
+}
+
+int NewtonCollisionGetActiveLod (const NewtonCollision* const collision)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
+	return instance->GetActiveLod();
+}
+
+// changing the level of a collision attached to a body only takes effect on the body bounding box on its next update
+void NewtonCollisionSetActiveLod (const NewtonCollision* const collision, int lod)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgCollisionInstance* const instance = (dgCollisionInstance*)collision;
+	instance->SetActiveLod(lod);
+}
+
 /*!
   Store a user defined value with a convex collision primitive.
 
@@ -4156,6 +4659,9 @@ NewtonCollision* NewtonCreateCollisionFromSerialization(const NewtonWorld* const
 
   This function can be used by the application for writing file format and for serialization.
 
+  For a height field created with *NewtonCreatePagedHeightFieldCollision* the elevation and attribute 
+  pointers are NULL, the samples only exist in the resident pages.
+
   See also: ::NewtonCollisionGetInfo, ::NewtonCollisionSerialize
 */
 void NewtonCollisionGetInfo(const NewtonCollision* const collision, NewtonCollisionInfoRecord* const collisionInfo)
@@ -5329,6 +5835,26 @@ void NewtonInverseDynamicsUpdate (NewtonInverseDynamics* const inverseDynamics,
 	ik->Update(timestep, threadIndex);
 }
 
+/*!
+  Update every inverse dynamics rig of the world in one batch.
+
+  @param *newtonWorld Pointer to the Newton world.
+  @param timestep time step used to calculate the joint accelerations.
+
+  The rigs are distributed over the worker threads of the world, each rig is solved by one thread
+  exactly as ::NewtonInverseDynamicsUpdate would. Rigs must not share joints.
+
+  This function must be called outside of a Newton Update, typically before calling NewtonUpdate.
+
+  See also: ::NewtonInverseDynamicsUpdate
+*/
+void NewtonWorldUpdateInverseDynamics (const NewtonWorld* const newtonWorld, dFloat timestep)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	world->UpdateInverseDynamics(timestep);
+}
+
 void* NewtonInverseDynamicsGetRoot(NewtonInverseDynamics* const inverseDynamics)
 {
 	TRACE_FUNCTION(__FUNCTION__);
@@ -5829,6 +6355,60 @@ void NewtonBodySetGyroscopicTorque(const NewtonBody* const bodyPtr, int state)
 	body->SetGyroMode(state ? true : false);
 }
 
+int NewtonBodyGetSkeletonSolverMode(const NewtonBody* const bodyPtr)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgBody* const body = (dgBody *)bodyPtr;
+	return body->IsRTTIType(dgBody::m_dynamicBodyRTTI) ? ((dgDynamicBody*)body)->GetSkeletonSolverMode() : NEWTON_SKELETON_SOLVER_TREE;
+}
+
+/*!
+  Select the algorithm used to solve the skeleton this body belongs to.
+
+  @param *bodyPtr is the pointer to the body.
+  @param mode NEWTON_SKELETON_SOLVER_TREE (default) or NEWTON_SKELETON_SOLVER_SPARSE.
+
+  A skeleton uses the sparse solver if any of its bodies request it. The sparse mode factors all the 
+  unbounded rows of the skeleton, including loop joints, with a supernodal Cholesky factorization in a 
+  fill reducing order. It is intended for mechanisms with many kinematic loops, trusses or tracks, 
+  skeletons without loops or bounded rows are always solved with the tree solver.
+*/
+void NewtonBodySetSkeletonSolverMode(const NewtonBody* const bodyPtr, int mode)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgBody* const body = (dgBody *)bodyPtr;
+	if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+		((dgDynamicBody*)body)->SetSkeletonSolverMode((mode == NEWTON_SKELETON_SOLVER_SPARSE) ? dgSkeletonContainer::m_sparse : dgSkeletonContainer::m_tree);
+	}
+}
+
+/*!
+  Get how many times the skeleton this body belongs to reused the symbolic structure of its loop matrix.
+
+  @param *bodyPtr is the pointer to the body.
+  @param *reuseCount number of steps that skipped building the coupling pattern of the loop rows.
+  @param *buildCount number of steps that had to build it.
+
+  The pattern is rebuilt when the rows or the body pairs of the loop and bounded rows change, 
+  skeletons without loops or bounded rows do not have one. Both counters are zero for bodies 
+  that are not part of a skeleton.
+*/
+void NewtonBodyGetSkeletonFactorizationStats(const NewtonBody* const bodyPtr, int* const reuseCount, int* const buildCount)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	dgBody* const body = (dgBody *)bodyPtr;
+	dgInt32 reuse = 0;
+	dgInt32 build = 0;
+	if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+		const dgSkeletonContainer* const skeleton = ((dgDynamicBody*)body)->GetSkeleton();
+		if (skeleton) {
+			skeleton->GetFactorizationStats(reuse, build);
+		}
+	}
+	*reuseCount = reuse;
+	*buildCount = build;
+}
+
 /*!
   Set the auto-activation mode for this body.
 
@@ -7228,6 +7808,49 @@ void NewtonUserJointAddLinearRow(const NewtonJoint* const joint, const dFloat* c
 	userJoint->AddLinearRowJacobian (pivotPoint0, pivotPoint1, direction);
 }
 
+/*!
+  Add up to three linear restricted degrees of freedom sharing the same pair of attachment points.
+
+  @param *joint pointer to the joint.
+  @param rowMask bit 0, 1 and 2 select the front, up and right directions of the matrix.
+  @param  *pivot0 - pointer of a vector in global space fixed on body zero.
+  @param  *pivot1 - pointer of a vector in global space fixed on body one.
+  @param *matrix pointer to a 4x4 matrix in global space, its first three rows are the unit directions of the rows.
+  @param stiffness row stiffness applied to all the new rows, see ::NewtonUserJointSetRowStiffness.
+
+  The result is the same than calling ::NewtonUserJointAddLinearRow followed by ::NewtonUserJointSetRowStiffness 
+  once for each selected direction, but the rows are calculated together, which is considerably cheaper for 
+  joints with many point to point rows like ropes, chains and ragdolls.
+
+  After this function is called the internal DOF index points to the last of the new rows. 
+
+  This function call only be called from inside a *NewtonUserBilateralCallback* callback.
+
+  @return the number of rows added.
+
+  See also: ::NewtonUserJointAddLinearRow
+*/
+int NewtonUserJointAddLinearRows(const NewtonJoint* const joint, int rowMask, const dFloat* const pivot0, const dFloat* const pivot1, const dFloat* const matrix, dFloat stiffness)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	NewtonUserJoint* const userJoint = (NewtonUserJoint*) joint;
+	rowMask &= 0x07;
+	if (!rowMask) {
+		return 0;
+	}
+	dgMatrix dirMatrix (matrix);
+	for (dgInt32 i = 0; i < 3; i ++) {
+		dirMatrix[i] = dirMatrix[i] & dgVector::m_triplexMask;
+		if (rowMask & (1 << i)) {
+			dirMatrix[i] = dirMatrix[i].Normalize();
+			dgAssert (dgAbs (dirMatrix[i].DotProduct(dirMatrix[i]).GetScalar() - dgFloat32 (1.0f)) < dgFloat32 (1.0e-4f));
+		}
+	}
+	dgVector pivotPoint0 (pivot0[0], pivot0[1], pivot0[2], dgFloat32 (0.0f)); 
+	dgVector pivotPoint1 (pivot1[0], pivot1[1], pivot1[2], dgFloat32 (0.0f)); 
+	return userJoint->AddLinearRowsJacobian (rowMask, pivotPoint0, pivotPoint1, dirMatrix, stiffness);
+}
+
 
 /*!
   Add an angular restricted degree of freedom.
@@ -7975,6 +8598,15 @@ NewtonMesh* NewtonMeshApproximateConvexDecomposition (const NewtonMesh* const me
 	return (NewtonMesh*) ((dgMeshEffect*) mesh)->CreateConvexApproximation (maxConcavity, backFaceDistanceFactor, maxCount, maxVertexPerHull, (dgReportProgress) progressReportCallback, reportProgressUserData);
 }
 
+// the decomposition runs on the world worker threads, newtonWorld can be NULL for a serial build.
+// it must not be called while the world is updating.
+NewtonMesh* NewtonMeshVoxelConvexDecomposition (const NewtonWorld* const newtonWorld, const NewtonMesh* const mesh, int voxelResolution, dFloat maxConcavity, int maxCount, int maxVertexPerHull, NewtonReportProgress progressReportCallback, void* const reportProgressUserData)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	return (NewtonMesh*) ((dgMeshEffect*) mesh)->CreateVoxelConvexApproximation (world, voxelResolution, maxConcavity, maxCount, maxVertexPerHull, (dgReportProgress) progressReportCallback, reportProgressUserData);
+}
+
 
 
 NewtonMesh* NewtonMeshUnion (const NewtonMesh* const mesh, const NewtonMesh* const clipper, const dFloat* const clipperMatrix)
@@ -8002,6 +8634,15 @@ NewtonMesh* NewtonMeshConvexMeshIntersection (const NewtonMesh* const mesh, cons
 	return (NewtonMesh*) ((dgMeshEffect*) mesh)->ConvexMeshIntersection ((dgMeshEffect*)convexMesh);
 }
 
+// intersect the mesh with each convex cell on the world worker threads, cells that miss the mesh return NULL.
+// newtonWorld can be NULL for a serial batch, it must not be called while the world is updating.
+void NewtonMeshBatchConvexMeshIntersection (const NewtonWorld* const newtonWorld, const NewtonMesh* const mesh, int convexMeshCount, const NewtonMesh* const* const convexMeshArray, NewtonMesh** const outputArray)
+{
+	TRACE_FUNCTION(__FUNCTION__);
+	Newton* const world = (Newton *)newtonWorld;
+	((dgMeshEffect*) mesh)->ConvexMeshIntersection (world, convexMeshCount, (const dgMeshEffect* const*) convexMeshArray, (dgMeshEffect**) outputArray);
+}
+
 void NewtonRemoveUnusedVertices(const NewtonMesh* const mesh, int* const vertexRemapTable)
 {
 	TRACE_FUNCTION(__FUNCTION__);
@@ -78,6 +78,16 @@ extern "C" {
 	#define NEWTON_DYNAMIC_ASYMETRIC_BODY					2
 //	#define NEWTON_DEFORMABLE_BODY							2
 
+	#define NEWTON_TREE_BUILD_FAST							0
+	#define NEWTON_TREE_BUILD_DEFAULT						1
+	#define NEWTON_TREE_BUILD_BEST_SAH						2
+
+	#define NEWTON_COLLISION_LOD_CONVEX_HULL				0
+	#define NEWTON_COLLISION_LOD_BOUNDING_BOX				1
+
+	#define NEWTON_SKELETON_SOLVER_TREE						0
+	#define NEWTON_SKELETON_SOLVER_SPARSE					1
+
 	#define SERIALIZE_ID_SPHERE								0
 	#define SERIALIZE_ID_CAPSULE							1
 	#define SERIALIZE_ID_CYLINDER							2
@@ -404,9 +414,11 @@ extern "C" {
 
 	typedef dFloat (*NewtonCollisionTreeRayCastCallback) (const NewtonBody* const body, const NewtonCollision* const treeCollision, dFloat intersection, dFloat* const normal, int faceId, void* const usedData);
 	typedef dFloat (*NewtonHeightFieldRayCastCallback) (const NewtonBody* const body, const NewtonCollision* const heightFieldCollision, dFloat intersection, int row, int col, dFloat* const normal, int faceId, void* const usedData);
+	typedef void (*NewtonHeightFieldPageProvider) (void* const userData, int x0, int z0, int width, int height, void* const elevation, char* const attributes);
 
 	typedef void (*NewtonCollisionCopyConstructionCallback) (const NewtonWorld* const newtonWorld, NewtonCollision* const collision, const NewtonCollision* const sourceCollision);
 	typedef void (*NewtonCollisionDestructorCallback) (const NewtonWorld* const newtonWorld, const NewtonCollision* const collision);
+	typedef int (*NewtonCollisionLodCallback) (const NewtonBody* const body, const NewtonCollision* const collision, int lodCount, int threadIndex);
 
 	// collision tree call back (obsoleted no recommended)
 	typedef void (*NewtonTreeCollisionCallback) (const NewtonBody* const bodyWithTreeCollision, const NewtonBody* const body, int faceID, 
@@ -481,10 +493,19 @@ extern "C" {
 	NEWTON_API dFloat NewtonGetContactMergeTolerance (const NewtonWorld* const newtonWorld);
 	NEWTON_API void NewtonSetContactMergeTolerance (const NewtonWorld* const newtonWorld, dFloat tolerance);
 
+	NEWTON_API int NewtonWorldGetSharedShapeCache (const NewtonWorld* const newtonWorld);
+	NEWTON_API void NewtonWorldSetSharedShapeCache (const NewtonWorld* const newtonWorld, int state);
+	NEWTON_API void NewtonGetSharedShapeCacheInfo (int* const shapeCount, int* const instanceCount, int* const hitCount, int* const missCount, int* const memoryUsed);
+
 	NEWTON_API void NewtonInvalidateCache (const NewtonWorld* const newtonWorld);
+	NEWTON_API void NewtonWorldShiftOrigin (const NewtonWorld* const newtonWorld, const dFloat* const offset);
 
 	NEWTON_API void NewtonSetSolverIterations (const NewtonWorld* const newtonWorld, int model);
 	NEWTON_API int NewtonGetSolverIterations(const NewtonWorld* const newtonWorld);
+	NEWTON_API void NewtonSetSolverMaxIterations (const NewtonWorld* const newtonWorld, int maxIterations);
+	NEWTON_API int NewtonGetSolverMaxIterations (const NewtonWorld* const newtonWorld);
+	NEWTON_API int NewtonWorldGetSolverIslandCount (const NewtonWorld* const newtonWorld);
+	NEWTON_API int NewtonWorldGetSolverIslandStats (const NewtonWorld* const newtonWorld, int islandIndex, int* const bodyCount, int* const jointCount, int* const passes, dFloat* const residual);
 
 	NEWTON_API void NewtonSetParallelSolverOnLargeIsland (const NewtonWorld* const newtonWorld, int mode);
 	NEWTON_API int NewtonGetParallelSolverOnLargeIsland (const NewtonWorld* const newtonWorld);
@@ -499,8 +520,14 @@ extern "C" {
 
 	NEWTON_API int NewtonGetNumberOfSubsteps (const NewtonWorld* const newtonWorld);
 	NEWTON_API void NewtonSetNumberOfSubsteps (const NewtonWorld* const newtonWorld, int subSteps);
+	NEWTON_API int NewtonGetLightweightSubsteps (const NewtonWorld* const newtonWorld);
+	NEWTON_API void NewtonSetLightweightSubsteps (const NewtonWorld* const newtonWorld, int state);
 	NEWTON_API dFloat NewtonGetLastUpdateTime (const NewtonWorld* const newtonWorld);
 
+	NEWTON_API int NewtonGetMeshQueryScratchHighWaterMark (const NewtonWorld* const newtonWorld);
+	NEWTON_API int NewtonGetMeshQueryScratchMemoryUsed (const NewtonWorld* const newtonWorld);
+	NEWTON_API void NewtonReserveMeshQueryScratch (const NewtonWorld* const newtonWorld, int vertexCount);
+
 	NEWTON_API void NewtonSerializeToFile (const NewtonWorld* const newtonWorld, const char* const filename, NewtonOnBodySerializationCallback bodyCallback, void* const bodyUserData);
 	NEWTON_API void NewtonDeserializeFromFile (const NewtonWorld* const newtonWorld, const char* const filename, NewtonOnBodyDeserializationCallback bodyCallback, void* const bodyUserData);
 
@@ -550,6 +577,7 @@ extern "C" {
 	NEWTON_API void NewtonWorldSetDestructorCallback (const NewtonWorld* const newtonWorld, NewtonWorldDestructorCallback destructor);
 	NEWTON_API NewtonWorldDestructorCallback NewtonWorldGetDestructorCallback (const NewtonWorld* const newtonWorld);
 	NEWTON_API void NewtonWorldSetCollisionConstructorDestructorCallback (const NewtonWorld* const newtonWorld, NewtonCollisionCopyConstructionCallback constructor, NewtonCollisionDestructorCallback destructor);
+	NEWTON_API void NewtonWorldSetCollisionLodCallback (const NewtonWorld* const newtonWorld, NewtonCollisionLodCallback callback);
 
 	NEWTON_API void NewtonWorldSetCreateDestroyContactCallback(const NewtonWorld* const newtonWorld, NewtonCreateContactCallback createContact, NewtonDestroyContactCallback destroyContact);
 
@@ -706,6 +734,7 @@ extern "C" {
 
 	NEWTON_API int NewtonFracturedCompoundIsNodeFreeToDetach (const NewtonCollision* const fracturedCompound, void* const collisionNode);
 	NEWTON_API int NewtonFracturedCompoundNeighborNodeList (const NewtonCollision* const fracturedCompound, void* const collisionNode, void** const list, int maxCount);
+	NEWTON_API int NewtonFracturedCompoundDetachNodes (const NewtonBody* const fracturedBody, void** const collisionNodes, int count);
 
 	
 	NEWTON_API NewtonFracturedCompoundMeshPart* NewtonFracturedCompoundGetMainMesh (const NewtonCollision* const fracturedCompound);
@@ -775,14 +804,22 @@ extern "C" {
 	// **********************************************************************************************
 	NEWTON_API NewtonCollision* NewtonCreateHeightFieldCollision (const NewtonWorld* const newtonWorld, int width, int height, int gridsDiagonals, int elevationdatType, const void* const elevationMap, const char* const attributeMap, dFloat verticalScale, dFloat horizontalScale_x, dFloat horizontalScale_z, int shapeID);
 	NEWTON_API void NewtonHeightFieldSetUserRayCastCallback (const NewtonCollision* const heightfieldCollision, NewtonHeightFieldRayCastCallback rayHitCallback);
+	NEWTON_API NewtonCollision* NewtonCreatePagedHeightFieldCollision (const NewtonWorld* const newtonWorld, int width, int height, int gridsDiagonals, int elevationdatType, dFloat minElevation, dFloat maxElevation, dFloat verticalScale, dFloat horizontalScale_x, dFloat horizontalScale_z, NewtonHeightFieldPageProvider pageProvider, void* const providerUserData, int memoryBudgetInBytes, int shapeID);
+	NEWTON_API void NewtonHeightFieldPrefetchPages (const NewtonCollision* const heightfieldCollision, const dFloat* const p0, const dFloat* const p1);
+	NEWTON_API void NewtonHeightFieldUpdatePageResidency (const NewtonCollision* const heightfieldCollision);
+	NEWTON_API void NewtonHeightFieldGetPageStats (const NewtonCollision* const heightfieldCollision, int* const residentPages, int* const requestedPages, int* const memoryUsed, int* const fallbackCells);
 
 	NEWTON_API NewtonCollision* NewtonCreateTreeCollision (const NewtonWorld* const newtonWorld, int shapeID);
 	NEWTON_API NewtonCollision* NewtonCreateTreeCollisionFromMesh (const NewtonWorld* const newtonWorld, const NewtonMesh* const mesh, int shapeID);
+	NEWTON_API NewtonCollision* NewtonCreateTreeCollisionFromImage (const NewtonWorld* const newtonWorld, const void* const image, int sizeInBytes, int shapeID);
+	NEWTON_API int NewtonTreeCollisionGetImageSize (const NewtonCollision* const treeCollision);
+	NEWTON_API void NewtonTreeCollisionSerializeImage (const NewtonCollision* const treeCollision, NewtonSerializeCallback serializeFunction, void* const serializeHandle);
 	NEWTON_API void NewtonTreeCollisionSetUserRayCastCallback (const NewtonCollision* const treeCollision, NewtonCollisionTreeRayCastCallback rayHitCallback);
 
 	NEWTON_API void NewtonTreeCollisionBeginBuild (const NewtonCollision* const treeCollision);
 	NEWTON_API void NewtonTreeCollisionAddFace (const NewtonCollision* const treeCollision, int vertexCount, const dFloat* const vertexPtr, int strideInBytes, int faceAttribute);
 	NEWTON_API void NewtonTreeCollisionEndBuild (const NewtonCollision* const treeCollision, int optimize);
+	NEWTON_API void NewtonTreeCollisionEndBuildParallel (const NewtonWorld* const newtonWorld, const NewtonCollision* const treeCollision, int optimize, int buildQuality);
 
 	NEWTON_API int NewtonTreeCollisionGetFaceAttribute (const NewtonCollision* const treeCollision, const int* const faceIndexArray, int indexCount); 
 	NEWTON_API void NewtonTreeCollisionSetFaceAttribute (const NewtonCollision* const treeCollision, const int* const faceIndexArray, int indexCount, int attribute);
@@ -803,6 +840,13 @@ extern "C" {
 	NEWTON_API int NewtonCollisionIsConvexShape (const NewtonCollision* const collision);
 	NEWTON_API int NewtonCollisionIsStaticShape (const NewtonCollision* const collision);
 
+	// simplified proxy shapes, selected per frame by the world lod callback
+	NEWTON_API int NewtonCollisionAddLod (const NewtonWorld* const newtonWorld, const NewtonCollision* const collision, int lodType, int maxVertexCount);
+	NEWTON_API void NewtonCollisionRemoveLods (const NewtonCollision* const collision);
+	NEWTON_API int NewtonCollisionGetLodCount (const NewtonCollision* const collision);
+	NEWTON_API int NewtonCollisionGetActiveLod (const NewtonCollision* const collision);
+	NEWTON_API void NewtonCollisionSetActiveLod (const NewtonCollision* const collision, int lod);
+
 	// for the end user
 	NEWTON_API void NewtonCollisionSetUserData (const NewtonCollision* const collision, void* const userData);
 	NEWTON_API void* NewtonCollisionGetUserData (const NewtonCollision* const collision);
@@ -938,6 +982,9 @@ extern "C" {
 
 	NEWTON_API int NewtonBodyGetGyroscopicTorque(const NewtonBody* const body);
 	NEWTON_API void NewtonBodySetGyroscopicTorque(const NewtonBody* const body, int state);
+	NEWTON_API int NewtonBodyGetSkeletonSolverMode(const NewtonBody* const body);
+	NEWTON_API void NewtonBodySetSkeletonSolverMode(const NewtonBody* const body, int mode);
+	NEWTON_API void NewtonBodyGetSkeletonFactorizationStats(const NewtonBody* const body, int* const reuseCount, int* const buildCount);
 
 	NEWTON_API void NewtonBodySetDestructorCallback (const NewtonBody* const body, NewtonBodyDestructor callback);
 	NEWTON_API NewtonBodyDestructor NewtonBodyGetDestructorCallback (const NewtonBody* const body);
@@ -1066,6 +1113,7 @@ extern "C" {
 	NEWTON_API void NewtonInverseDynamicsEndBuild (NewtonInverseDynamics* const inverseDynamics);
 
 	NEWTON_API void NewtonInverseDynamicsUpdate (NewtonInverseDynamics* const inverseDynamics, dFloat timestep, int threadIndex);
+	NEWTON_API void NewtonWorldUpdateInverseDynamics (const NewtonWorld* const newtonWorld, dFloat timestep);
 
 	// **********************************************************************************************
 	//
@@ -1198,6 +1246,7 @@ extern "C" {
 	NEWTON_API void NewtonUserJointSetSolverModel(const NewtonJoint* const joint, int model);
 	NEWTON_API void NewtonUserJointSetFeedbackCollectorCallback (const NewtonJoint* const joint, NewtonUserBilateralCallback getFeedback);
 	NEWTON_API void NewtonUserJointAddLinearRow (const NewtonJoint* const joint, const dFloat* const pivot0, const dFloat* const pivot1, const dFloat* const dir);
+	NEWTON_API int NewtonUserJointAddLinearRows (const NewtonJoint* const joint, int rowMask, const dFloat* const pivot0, const dFloat* const pivot1, const dFloat* const matrix, dFloat stiffness);
 	NEWTON_API void NewtonUserJointAddAngularRow (const NewtonJoint* const joint, dFloat relativeAngle, const dFloat* const dir);
 	NEWTON_API void NewtonUserJointAddGeneralRow (const NewtonJoint* const joint, const dFloat* const jacobian0, const dFloat* const jacobian1);
 	NEWTON_API void NewtonUserJointSetRowMinimumFriction (const NewtonJoint* const joint, dFloat friction);
@@ -1261,9 +1310,11 @@ extern "C" {
 	NEWTON_API void NewtonMeshClip (const NewtonMesh* const mesh, const NewtonMesh* const clipper, const dFloat* const clipperMatrix, NewtonMesh** const topMesh, NewtonMesh** const bottomMesh);
 
 	NEWTON_API NewtonMesh* NewtonMeshConvexMeshIntersection (const NewtonMesh* const mesh, const NewtonMesh* const convexMesh);
+	NEWTON_API void NewtonMeshBatchConvexMeshIntersection (const NewtonWorld* const newtonWorld, const NewtonMesh* const mesh, int convexMeshCount, const NewtonMesh* const* const convexMeshArray, NewtonMesh** const outputArray);
 
 	NEWTON_API NewtonMesh* NewtonMeshSimplify (const NewtonMesh* const mesh, int maxVertexCount, NewtonReportProgress reportPrograssCallback, void* const reportPrgressUserData);
 	NEWTON_API NewtonMesh* NewtonMeshApproximateConvexDecomposition (const NewtonMesh* const mesh, dFloat maxConcavity, dFloat backFaceDistanceFactor, int maxCount, int maxVertexPerHull, NewtonReportProgress reportProgressCallback, void* const reportProgressUserData);
+	NEWTON_API NewtonMesh* NewtonMeshVoxelConvexDecomposition (const NewtonWorld* const newtonWorld, const NewtonMesh* const mesh, int voxelResolution, dFloat maxConcavity, int maxCount, int maxVertexPerHull, NewtonReportProgress reportProgressCallback, void* const reportProgressUserData);
 
 	NEWTON_API void NewtonRemoveUnusedVertices(const NewtonMesh* const mesh, int* const vertexRemapTable);
 
@@ -123,6 +123,21 @@ void NewtonUserJoint::AddLinearRowJacobian (const dgVector& pivot0, const dgVect
 	dgAssert (m_rows <= dgInt32 (m_maxDOF));
 }
 
+dgInt32 NewtonUserJoint::AddLinearRowsJacobian (dgInt32 rowMask, const dgVector& pivot0, const dgVector& pivot1, const dgMatrix& dirMatrix, dgFloat32 stiffness)
+{
+	dgPointParam pointData;
+	InitPointParam (pointData, m_stiffness, pivot0, pivot1);
+
+	const dgInt32 count = CalculatePointDerivatives (m_rows, *m_param, dirMatrix, rowMask, pointData, &m_forceArray[m_rows]); 
+	stiffness = dgClamp (stiffness, dgFloat32(0.0f), dgFloat32(1.0f));
+	for (dgInt32 i = 0; i < count; i ++) {
+		m_param->m_jointStiffness[m_rows] = stiffness;
+		m_rows ++;
+	}
+	dgAssert (m_rows <= dgInt32 (m_maxDOF));
+	return count;
+}
+
 void NewtonUserJoint::AddAngularRowJacobian (const dgVector& dir, dgFloat32 relAngle)
 {
 	CalculateAngularDerivative (m_rows, *m_param, dir, m_stiffness, relAngle, &m_forceArray[m_rows]); 
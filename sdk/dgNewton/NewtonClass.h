@@ -57,6 +57,7 @@ class NewtonUserJoint: public dgUserConstraint
 	void AddAngularRowJacobian (const dgVector& dir, dgFloat32 relAngle);
 	void AddGeneralRowJacobian (const dgFloat32* const jacobian0, const dgFloat32* const jacobian1);
 	void AddLinearRowJacobian (const dgVector& pivot0, const dgVector& pivot1, const dgVector& dir);
+	dgInt32 AddLinearRowsJacobian (dgInt32 rowMask, const dgVector& pivot0, const dgVector& pivot1, const dgMatrix& dirMatrix, dgFloat32 stiffness);
 
 	dgInt32 GetJacobianCount () const;
 	void GetJacobianAt (dgInt32 index, dgFloat32* const jacobian0, dgFloat32* const jacobian1) const;
@@ -159,6 +159,80 @@
 		__m256d m_high;
 	} DG_GCC_AVX_ALIGMENT;
 
+	#ifdef DG_SOA_MIXED_PRECISION
+	// jacobian rows are translation invariant, so they are stored in single precision,
+	// the row dot products run 8 wide in single precision and only their sums are widened,
+	// joint forces and accelerations are still accumulated in double
+	DG_MSC_AVX_ALIGMENT
+	class dgSoaRowFloat
+	{
+		public:
+		DG_INLINE dgSoaRowFloat()
+		{
+		}
+
+		DG_INLINE dgSoaRowFloat(const __m256 type)
+			:m_type(type)
+		{
+		}
+
+		DG_INLINE dgSoaRowFloat(const dgSoaFloat& val)
+			:m_type(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(val.m_low)), _mm256_cvtpd_ps(val.m_high), 1))
+		{
+		}
+
+		DG_INLINE operator dgSoaFloat() const
+		{
+			return dgSoaFloat(_mm256_cvtps_pd(_mm256_castps256_ps128(m_type)), _mm256_cvtps_pd(_mm256_extractf128_ps(m_type, 1)));
+		}
+
+		DG_INLINE float& operator[] (dgInt32 i)
+		{
+			dgAssert(i < DG_SOA_WORD_GROUP_SIZE);
+			dgAssert(i >= 0);
+			float* const ptr = (float*)&m_type;
+			return ptr[i];
+		}
+
+		DG_INLINE const float& operator[] (dgInt32 i) const
+		{
+			dgAssert(i < DG_SOA_WORD_GROUP_SIZE);
+			dgAssert(i >= 0);
+			const float* const ptr = (float*)&m_type;
+			return ptr[i];
+		}
+
+		DG_INLINE dgSoaRowFloat operator+ (const dgSoaRowFloat& A) const
+		{
+			return _mm256_add_ps(m_type, A.m_type);
+		}
+
+		DG_INLINE dgSoaRowFloat operator- (const dgSoaRowFloat& A) const
+		{
+			return _mm256_sub_ps(m_type, A.m_type);
+		}
+
+		DG_INLINE dgSoaRowFloat operator* (const dgSoaRowFloat& A) const
+		{
+			return _mm256_mul_ps(m_type, A.m_type);
+		}
+
+		DG_INLINE dgSoaRowFloat MulAdd(const dgSoaRowFloat& A, const dgSoaRowFloat& B) const
+		{
+			return *this + A * B;
+		}
+
+		DG_INLINE dgSoaRowFloat MulSub(const dgSoaRowFloat& A, const dgSoaRowFloat& B) const
+		{
+			return *this - A * B;
+		}
+
+		__m256 m_type;
+	} DG_GCC_AVX_ALIGMENT;
+	#else
+	typedef dgSoaFloat dgSoaRowFloat;
+	#endif
+
 #else 
 
 	DG_MSC_AVX_ALIGMENT
@@ -285,6 +359,8 @@
 
 		__m256 m_type;
 	} DG_GCC_AVX_ALIGMENT;
+
+	typedef dgSoaFloat dgSoaRowFloat;
 #endif
 
 DG_MSC_AVX_ALIGMENT
@@ -305,12 +381,29 @@ class dgSoaVector6
 	dgSoaVector3 m_angular;
 } DG_GCC_AVX_ALIGMENT;
 
+DG_MSC_AVX_ALIGMENT
+class dgSoaRowVector3
+{
+	public:
+	dgSoaRowFloat m_x;
+	dgSoaRowFloat m_y;
+	dgSoaRowFloat m_z;
+} DG_GCC_AVX_ALIGMENT;
+
+DG_MSC_AVX_ALIGMENT
+class dgSoaRowVector6
+{
+	public:
+	dgSoaRowVector3 m_linear;
+	dgSoaRowVector3 m_angular;
+} DG_GCC_AVX_ALIGMENT;
+
 DG_MSC_AVX_ALIGMENT
 class dgSoaJacobianPair
 {
 	public:
-	dgSoaVector6 m_jacobianM0;
-	dgSoaVector6 m_jacobianM1;
+	dgSoaRowVector6 m_jacobianM0;
+	dgSoaRowVector6 m_jacobianM1;
 } DG_GCC_AVX_ALIGMENT;
 
 DG_MSC_AVX_ALIGMENT
@@ -321,12 +414,12 @@ class dgSoaMatrixElement
 	dgSoaJacobianPair m_JMinv;
 
 	dgSoaFloat m_force;
-	dgSoaFloat m_diagDamp;
-	dgSoaFloat m_invJinvMJt;
+	dgSoaRowFloat m_diagDamp;
+	dgSoaRowFloat m_invJinvMJt;
 	dgSoaFloat m_coordenateAccel;
 	dgSoaFloat m_normalForceIndex;
-	dgSoaFloat m_lowerBoundFrictionCoefficent;
-	dgSoaFloat m_upperBoundFrictionCoefficent;
+	dgSoaRowFloat m_lowerBoundFrictionCoefficent;
+	dgSoaRowFloat m_upperBoundFrictionCoefficent;
 } DG_GCC_AVX_ALIGMENT;
 
 DG_MSC_AVX_ALIGMENT
@@ -382,6 +475,7 @@ class dgSolver: public dgParallelBodySolver
 
 	DG_INLINE void SortWorkGroup(dgInt32 base) const;
 	DG_INLINE void TransposeRow (dgSoaMatrixElement* const row, const dgJointInfo* const jointInfoArray, dgInt32 index);
+	DG_INLINE dgSoaFloat CalculateRowAcceleration(const dgSoaMatrixElement* const row, const dgSoaRowVector6& forceM0, const dgSoaRowVector6& forceM1) const;
 	dgFloat32 CalculateJointForce(const dgJointInfo* const jointInfo, dgSoaMatrixElement* const massMatrix, const dgSoaFloat* const internalForces) const;
 	DG_INLINE void BuildJacobianMatrix(dgJointInfo* const jointInfo, dgLeftHandSide* const leftHandSide, dgRightHandSide* const righHandSide, dgJacobian* const internalForces);
 
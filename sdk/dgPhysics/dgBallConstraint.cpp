@@ -238,19 +238,12 @@ dgUnsigned32 dgBallConstraint::JacobianDerivative (dgContraintDescritor& params)
 	dgVector angle (CalculateGlobalMatrixAndAngle (m_localMatrix0, m_localMatrix1, matrix0, matrix1));
 	m_angles = angle.Scale (-dgFloat32 (1.0f));
 
-	const dgVector& dir0 = matrix0.m_front;
-	const dgVector& dir1 = matrix0.m_up;
-	const dgVector& dir2 = matrix0.m_right;
 	const dgVector& p0 = matrix0.m_posit;
 	const dgVector& p1 = matrix1.m_posit;
 
-
 	dgPointParam pointData;
     InitPointParam (pointData, m_stiffness, p0, p1);
-	CalculatePointDerivative (0, params, dir0, pointData, &m_jointForce[0]); 
-	CalculatePointDerivative (1, params, dir1, pointData, &m_jointForce[1]); 
-	CalculatePointDerivative (2, params, dir2, pointData, &m_jointForce[2]); 
-	dgInt32 ret = 3;
+	dgInt32 ret = CalculatePointDerivatives (0, params, matrix0, 0x07, pointData, &m_jointForce[0]); 
 
 	dgAssert (0);
 /*
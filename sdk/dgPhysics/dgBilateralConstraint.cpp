@@ -419,6 +419,86 @@ void dgBilateralConstraint::CalculatePointDerivative (dgInt32 index, dgContraint
 	}
 }
 
+// same rows than CalculatePointDerivative along the front, up and right directions of dirMatrix, 
+// the scalar terms of the three rows are evaluated together one row per lane.
+dgInt32 dgBilateralConstraint::CalculatePointDerivatives (dgInt32 index, dgContraintDescritor& desc, const dgMatrix& dirMatrix, dgInt32 rowMask, const dgPointParam& param, dgForceImpactPair* const jointForce)
+{
+	dgAssert (m_body0);
+	dgAssert (m_body1);
+	dgAssert (rowMask && !(rowMask & ~0x07));
+
+	const dgMatrix dirLanes (dirMatrix.Transpose());
+	const dgVector& r0 = param.m_r0;
+	const dgVector& r1 = param.m_r1;
+	const dgVector& veloc0 = m_body0->m_veloc;
+	const dgVector& veloc1 = m_body1->m_veloc;
+	const dgVector& omega0 = m_body0->m_omega;
+	const dgVector& omega1 = m_body1->m_omega;
+
+	// relative velocity of the two points, projected on each direction
+	const dgVector pointVeloc0 (veloc0 + omega0.CrossProduct(r0));
+	const dgVector pointVeloc1 (veloc1 + omega1.CrossProduct(r1));
+	const dgVector relVeloc (dirLanes.RotateVector(pointVeloc1 - pointVeloc0));
+
+	dgVector relAccel (dgVector::m_zero);
+	dgVector relPosit (dgVector::m_zero);
+	dgVector zeroAccel (dgVector::m_zero);
+	if (desc.m_timestep > dgFloat32 (0.0f)) {
+		const dgVector& gyroAlpha0 = m_body0->m_gyroAlpha;
+		const dgVector& gyroAlpha1 = m_body1->m_gyroAlpha;
+		const dgVector centripetal0 (omega0.CrossProduct(omega0.CrossProduct(r0)));
+		const dgVector centripetal1 (omega1.CrossProduct(omega1.CrossProduct(r1)));
+		const dgVector relGyro (dirLanes.RotateVector(gyroAlpha0.CrossProduct(r0) - gyroAlpha1.CrossProduct(r1)));
+		const dgVector relCentr (dirLanes.RotateVector(centripetal1 - centripetal0));
+		relPosit = dirLanes.RotateVector(param.m_posit1 - param.m_posit0);
+
+		//at =  [- ks (x2 - x1) - kd * (v2 - v1) - dt * ks * (v2 - v1)] / [1 + dt * kd + dt * dt * ks] 
+		const dgFloat32 dt = desc.m_timestep;
+		const dgFloat32 ks = DG_POS_DAMP;
+		const dgFloat32 kd = DG_VEL_DAMP;
+		const dgFloat32 ksd = dt * ks;
+		const dgVector num (relPosit.Scale(ks) + relVeloc.Scale(kd + ksd));
+		const dgVector accelError (num.Scale(dgFloat32 (1.0f) / (dgFloat32 (1.0f) + dt * kd + dt * ksd)));
+
+		relAccel = accelError + relCentr + relGyro;
+		zeroAccel = relVeloc.Scale(desc.m_invTimestep) + relGyro;
+	} else {
+		relAccel = relVeloc;
+	}
+
+	dgInt32 count = 0;
+	for (dgInt32 i = 0; i < 3; i++) {
+		if (rowMask & (1 << i)) {
+			const dgInt32 row = index + count;
+			const dgVector& dir = dirMatrix[i];
+			dgAssert (dir.m_w == dgFloat32 (0.0f));
+
+			dgJacobian &jacobian0 = desc.m_jacobian[row].m_jacobianM0; 
+			jacobian0.m_linear = dir;
+			jacobian0.m_angular = r0.CrossProduct(dir);
+
+			dgJacobian &jacobian1 = desc.m_jacobian[row].m_jacobianM1; 
+			jacobian1.m_linear = dir * dgVector::m_negOne;
+			jacobian1.m_angular = dir.CrossProduct(r1);
+
+			m_r0[row] = r0;
+			m_r1[row] = r1;
+			m_rowIsMotor &= ~(1 << row);
+			m_motorAcceleration[row] = dgFloat32 (0.0f);
+
+			desc.m_penetration[row] = relPosit[i];
+			desc.m_jointStiffness[row] = param.m_stiffness;
+			desc.m_jointAccel[row] = relAccel[i];
+			desc.m_penetrationStiffness[row] = relAccel[i];
+			desc.m_restitution[row] = dgFloat32 (0.0f);
+			desc.m_zeroRowAcceleration[row] = zeroAccel[i];
+			desc.m_forceBounds[row].m_jointForce = &jointForce[count];
+			count ++;
+		}
+	}
+	return count;
+}
+
 void dgBilateralConstraint::JointAccelerations(dgJointAccelerationDecriptor* const params)
 {
 	const dgVector& bodyVeloc0 = m_body0->m_veloc;
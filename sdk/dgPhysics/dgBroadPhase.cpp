@@ -26,6 +26,7 @@
 #include "dgBroadPhase.h"
 #include "dgDynamicBody.h"
 #include "dgCollisionConvex.h"
+#include "dgCollisionCompound.h"
 #include "dgCollisionInstance.h"
 #include "dgWorldDynamicUpdate.h"
 #include "dgBilateralConstraint.h"
@@ -153,6 +154,7 @@ dgBroadPhase::dgBroadPhase(dgWorld* const world)
 	,m_lru(DG_CONTACT_DELAY_FRAMES)
 	,m_contactCache(world->GetAllocator())
 	,m_pendingSoftBodyCollisions(world->GetAllocator(), 64)
+	,m_splitPairs(world->GetAllocator())
 	,m_pendingSoftBodyPairsCount(0)
 	,m_criticalSectionLock(0)
 {
@@ -247,6 +249,42 @@ void dgBroadPhase::ForceAndToqueKernel(void* const context, void* const node, dg
 	broadPhase->ApplyForceAndtorque(descriptor, (dgBodyMasterList::dgListNode*) node, threadID);
 }
 
+void dgBroadPhase::InitSubstepBodiesKernel(void* const context, void* const node, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*)context;
+	dgWorld* const world = descriptor->m_world;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+	broadPhase->InitSubstepBodies(descriptor, (dgBodyMasterList::dgListNode*) node, threadID);
+}
+
+void dgBroadPhase::AdvanceSubstepContactsKernel(void* const context, void* const, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgBroadphaseSyncDescriptor* const descriptor = (dgBroadphaseSyncDescriptor*)context;
+	dgWorld* const world = descriptor->m_world;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+	broadPhase->AdvanceSubstepContacts(descriptor, threadID);
+}
+
+void dgBroadPhase::ShiftBodiesKernel(void* const context, void* const node, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgShiftOriginDescriptor* const descriptor = (dgShiftOriginDescriptor*)context;
+	dgWorld* const world = descriptor->m_world;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+	broadPhase->ShiftBodies(descriptor, (dgBodyMasterList::dgListNode*) node, threadID);
+}
+
+void dgBroadPhase::ShiftContactsKernel(void* const context, void* const, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgShiftOriginDescriptor* const descriptor = (dgShiftOriginDescriptor*)context;
+	dgWorld* const world = descriptor->m_world;
+	dgBroadPhase* const broadPhase = world->GetBroadPhase();
+	broadPhase->ShiftContacts(descriptor, threadID);
+}
+
 void dgBroadPhase::SleepingStateKernel(void* const context, void* const node, dgInt32 threadID)
 {
 	D_TRACKTIME();
@@ -298,6 +336,158 @@ void dgBroadPhase::ApplyForceAndtorque(dgBroadphaseSyncDescriptor* const descrip
 	}
 }
 
+void dgBroadPhase::InitSubstepBodies(dgBroadphaseSyncDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID)
+{
+	const dgInt32 threadCount = m_world->GetThreadCount();
+	while (node) {
+		dgBody* const body = node->GetInfo().GetBody();
+		body->InitJointSet();
+		if (DoNeedUpdate(node)) {
+			if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
+				// the external forces of the first sub step are kept for the whole step, 
+				// but impulses are only applied once
+				dgDynamicBody* const dynamicBody = (dgDynamicBody*)body;
+				dynamicBody->m_externalForce -= dynamicBody->m_stepImpulseForce;
+				dynamicBody->m_externalTorque -= dynamicBody->m_stepImpulseTorque;
+				dynamicBody->m_stepImpulseForce = dgVector::m_zero;
+				dynamicBody->m_stepImpulseTorque = dgVector::m_zero;
+				dynamicBody->m_gyroRotation = dynamicBody->m_rotation;
+				dynamicBody->m_gyroTorque = dgVector::m_zero;
+			}
+		}
+
+		for (dgInt32 i = 0; i < threadCount; i++) {
+			node = node ? node->GetNext() : NULL;
+		}
+	}
+}
+
+void dgBroadPhase::AdvanceSubstepContacts(dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID)
+{
+	DG_TRACKTIME();
+	dgContactList& contactList = *m_world;
+	const dgVector timestep(descriptor->m_timestep);
+	const dgVector halfTimestep(timestep * dgVector::m_half);
+	const dgInt32 threadCount = m_world->GetThreadCount();
+	const dgInt32 contactCount = contactList.m_contactCount;
+	dgContact** const contactArray = &contactList[0];
+
+	for (dgInt32 i = threadID; i < contactCount; i += threadCount) {
+		dgContact* const contact = contactArray[i];
+		if (contact->m_isActive && contact->m_maxDOF) {
+			const dgBody* const body0 = contact->m_body0;
+			const dgBody* const body1 = contact->m_body1;
+			for (dgContact::dgListNode* node = contact->GetFirst(); node; node = node->GetNext()) {
+				// move the point with the bodies and change the penetration by the relative normal displacement
+				dgContactMaterial& material = node->GetInfo();
+				const dgVector veloc0(body0->m_veloc + body0->m_omega.CrossProduct(material.m_point - body0->m_globalCentreOfMass));
+				const dgVector veloc1(body1->m_veloc + body1->m_omega.CrossProduct(material.m_point - body1->m_globalCentreOfMass));
+				const dgVector normalStep((veloc1 - veloc0).DotProduct(material.m_normal) * timestep);
+				material.m_penetration = dgMax(material.m_penetration + normalStep.GetScalar(), dgFloat32(0.0f));
+				material.m_point += (veloc0 + veloc1) * halfTimestep;
+			}
+		}
+	}
+}
+
+void dgBroadPhase::ShiftBodies(dgShiftOriginDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID)
+{
+	const dgVector offset(descriptor->m_offset);
+	const dgInt32 threadCount = m_world->GetThreadCount();
+	while (node) {
+		// translation does not change the shape of the aabb, so the padded box is moved as is
+		dgBody* const body = node->GetInfo().GetBody();
+		body->m_matrix.m_posit += offset;
+		body->m_globalCentreOfMass += offset;
+		body->m_minAABB += offset;
+		body->m_maxAABB += offset;
+		body->m_transformIsDirty = true;
+		body->UpdateWorlCollisionMatrix();
+
+		for (dgInt32 i = 0; i < threadCount; i++) {
+			node = node ? node->GetNext() : NULL;
+		}
+	}
+}
+
+void dgBroadPhase::ShiftContacts(dgShiftOriginDescriptor* const descriptor, dgInt32 threadID)
+{
+	dgContactList& contactList = *m_world;
+	const dgVector offset(descriptor->m_offset);
+	const dgInt32 threadCount = m_world->GetThreadCount();
+	const dgInt32 contactCount = contactList.m_contactCount;
+	dgContact** const contactArray = &contactList[0];
+
+	for (dgInt32 i = threadID; i < contactCount; i += threadCount) {
+		dgContact* const contact = contactArray[i];
+		for (dgContact::dgListNode* node = contact->GetFirst(); node; node = node->GetNext()) {
+			node->GetInfo().m_point += offset;
+		}
+	}
+}
+
+void dgBroadPhase::ShiftNodeAABB(dgBroadPhaseNode* const node, const dgVector& offset) const
+{
+	if (node->IsAggregate()) {
+		dgBroadPhaseAggregate* const aggregate = (dgBroadPhaseAggregate*)node;
+		if (aggregate->m_root) {
+			ShiftNodeAABB(aggregate->m_root, offset);
+			aggregate->m_minBox = aggregate->m_root->m_minBox;
+			aggregate->m_maxBox = aggregate->m_root->m_maxBox;
+			aggregate->m_surfaceArea = aggregate->m_root->m_surfaceArea;
+		} else {
+			// an empty aggregate has no leaves to refit from, its box is moved as is
+			aggregate->m_minBox += offset;
+			aggregate->m_maxBox += offset;
+		}
+	} else if (node->IsLeafNode()) {
+		const dgBody* const body = node->GetBody();
+		node->SetAABB(body->m_minAABB, body->m_maxAABB);
+	} else {
+		dgBroadPhaseNode* const left = node->GetLeft();
+		dgBroadPhaseNode* const right = node->GetRight();
+		if (left) {
+			ShiftNodeAABB(left, offset);
+		}
+		if (right) {
+			ShiftNodeAABB(right, offset);
+		}
+		if (left && right) {
+			node->m_surfaceArea = CalculateSurfaceArea(left, right, node->m_minBox, node->m_maxBox);
+		} else if (left || right) {
+			const dgBroadPhaseNode* const child = left ? left : right;
+			node->m_minBox = child->m_minBox;
+			node->m_maxBox = child->m_maxBox;
+			node->m_surfaceArea = child->m_surfaceArea;
+		}
+	}
+}
+
+void dgBroadPhase::ShiftOrigin(const dgVector& offset)
+{
+	D_TRACKTIME();
+	const dgInt32 threadsCount = m_world->GetThreadCount();
+	const dgBodyMasterList* const masterList = m_world;
+	dgShiftOriginDescriptor descriptor(offset, m_world);
+
+	dgBodyMasterList::dgListNode* node = masterList->GetFirst()->GetNext();
+	for (dgInt32 i = 0; i < threadsCount; i++) {
+		m_world->QueueJob(ShiftBodiesKernel, &descriptor, node, "dgBroadPhase::ShiftBodies");
+		node = node ? node->GetNext() : NULL;
+	}
+	m_world->SynchronizationBarrier();
+
+	for (dgInt32 i = 0; i < threadsCount; i++) {
+		m_world->QueueJob(ShiftContactsKernel, &descriptor, NULL, "dgBroadPhase::ShiftContacts");
+	}
+	m_world->SynchronizationBarrier();
+
+	// the tree topology is still valid, only the boxes are refit to the quantized grid
+	if (m_rootNode) {
+		ShiftNodeAABB(m_rootNode, offset);
+	}
+}
+
 void dgBroadPhase::SleepingState(dgBroadphaseSyncDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID)
 {
 	DG_TRACKTIME();
@@ -312,6 +502,9 @@ void dgBroadPhase::SleepingState(dgBroadphaseSyncDescriptor* const descriptor, d
 	while (node) {
 		if (DoNeedUpdate(node)) {
 			dgBody* const body = node->GetInfo().GetBody();
+			if (m_world->m_onCollisionLodSelect && body->m_collision->GetLodCount()) {
+				SelectCollisionLod (body, timestep, threadID);
+			}
 
 			if (body->IsRTTIType(dgBody::m_dynamicBodyRTTI)) {
 				dgDynamicBody* const dynamicBody = (dgDynamicBody*)body;
@@ -373,6 +566,19 @@ void dgBroadPhase::SleepingState(dgBroadphaseSyncDescriptor* const descriptor, d
 }
 
 
+void dgBroadPhase::SelectCollisionLod (dgBody* const body, dgFloat32 timestep, dgInt32 threadID)
+{
+	dgCollisionInstance* const collision = body->m_collision;
+	const dgInt32 lod = m_world->m_onCollisionLodSelect (body, collision, collision->GetLodCount(), threadID);
+	if (collision->SetActiveLod (lod) && body->GetBroadPhase()) {
+		// the new level has a different bounding box, refit the body even if it is resting
+		body->UpdateCollisionMatrix (timestep, threadID);
+		if (body->m_equilibrium) {
+			UpdateBodyAABB (body, threadID);
+		}
+	}
+}
+
 void dgBroadPhase::ForEachBodyInAABB(const dgBroadPhaseNode** stackPool, dgInt32 stack, const dgVector& minBox, const dgVector& maxBox, OnBodiesInAABB callback, void* const userData) const
 {
 	while (stack) {
@@ -731,10 +937,22 @@ void dgBroadPhase::UpdateBody(dgBody* const body, dgInt32 threadIndex)
 			dgScopeSpinPause lock(&aggregate->m_criticalSectionLock);
 			aggregate->m_isInEquilibrium = body1->m_equilibrium;
 		}
-		
-		if (!dgBoxInclusionTest(body1->m_minAABB, body1->m_maxAABB, node->m_minBox, node->m_maxBox)) {
+		UpdateBodyAABB (body1, threadIndex);
+	}
+}
+
+void dgBroadPhase::UpdateBodyAABB(dgBody* const body, dgInt32 threadIndex)
+{
+	// refit the leaf and its parents, the body resting state and its aggregate are not touched
+	if (m_rootNode && body->m_masterNode) {
+		dgBroadPhaseBodyNode* const node = body->GetBroadPhase();
+		dgAssert(node->GetBody() == body);
+		dgAssert(!node->GetLeft());
+		dgAssert(!node->GetRight());
+
+		if (!dgBoxInclusionTest(body->m_minAABB, body->m_maxAABB, node->m_minBox, node->m_maxBox)) {
 			dgAssert(!node->IsAggregate());
-			node->SetAABB(body1->m_minAABB, body1->m_maxAABB);
+			node->SetAABB(body->m_minAABB, body->m_maxAABB);
 
 			if (!m_rootNode->IsLeafNode()) {
 				const dgBroadPhaseNode* const root = (m_rootNode->GetLeft() && m_rootNode->GetRight()) ? NULL : m_rootNode;
@@ -844,6 +1062,16 @@ dgInt32 dgBroadPhase::CompareNodes(const dgBroadPhaseNode* const nodeA, const dg
 	return 0;
 }
 
+dgInt32 dgBroadPhase::CompareSplitPairs(const dgInt32* const indexA, const dgInt32* const indexB, void* const)
+{
+	if (*indexA < *indexB) {
+		return -1;
+	}
+	if (*indexA > *indexB) {
+		return 1;
+	}
+	return 0;
+}
 
 void dgBroadPhase::ImproveFitness(dgFitnessList& fitness, dgFloat64& oldEntropy, dgBroadPhaseNode** const root)
 {
@@ -1093,7 +1321,7 @@ void dgBroadPhase::CalculatePairContacts (dgPair* const pair, dgInt32 threadID)
 	}
 }
 
-void dgBroadPhase::AddPair (dgContact* const contact, dgFloat32 timestep, dgInt32 threadIndex)
+void dgBroadPhase::AddPair (dgContact* const contact, dgFloat32 timestep, dgInt32 threadIndex, bool splitChildPairs)
 {
 	//DG_TRACKTIME();
 	dgWorld* const world = (dgWorld*) m_world;
@@ -1126,6 +1354,7 @@ void dgBroadPhase::AddPair (dgContact* const contact, dgFloat32 timestep, dgInt3
 
 			pair.m_contact = contact;
 			pair.m_timestep = timestep;
+			pair.m_splitChildPairs = splitChildPairs ? -1 : 0;
             CalculatePairContacts (&pair, threadIndex);
 		}
 	}
@@ -1515,76 +1744,100 @@ void dgBroadPhase::UpdateRigidBodyContacts(dgBroadphaseSyncDescriptor* const des
 	const dgInt32 contactCount = contactList.m_contactCount;
 	dgContact** const contactArray = &contactList[0];
 
-	dgVector deltaTime(timestep);
 	for (dgInt32 i = threadID; i < contactCount; i += threadCount) {
 		dgContact* const contact = contactArray[i];
 		dgAssert (contact);
+		if ((threadCount > 1) && dgCollisionCompound::SplitChildPairs (contact->GetBody0()->GetCollision(), contact->GetBody1()->GetCollision())) {
+			// too many child pairs for one thread, these are done after the barrier with all threads
+			dgInt32 index = dgAtomicExchangeAndAdd(&descriptor->m_atomicSplitPairsCount, 1);
+			m_splitPairs[index] = i;
+		} else {
+			UpdateRigidBodyContact(contact, timestep, lru, threadID, false);
+		}
+	}
+}
 
-		dgBody* const body0 = contact->GetBody0();
-		dgBody* const body1 = contact->GetBody1();
+void dgBroadPhase::UpdateRigidBodyContact(dgContact* const contact, dgFloat32 timestep, dgUnsigned32 lru, dgInt32 threadID, bool splitChildPairs)
+{
+	const dgVector deltaTime(timestep);
+	dgBody* const body0 = contact->GetBody0();
+	dgBody* const body1 = contact->GetBody1();
 
-		if (!(contact->m_killContact | (body0->m_equilibrium & body1->m_equilibrium))) {
-			dgAssert(!contact->m_killContact);
+	if (!(contact->m_killContact | (body0->m_equilibrium & body1->m_equilibrium))) {
+		dgAssert(!contact->m_killContact);
 
-			bool isActive = contact->m_isActive;
-			if (ValidateContactCache(contact, deltaTime)) {
+		bool isActive = contact->m_isActive;
+		if (ValidateContactCache(contact, deltaTime)) {
+			contact->m_broadphaseLru = m_lru;
+			contact->m_timeOfImpact = dgFloat32(1.0e10f);
+		} else {
+			contact->m_isActive = 0;
+			contact->m_positAcc = dgVector::m_zero;
+			contact->m_rotationAcc = dgQuaternion();
+
+			dgFloat32 distance = contact->m_separationDistance;
+			if (distance >= DG_NARROW_PHASE_DIST) {
+				const dgVector veloc0 (body0->GetVelocity());
+				const dgVector veloc1 (body1->GetVelocity());
+
+				const dgVector veloc(veloc1 - veloc0);
+				const dgVector omega0 (body0->GetOmega());
+				const dgVector omega1 (body1->GetOmega());
+				const dgCollisionInstance* const collision0 = body0->GetCollision();
+				const dgCollisionInstance* const collision1 = body1->GetCollision();
+				const dgVector scale(dgFloat32(1.0f), dgFloat32(3.5f) * collision0->GetBoxMaxRadius(), dgFloat32(3.5f) * collision1->GetBoxMaxRadius(), dgFloat32(0.0f));
+				const dgVector velocMag2(veloc.DotProduct(veloc).GetScalar(), omega0.DotProduct(omega0).GetScalar(), omega1.DotProduct(omega1).GetScalar(), dgFloat32(0.0f));
+				const dgVector velocMag(velocMag2.GetMax(dgVector::m_epsilon).InvSqrt() * velocMag2 * scale);
+				const dgFloat32 speed = velocMag.AddHorizontal().GetScalar() + dgFloat32(0.5f);
+
+				distance -= speed * timestep;
+				contact->m_separationDistance = distance;
+			}
+			if (distance < DG_NARROW_PHASE_DIST) {
+				AddPair(contact, timestep, threadID, splitChildPairs);
+				if (contact->m_maxDOF) {
+					contact->m_timeOfImpact = dgFloat32(1.0e10f);
+				}
 				contact->m_broadphaseLru = m_lru;
-				contact->m_timeOfImpact = dgFloat32(1.0e10f);
 			} else {
-				contact->m_isActive = 0;
-				contact->m_positAcc = dgVector::m_zero;
-				contact->m_rotationAcc = dgQuaternion();
-
-				dgFloat32 distance = contact->m_separationDistance;
-				if (distance >= DG_NARROW_PHASE_DIST) {
-					const dgVector veloc0 (body0->GetVelocity());
-					const dgVector veloc1 (body1->GetVelocity());
-
-					const dgVector veloc(veloc1 - veloc0);
-					const dgVector omega0 (body0->GetOmega());
-					const dgVector omega1 (body1->GetOmega());
-					const dgCollisionInstance* const collision0 = body0->GetCollision();
-					const dgCollisionInstance* const collision1 = body1->GetCollision();
-					const dgVector scale(dgFloat32(1.0f), dgFloat32(3.5f) * collision0->GetBoxMaxRadius(), dgFloat32(3.5f) * collision1->GetBoxMaxRadius(), dgFloat32(0.0f));
-					const dgVector velocMag2(veloc.DotProduct(veloc).GetScalar(), omega0.DotProduct(omega0).GetScalar(), omega1.DotProduct(omega1).GetScalar(), dgFloat32(0.0f));
-					const dgVector velocMag(velocMag2.GetMax(dgVector::m_epsilon).InvSqrt() * velocMag2 * scale);
-					const dgFloat32 speed = velocMag.AddHorizontal().GetScalar() + dgFloat32(0.5f);
-
-					distance -= speed * timestep;
-					contact->m_separationDistance = distance;
-				}
-				if (distance < DG_NARROW_PHASE_DIST) {
-					AddPair(contact, timestep, threadID);
-					if (contact->m_maxDOF) {
-						contact->m_timeOfImpact = dgFloat32(1.0e10f);
-					}
+				dgAssert (contact->m_maxDOF == 0);
+				const dgBroadPhaseNode* const bodyNode0 = contact->GetBody0()->m_broadPhaseNode;
+				const dgBroadPhaseNode* const bodyNode1 = contact->GetBody1()->m_broadPhaseNode;
+				if (dgOverlapTest(bodyNode0->m_minBox, bodyNode0->m_maxBox, bodyNode1->m_minBox, bodyNode1->m_maxBox)) {
 					contact->m_broadphaseLru = m_lru;
-				} else {
-					dgAssert (contact->m_maxDOF == 0);
-					const dgBroadPhaseNode* const bodyNode0 = contact->GetBody0()->m_broadPhaseNode;
-					const dgBroadPhaseNode* const bodyNode1 = contact->GetBody1()->m_broadPhaseNode;
-					if (dgOverlapTest(bodyNode0->m_minBox, bodyNode0->m_maxBox, bodyNode1->m_minBox, bodyNode1->m_maxBox)) {
-						contact->m_broadphaseLru = m_lru;
-					} else if (contact->m_broadphaseLru < lru) {
-						contact->m_killContact = 1;
-					}
+				} else if (contact->m_broadphaseLru < lru) {
+					contact->m_killContact = 1;
 				}
 			}
+		}
 
-			if (isActive ^ contact->m_isActive) {
-				if (body0->GetInvMass().m_w) {
-					body0->m_equilibrium = false;
-				}
-				if (body1->GetInvMass().m_w) {
-					body1->m_equilibrium = false;
-				}
+		if (isActive ^ contact->m_isActive) {
+			if (body0->GetInvMass().m_w) {
+				body0->m_equilibrium = false;
+			}
+			if (body1->GetInvMass().m_w) {
+				body1->m_equilibrium = false;
 			}
-
-		} else {
-			contact->m_broadphaseLru = m_lru;
 		}
 
-		contact->m_killContact = contact->m_killContact | (body0->m_equilibrium & body1->m_equilibrium & !contact->m_isActive);
+	} else {
+		contact->m_broadphaseLru = m_lru;
+	}
+
+	contact->m_killContact = contact->m_killContact | (body0->m_equilibrium & body1->m_equilibrium & !contact->m_isActive);
+}
+
+void dgBroadPhase::UpdateSplitPairContacts(dgBroadphaseSyncDescriptor* const descriptor)
+{
+	DG_TRACKTIME();
+	dgContactList& contactList = *m_world;
+	const dgInt32 count = descriptor->m_atomicSplitPairsCount;
+	const dgUnsigned32 lru = m_lru - DG_CONTACT_DELAY_FRAMES;
+
+	dgSort(&m_splitPairs[0], count, CompareSplitPairs);
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgContact* const contact = contactList[m_splitPairs[i]];
+		UpdateRigidBodyContact(contact, descriptor->m_timestep, lru, 0, true);
 	}
 }
 
@@ -1654,6 +1907,30 @@ void dgBroadPhase::AttachNewContact(dgInt32 startCount)
 	}
 }
 
+void dgBroadPhase::UpdateSubstepContacts(dgFloat32 timestep)
+{
+	D_TRACKTIME();
+	const dgInt32 threadsCount = m_world->GetThreadCount();
+	const dgBodyMasterList* const masterList = m_world;
+	dgBroadphaseSyncDescriptor syncPoints(timestep, m_world);
+
+	dgBodyMasterList::dgListNode* node = masterList->GetFirst()->GetNext();
+	for (dgInt32 i = 0; i < threadsCount; i++) {
+		m_world->QueueJob(InitSubstepBodiesKernel, &syncPoints, node, "dgBroadPhase::InitSubstepBodies");
+		node = node ? node->GetNext() : NULL;
+	}
+	m_world->SynchronizationBarrier();
+
+	for (dgInt32 i = 0; i < threadsCount; i++) {
+		m_world->QueueJob(AdvanceSubstepContactsKernel, &syncPoints, NULL, "dgBroadPhase::AdvanceSubstepContacts");
+	}
+	m_world->SynchronizationBarrier();
+
+	// the solver reorders the joint array, collect the active and speculative ccd contacts again.
+	// no pair is killed between substeps, so this only rebuilds the active list
+	DeleteDeadContact(timestep);
+}
+
 void dgBroadPhase::DeleteDeadContact(dgFloat32 timestep)
 {
 	DG_TRACKTIME();
@@ -1745,11 +2022,16 @@ void dgBroadPhase::UpdateContacts(dgFloat32 timestep)
 	m_world->SynchronizationBarrier();
 
 	AttachNewContact(syncPoints.m_contactStart);
+	m_splitPairs.ResizeIfNecessary(contactList.m_contactCount);
 	for (dgInt32 i = 0; i < threadsCount; i++) {
 		m_world->QueueJob(UpdateRigidBodyContactKernel, &syncPoints, NULL, "dgBroadPhase::UpdateRigidBodyContact");
 	}
 	m_world->SynchronizationBarrier();
 
+	if (syncPoints.m_atomicSplitPairsCount) {
+		UpdateSplitPairContacts(&syncPoints);
+	}
+
 	if (m_pendingSoftBodyPairsCount) {
 		dgAssert (0);
 		//for (dgInt32 i = 0; i < threadsCount; i++) {
@@ -408,6 +408,7 @@ class dgBroadPhase
 			,m_contactStart(0)
 			,m_atomicDynamicsCount(0)
 			,m_atomicPendingBodiesCount(0)
+			,m_atomicSplitPairsCount(0)
 			,m_fullScan(false)
 		{
 		}
@@ -418,8 +419,23 @@ class dgBroadPhase
 		dgInt32 m_contactStart;
 		dgInt32 m_atomicDynamicsCount;
 		dgInt32 m_atomicPendingBodiesCount;
+		dgInt32 m_atomicSplitPairsCount;
 		bool m_fullScan;
 	};
+
+	DG_MSC_VECTOR_ALIGMENT
+	class dgShiftOriginDescriptor
+	{
+		public:
+		dgShiftOriginDescriptor(const dgVector& offset, dgWorld* const world)
+			:m_offset(offset & dgVector::m_triplexMask)
+			,m_world(world)
+		{
+		}
+
+		dgVector m_offset;
+		dgWorld* m_world;
+	} DG_GCC_VECTOR_ALIGMENT;
 	
 	class dgFitnessList: public dgList <dgBroadPhaseTreeNode*>
 	{
@@ -456,12 +472,24 @@ class dgBroadPhase
 	class dgPair
 	{
     	public:
+		dgPair()
+			:m_contact(NULL)
+			,m_contactBuffer(NULL)
+			,m_timestep(dgFloat32 (0.0f))
+			,m_contactCount(0)
+			,m_cacheIsValid(0)
+			,m_flipContacts(0)
+			,m_splitChildPairs(0)
+		{
+		}
+
 		dgContact* m_contact;
 		dgContactPoint* m_contactBuffer;
 		dgFloat32 m_timestep;
 		dgInt32 m_contactCount : 16;
 		dgInt32 m_cacheIsValid : 1;
 		dgInt32 m_flipContacts : 1;
+		dgInt32 m_splitChildPairs : 1;
 	};
 
 	dgBroadPhase(dgWorld* const world);
@@ -501,12 +529,15 @@ class dgBroadPhase
 	virtual void FindCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgList<dgBroadPhaseNode*>::dgListNode* const node, dgInt32 threadID) = 0;
 
 	void UpdateBody(dgBody* const body, dgInt32 threadIndex);
+	void UpdateBodyAABB(dgBody* const body, dgInt32 threadIndex);
 	void AddInternallyGeneratedBody(dgBody* const body)
 	{
 		m_generatedBodies.Append(body);
 	}
 
 	void UpdateContacts(dgFloat32 timestep);
+	void UpdateSubstepContacts(dgFloat32 timestep);
+	void ShiftOrigin(const dgVector& offset);
 	void CollisionChange (dgBody* const body, dgCollisionInstance* const collisionSrc);
 
 	void MoveNodes (dgBroadPhase* const dest);
@@ -525,7 +556,7 @@ class dgBroadPhase
 	void ImproveFitness(dgFitnessList& fitness, dgFloat64& oldEntropy, dgBroadPhaseNode** const root);
 
 	void CalculatePairContacts (dgPair* const pair, dgInt32 threadID);
-	void AddPair (dgContact* const contact, dgFloat32 timestep, dgInt32 threadIndex);
+	void AddPair (dgContact* const contact, dgFloat32 timestep, dgInt32 threadIndex, bool splitChildPairs = false);
 	void AddPair (dgBody* const body0, dgBody* const body1, dgFloat32 timestep, dgInt32 threadID);	
 
 	bool TestOverlaping(const dgBody* const body0, const dgBody* const body1, dgFloat32 timestep) const;
@@ -540,7 +571,13 @@ class dgBroadPhase
 		            dgCollisionInstance* const shape, const dgMatrix& matrix, OnRayPrecastAction prefilter, void* const userData, dgConvexCastReturnInfo* const info, dgInt32 maxContacts, dgInt32 threadIndex) const;
 
 	void SleepingState (dgBroadphaseSyncDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID);
+	void SelectCollisionLod (dgBody* const body, dgFloat32 timestep, dgInt32 threadID);
 	void ApplyForceAndtorque (dgBroadphaseSyncDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID);
+	void InitSubstepBodies (dgBroadphaseSyncDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID);
+	void AdvanceSubstepContacts (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
+	void ShiftBodies (dgShiftOriginDescriptor* const descriptor, dgBodyMasterList::dgListNode* node, dgInt32 threadID);
+	void ShiftContacts (dgShiftOriginDescriptor* const descriptor, dgInt32 threadID);
+	void ShiftNodeAABB (dgBroadPhaseNode* const node, const dgVector& offset) const;
 	
 	void UpdateAggregateEntropy (dgBroadphaseSyncDescriptor* const descriptor, dgList<dgBroadPhaseAggregate*>::dgListNode* node, dgInt32 threadID);
 
@@ -552,6 +589,8 @@ class dgBroadPhase
 	void FindGeneratedBodiesCollidingPairs (dgBroadphaseSyncDescriptor* const descriptor, dgInt32 threadID);
 	void UpdateSoftBodyContacts(dgBroadphaseSyncDescriptor* const descriptor, dgFloat32 timeStep, dgInt32 threadID);
 	void UpdateRigidBodyContacts (dgBroadphaseSyncDescriptor* const descriptor, dgFloat32 timeStep, dgInt32 threadID);
+	void UpdateRigidBodyContact (dgContact* const contact, dgFloat32 timestep, dgUnsigned32 lru, dgInt32 threadID, bool splitChildPairs);
+	void UpdateSplitPairContacts (dgBroadphaseSyncDescriptor* const descriptor);
 	void SubmitPairs (dgBroadPhaseNode* const body, dgBroadPhaseNode* const node, dgFloat32 timestep, dgInt32 threaCount, dgInt32 threadID);
 
 	bool SanityCheck() const;
@@ -562,12 +601,17 @@ class dgBroadPhase
 		
 	static void SleepingStateKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void ForceAndToqueKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void InitSubstepBodiesKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void AdvanceSubstepContactsKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void ShiftBodiesKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
+	static void ShiftContactsKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void CollidingPairsKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void UpdateAggregateEntropyKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void AddGeneratedBodiesContactsKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void UpdateRigidBodyContactKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static void UpdateSoftBodyContactKernel(void* const descriptor, void* const worldContext, dgInt32 threadID);
 	static dgInt32 CompareNodes(const dgBroadPhaseNode* const nodeA, const dgBroadPhaseNode* const nodeB, void* const notUsed);
+	static dgInt32 CompareSplitPairs(const dgInt32* const indexA, const dgInt32* const indexB, void* const notUsed);
 
 	class dgPendingCollisionSoftBodies
 	{
@@ -584,6 +628,7 @@ class dgBroadPhase
 	dgUnsigned32 m_lru;
 	dgContactCache m_contactCache;
 	dgArray<dgPendingCollisionSoftBodies> m_pendingSoftBodyCollisions;
+	dgArray<dgInt32> m_splitPairs;
 	dgInt32 m_pendingSoftBodyPairsCount;
 	dgInt32 m_criticalSectionLock;
 
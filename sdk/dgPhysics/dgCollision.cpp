@@ -79,6 +79,7 @@ dgCollision::dgCollision (dgWorld* const world, dgDeserialize deserialization, v
 	deserialization (userData, &m_signature, sizeof (m_signature));
 	deserialization (userData, &collisionId, sizeof (collisionId));
 	m_collisionId = dgCollisionID(collisionId);
+	m_allocator = world->GetShapeAllocator(m_collisionId);
 }
 
 dgCollision::~dgCollision()
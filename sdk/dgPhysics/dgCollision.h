@@ -318,6 +318,7 @@ class dgCollision
 	friend class dgMinkowskiConv;
 	friend class dgCollisionInstance;
 	friend class dgCollisionCompound;
+	friend class dgCollisionShapeCache;
 }DG_GCC_VECTOR_ALIGMENT;
 
 DG_INLINE dgCollisionID dgCollision::GetCollisionPrimityType () const
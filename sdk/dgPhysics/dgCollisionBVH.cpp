@@ -53,6 +53,22 @@ dgCollisionBVH::dgCollisionBVH (dgWorld* const world, dgDeserialize deserializat
 	deserialization(userData, &m_trianglesCount, sizeof (dgInt32));
 }
 
+dgCollisionBVH::dgCollisionBVH (dgWorld* const world, const dgImageHeader* const image)
+	:dgCollisionMesh (world, m_boundingBoxHierachy), dgAABBPolygonSoup()
+	,m_trianglesCount(image->m_userData)
+{
+	m_rtti |= dgCollisionBVH_RTTI;
+	m_builder = NULL;
+	m_userRayCastCallback = NULL;
+
+	MapImage (image);
+
+	dgVector p0; 
+	dgVector p1; 
+	GetAABB (p0, p1);
+	SetCollisionBBox(p0, p1);
+}
+
 dgCollisionBVH::~dgCollisionBVH(void)
 {
 }
@@ -64,6 +80,11 @@ void dgCollisionBVH::Serialize(dgSerialize callback, void* const userData) const
 	callback(userData, &m_trianglesCount, sizeof (dgInt32));
 }
 
+void dgCollisionBVH::SerializeImage (dgSerialize callback, void* const userData) const
+{
+	dgAABBPolygonSoup::SerializeImage (callback, userData, m_trianglesCount);
+}
+
 void dgCollisionBVH::BeginBuild()
 {
 	m_builder = new (m_allocator) dgPolygonSoupDatabaseBuilder(m_allocator);
@@ -88,7 +109,7 @@ void dgCollisionBVH::SetCollisionRayCastCallback (dgCollisionBVHUserRayCastCallb
 	m_userRayCastCallback = rayCastCallback;
 }
 
-void dgCollisionBVH::EndBuild(dgInt32 optimize)
+void dgCollisionBVH::EndBuild(dgInt32 optimize, dgThreadHive* const threadPool, dgInt32 buildQuality)
 {
 	dgVector p0;
 	dgVector p1;
@@ -103,8 +124,8 @@ void dgCollisionBVH::EndBuild(dgInt32 optimize)
 	}
 #endif
 
-	m_builder->End(state);
-	Create (*m_builder, state);
+	m_builder->End(state, threadPool);
+	Create (*m_builder, state, threadPool, buildQuality);
 	CalculateAdjacendy();
 	
 	GetAABB (p0, p1);
@@ -52,17 +52,19 @@ class dgCollisionBVH: public dgCollisionMesh, public dgAABBPolygonSoup
 
 	dgCollisionBVH(dgWorld* const world);
 	dgCollisionBVH (dgWorld* const world, dgDeserialize deserialization, void* const userData, dgInt32 revisionNumber);
+	dgCollisionBVH (dgWorld* const world, const dgImageHeader* const image);
 	virtual ~dgCollisionBVH(void);
 
 	void BeginBuild();
 	void AddFace (dgInt32 vertexCount, const dgFloat32* const vertexPtr, dgInt32 strideInBytes, dgInt32 faceAttribute);
-	void EndBuild(dgInt32 optimize);
+	void EndBuild(dgInt32 optimize, dgThreadHive* const threadPool = NULL, dgInt32 buildQuality = m_buildDefault);
 
 	void SetCollisionRayCastCallback (dgCollisionBVHUserRayCastCallback rayCastCallback);
 	dgCollisionBVHUserRayCastCallback GetDebugRayCastCallback() const { return m_userRayCastCallback;} 
 	void GetVertexListIndexList (const dgVector& p0, const dgVector& p1, dgMeshVertexListIndexList &data) const;
 
 	void ForEachFace (dgAABBIntersectCallback callback, void* const context) const;
+	void SerializeImage (dgSerialize callback, void* const userData) const;
 
 	private:
 	static dgFloat32 RayHit (void* const context, const dgFloat32* const polygon, dgInt32 strideInBytes, const dgInt32* const indexArray, dgInt32 indexCount);
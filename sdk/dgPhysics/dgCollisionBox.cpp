@@ -330,7 +330,7 @@ dgInt32 dgCollisionBox::CalculatePlaneIntersection (const dgVector& normal, cons
 
 	const dgConvexSimplexEdge** const vertToEdgeMapping = GetVertexToEdgeMapping();
 	if (vertToEdgeMapping) {
-		dgInt32 edgeIndex;
+		dgInt32 edgeIndex = -1;
 		support[0] = SupportVertex (normal, &edgeIndex);
 
 		dgFloat32 dist = normal.DotProduct(support[0] - point).GetScalar();
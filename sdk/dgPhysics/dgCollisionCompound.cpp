@@ -46,6 +46,55 @@ class dgCollisionCompound::dgHeapNodePair
 	dgNodeBase* m_nodeB;
 };
 
+DG_MSC_VECTOR_ALIGMENT
+class dgCollisionCompound::dgChildPair
+{
+	public:
+	dgVector m_separatingVector;
+	const dgNodeBase* m_myNode;
+	const dgNodeBase* m_otherNode;
+	dgFloat32 m_closestDistance;
+	dgInt32 m_threadIndex;
+	dgInt32 m_contactStart;
+	dgInt32 m_contactCount;
+	dgInt32 m_isActive;
+	dgInt32 m_isNewContact;
+} DG_GCC_VECTOR_ALIGMENT;
+
+class dgCollisionCompound::dgChildPairContext
+{
+	public:
+	dgChildPairContext (const dgCollisionCompound* const me, const dgCollisionParamProxy* const proxy)
+		:m_pairs(me->m_allocator)
+		,m_me(me)
+		,m_proxy(proxy)
+		,m_count(0)
+		,m_atomicIndex(0)
+	{
+		for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+			m_contacts[i].SetAllocator(me->m_allocator);
+			m_contactCount[i] = 0;
+		}
+	}
+
+	void AddPair (const dgNodeBase* const myNode, const dgNodeBase* const otherNode)
+	{
+		dgChildPair& pair = m_pairs[m_count];
+		pair.m_myNode = myNode;
+		pair.m_otherNode = otherNode;
+		pair.m_contactCount = 0;
+		m_count ++;
+	}
+
+	dgArray<dgChildPair> m_pairs;
+	dgArray<dgContactPoint> m_contacts[DG_MAX_THREADS_HIVE_COUNT];
+	dgInt32 m_contactCount[DG_MAX_THREADS_HIVE_COUNT];
+	const dgCollisionCompound* m_me;
+	const dgCollisionParamProxy* m_proxy;
+	dgInt32 m_count;
+	dgInt32 m_atomicIndex;
+};
+
 
 dgCollisionCompound::dgTreeArray::dgTreeArray (dgMemoryAllocator* const allocator)
 	:dgTree<dgNodeBase*, dgInt32>(allocator)
@@ -464,11 +513,18 @@ dgCollisionCompound::dgCollisionCompound(dgWorld* const world)
 	,m_root(NULL)
 	,m_myInstance(NULL)
 	,m_array (world->GetAllocator())
+	,m_dirtyNodes (world->GetAllocator())
+	,m_massOrigin (dgFloat64 (0.0f))
+	,m_massInertiaII (dgFloat64 (0.0f))
+	,m_massInertiaIJ (dgFloat64 (0.0f))
+	,m_massVolume (dgFloat64 (0.0f))
 	,m_treeEntropy (dgFloat32 (0.0f))
+	,m_treeCost (dgFloat32 (0.0f))
 	,m_boxMinRadius(dgFloat32(0.0f))
 	,m_boxMaxRadius(dgFloat32(0.0f))
 	,m_idIndex(0)
 	,m_criticalSectionLock(0)
+	,m_structureChanged(1)
 {
 	m_rtti |= dgCollisionCompound_RTTI;
 }
@@ -479,11 +535,18 @@ dgCollisionCompound::dgCollisionCompound (const dgCollisionCompound& source, con
 	,m_root(NULL)
 	,m_myInstance(myInstance)
 	,m_array (source.GetAllocator())
+	,m_dirtyNodes (source.GetAllocator())
+	,m_massOrigin (source.m_massOrigin)
+	,m_massInertiaII (source.m_massInertiaII)
+	,m_massInertiaIJ (source.m_massInertiaIJ)
+	,m_massVolume (source.m_massVolume)
 	,m_treeEntropy(source.m_treeEntropy)
+	,m_treeCost(source.m_treeCost)
 	,m_boxMinRadius(source.m_boxMinRadius)
 	,m_boxMaxRadius(source.m_boxMaxRadius)
 	,m_idIndex(source.m_idIndex)
 	,m_criticalSectionLock(0)
+	,m_structureChanged(source.m_structureChanged || source.m_dirtyNodes.GetCount())
 {
 	m_rtti |= dgCollisionCompound_RTTI;
 
@@ -560,11 +623,18 @@ dgCollisionCompound::dgCollisionCompound (dgWorld* const world, dgDeserialize de
 	,m_root(NULL)
 	,m_myInstance(myInstance)
 	,m_array (world->GetAllocator())
+	,m_dirtyNodes (world->GetAllocator())
+	,m_massOrigin (dgFloat64 (0.0f))
+	,m_massInertiaII (dgFloat64 (0.0f))
+	,m_massInertiaIJ (dgFloat64 (0.0f))
+	,m_massVolume (dgFloat64 (0.0f))
 	,m_treeEntropy(dgFloat32(0.0f))
+	,m_treeCost(dgFloat32(0.0f))
 	,m_boxMinRadius(dgFloat32(0.0f))
 	,m_boxMaxRadius(dgFloat32(0.0f))
 	,m_idIndex(0)
 	,m_criticalSectionLock(0)
+	,m_structureChanged(1)
 {
 	dgAssert (m_rtti | dgCollisionCompound_RTTI);
 
@@ -839,27 +909,37 @@ void dgCollisionCompound::MassProperties ()
 #endif
 
 
-	dgFloat32 volume = dgFloat32 (0.0f);
-	dgVector origin (dgFloat32 (0.0f));
-	dgVector inertiaII (dgFloat32 (0.0f));
-	dgVector inertiaIJ (dgFloat32 (0.0f));
+	m_massVolume = dgFloat64 (0.0f);
+	m_massOrigin = dgBigVector (dgFloat64 (0.0f));
+	m_massInertiaII = dgBigVector (dgFloat64 (0.0f));
+	m_massInertiaIJ = dgBigVector (dgFloat64 (0.0f));
 	dgTreeArray::Iterator iter (m_array);
 	for (iter.Begin(); iter; iter ++) {
-		dgCollisionInstance* const collision = iter.GetNode()->GetInfo()->GetShape();
-		dgMatrix shapeInertia (collision->CalculateInertia());
-		dgFloat32 shapeVolume = collision->GetVolume();
-
-		volume += shapeVolume;
-		origin += shapeInertia.m_posit.Scale(shapeVolume);
-		inertiaII += dgVector (shapeInertia[0][0], shapeInertia[1][1], shapeInertia[2][2], dgFloat32 (0.0f)).Scale (shapeVolume);
-		inertiaIJ += dgVector (shapeInertia[1][2], shapeInertia[0][2], shapeInertia[0][1], dgFloat32 (0.0f)).Scale (shapeVolume);
+		AddChildMassProperties (iter.GetNode()->GetInfo()->GetShape(), dgFloat64 (1.0f));
 	}
-	if (volume > dgFloat32 (0.0f)) { 
-		dgFloat32 invVolume = dgFloat32 (1.0f)/volume;
-		m_inertia = inertiaII.Scale (invVolume);
-		m_crossInertia = inertiaIJ.Scale (invVolume);
-		m_centerOfMass = origin.Scale (invVolume);
-		m_centerOfMass.m_w = volume;
+	ApplyMassProperties ();
+}
+
+void dgCollisionCompound::AddChildMassProperties (const dgCollisionInstance* const collision, dgFloat64 sign)
+{
+	// the sums are kept in double so that moving a child can subtract its old contribution and add the new one
+	dgMatrix shapeInertia (collision->CalculateInertia());
+	dgFloat64 shapeVolume = sign * collision->GetVolume();
+
+	m_massVolume += shapeVolume;
+	m_massOrigin += dgBigVector (shapeInertia.m_posit).Scale (shapeVolume);
+	m_massInertiaII += dgBigVector (shapeInertia[0][0], shapeInertia[1][1], shapeInertia[2][2], dgFloat64 (0.0f)).Scale (shapeVolume);
+	m_massInertiaIJ += dgBigVector (shapeInertia[1][2], shapeInertia[0][2], shapeInertia[0][1], dgFloat64 (0.0f)).Scale (shapeVolume);
+}
+
+void dgCollisionCompound::ApplyMassProperties ()
+{
+	if (m_massVolume > dgFloat64 (0.0f)) { 
+		dgFloat64 invVolume = dgFloat64 (1.0f) / m_massVolume;
+		m_inertia = dgVector (m_massInertiaII.Scale (invVolume));
+		m_crossInertia = dgVector (m_massInertiaIJ.Scale (invVolume));
+		m_centerOfMass = dgVector (m_massOrigin.Scale (invVolume));
+		m_centerOfMass.m_w = dgFloat32 (m_massVolume);
 	}
 
 	dgCollision::MassProperties ();
@@ -874,6 +954,7 @@ void dgCollisionCompound::ApplyScale (const dgVector& scale)
 		collision->SetGlobalScale (scale);
 	}
 	m_treeEntropy = dgFloat32 (0.0f);
+	m_structureChanged = 1;
 	EndAddRemove ();
 }
 
@@ -994,62 +1075,13 @@ void dgCollisionCompound::EndAddRemove (bool flushCache)
 		//dgThreadHiveScopeLock lock (world, &m_criticalSectionLock);
 		dgScopeSpinLock lock(&m_criticalSectionLock);
 
-		dgTreeArray::Iterator iter (m_array);
-		for (iter.Begin(); iter; iter ++) {
-			dgNodeBase* const node = iter.GetNode()->GetInfo();
-			node->CalculateAABB();
-		}
-
-		dgList<dgNodeBase*> list (GetAllocator());
-		dgList<dgNodeBase*> stack (GetAllocator());
-		stack.Append(m_root);
-		while (stack.GetCount()) {
-			dgList<dgNodeBase*>::dgListNode* const stackNode = stack.GetLast();
-			dgNodeBase* const node = stackNode->GetInfo();
-			stack.Remove(stackNode);
-
-			//if (node->m_type == m_node) {
-			//	list.Append(node);
-			//}
-
-			if (node->m_type == m_node) {
-				list.Append(node);
-				stack.Append(node->m_right);
-				stack.Append(node->m_left);
-			} 
-		}
-
-		if (list.GetCount()) {
-			dgFloat64 cost = CalculateEntropy (list);
-			if ((cost > m_treeEntropy * dgFloat32 (2.0f)) || (cost < m_treeEntropy * dgFloat32 (0.5f))) {
-				dgInt32 count = list.GetCount() * 2 + 12;
-				dgInt32 leafNodesCount = 0;
-				dgStack<dgNodeBase*> leafArray(count);
-				for (dgList<dgNodeBase*>::dgListNode* listNode = list.GetFirst(); listNode; listNode = listNode->GetNext()) {
-					dgNodeBase* const node = listNode->GetInfo();
-					if (node->m_left->m_type == m_leaf) {
-						leafArray[leafNodesCount] = node->m_left;
-						leafNodesCount ++;
-					}
-					if (node->m_right->m_type == m_leaf) {
-						leafArray[leafNodesCount] = node->m_right;
-						leafNodesCount ++;
-					}
-				}
-
-				dgList<dgNodeBase*>::dgListNode* nodePtr = list.GetFirst();
-				
-				dgSortIndirect (&leafArray[0], leafNodesCount, CompareNodes); 
-				
-				m_root = BuildTopDownBig (&leafArray[0], 0, leafNodesCount - 1, &nodePtr);
-				m_treeEntropy = CalculateEntropy (list);
-			}
-			while (m_root->m_parent) {
-				m_root = m_root->m_parent;
-			}
+		if (RefitDirtyNodes()) {
+			ApplyMassProperties ();
 		} else {
-			m_treeEntropy = dgFloat32 (2.0f);
+			FullRefit ();
 		}
+		m_dirtyNodes.RemoveAll();
+		m_structureChanged = 0;
 
 		dgAssert (m_root->m_size.m_w == dgFloat32 (0.0f));
 		m_boxMinRadius = dgMin(m_root->m_size.m_x, m_root->m_size.m_y, m_root->m_size.m_z);
@@ -1057,7 +1089,6 @@ void dgCollisionCompound::EndAddRemove (bool flushCache)
 
 		m_boxSize = m_root->m_size;
 		m_boxOrigin = m_root->m_origin;
-		MassProperties ();
 
 		if (flushCache) {
 			m_world->FlushCache ();
@@ -1065,12 +1096,126 @@ void dgCollisionCompound::EndAddRemove (bool flushCache)
 	}
 }
 
+void dgCollisionCompound::FullRefit ()
+{
+	dgTreeArray::Iterator iter (m_array);
+	for (iter.Begin(); iter; iter ++) {
+		dgNodeBase* const node = iter.GetNode()->GetInfo();
+		node->CalculateAABB();
+	}
+
+	dgList<dgNodeBase*> list (GetAllocator());
+	dgList<dgNodeBase*> stack (GetAllocator());
+	stack.Append(m_root);
+	while (stack.GetCount()) {
+		dgList<dgNodeBase*>::dgListNode* const stackNode = stack.GetLast();
+		dgNodeBase* const node = stackNode->GetInfo();
+		stack.Remove(stackNode);
+
+		//if (node->m_type == m_node) {
+		//	list.Append(node);
+		//}
+
+		if (node->m_type == m_node) {
+			list.Append(node);
+			stack.Append(node->m_right);
+			stack.Append(node->m_left);
+		} 
+	}
+
+	if (list.GetCount()) {
+		dgFloat64 cost = CalculateEntropy (list);
+		if ((cost > m_treeEntropy * dgFloat32 (2.0f)) || (cost < m_treeEntropy * dgFloat32 (0.5f))) {
+			dgInt32 count = list.GetCount() * 2 + 12;
+			dgInt32 leafNodesCount = 0;
+			dgStack<dgNodeBase*> leafArray(count);
+			for (dgList<dgNodeBase*>::dgListNode* listNode = list.GetFirst(); listNode; listNode = listNode->GetNext()) {
+				dgNodeBase* const node = listNode->GetInfo();
+				if (node->m_left->m_type == m_leaf) {
+					leafArray[leafNodesCount] = node->m_left;
+					leafNodesCount ++;
+				}
+				if (node->m_right->m_type == m_leaf) {
+					leafArray[leafNodesCount] = node->m_right;
+					leafNodesCount ++;
+				}
+			}
+
+			dgList<dgNodeBase*>::dgListNode* nodePtr = list.GetFirst();
+			
+			dgSortIndirect (&leafArray[0], leafNodesCount, CompareNodes); 
+			
+			m_root = BuildTopDownBig (&leafArray[0], 0, leafNodesCount - 1, &nodePtr);
+			m_treeEntropy = CalculateEntropy (list);
+			cost = m_treeEntropy;
+		}
+		m_treeCost = cost;
+		while (m_root->m_parent) {
+			m_root = m_root->m_parent;
+		}
+	} else {
+		m_treeEntropy = dgFloat32 (2.0f);
+		m_treeCost = dgFloat32 (0.0f);
+	}
+	MassProperties ();
+}
+
+bool dgCollisionCompound::RefitDirtyNodes ()
+{
+	if (m_structureChanged) {
+		return false;
+	}
+
+	// tight refit from every moved child to the root, then a few local rotations along the same paths, 
+	// the full rebuild only happens when the tree cost drifts out of the band EndAddRemove tolerates
+	for (dgList<dgNodeBase*>::dgListNode* node = m_dirtyNodes.GetFirst(); node; node = node->GetNext()) {
+		RefitParents (node->GetInfo(), false);
+	}
+	for (dgList<dgNodeBase*>::dgListNode* node = m_dirtyNodes.GetFirst(); node; node = node->GetNext()) {
+		ImproveParentsFitness (node->GetInfo());
+	}
+	while (m_root->m_parent) {
+		m_root = m_root->m_parent;
+	}
+
+	return (m_treeCost <= m_treeEntropy * dgFloat32 (2.0f)) && (m_treeCost >= m_treeEntropy * dgFloat32 (0.5f));
+}
+
+void dgCollisionCompound::RefitParents (dgNodeBase* const node, bool stopAtInclusion)
+{
+	for (dgNodeBase* parent = node->m_parent; parent; parent = parent->m_parent) {
+		dgVector minBox;
+		dgVector maxBox;
+		dgFloat32 area = CalculateSurfaceArea (parent->m_left, parent->m_right, minBox, maxBox);
+		if (stopAtInclusion && dgBoxInclusionTest (minBox, maxBox, parent->m_p0, parent->m_p1)) {
+			break;
+		}
+		m_treeCost += area - parent->m_area;
+		parent->SetBox (minBox, maxBox);
+	}
+}
+
+void dgCollisionCompound::ImproveParentsFitness (dgNodeBase* const node)
+{
+	for (dgNodeBase* parent = node->m_parent; parent; parent = parent->m_parent) {
+		dgNodeBase* const grandParent = parent->m_parent;
+		if (grandParent) {
+			// a rotation only changes the boxes of the node and its old parent
+			dgFloat32 area0 = parent->m_area + grandParent->m_area;
+			ImproveNodeFitness (parent);
+			m_treeCost += parent->m_area + grandParent->m_area - area0;
+		}
+	}
+}
+
 dgTree<dgCollisionCompound::dgNodeBase*, dgInt32>::dgTreeNode* dgCollisionCompound::AddCollision (dgCollisionInstance* const shape)
 {
 	dgNodeBase* const newNode = new (m_allocator) dgNodeBase (shape);
 	m_array.AddNode(newNode, m_idIndex, m_myInstance);
 
 	m_idIndex ++;
+	m_structureChanged = 1;
+	m_dirtyNodes.RemoveAll();
 
 	if (!m_root) {
 		m_root = newNode;
@@ -1148,6 +1293,13 @@ void dgCollisionCompound::SetCollisionMatrix (dgTreeArray::dgTreeNode* const nod
 		dgNodeBase* const baseNode = node->GetInfo();
 		dgCollisionInstance* const instance = baseNode->GetShape();
 
+		//dgThreadHiveScopeLock lock (world, &m_criticalSectionLock);
+		dgScopeSpinLock lock(&m_criticalSectionLock);
+
+		if (!m_structureChanged) {
+			AddChildMassProperties (instance, dgFloat64 (-1.0f));
+		}
+
 		dgVector scale;
 		dgMatrix localMatrix;
 		matrix.PolarDecomposition(localMatrix, scale, instance->m_aligmentMatrix);
@@ -1159,19 +1311,18 @@ void dgCollisionCompound::SetCollisionMatrix (dgTreeArray::dgTreeNode* const nod
 		dgVector p0;
 		dgVector p1;
 		instance->CalcAABB(instance->GetLocalMatrix (), p0, p1);
-		
-		//dgThreadHiveScopeLock lock (world, &m_criticalSectionLock);
-		dgScopeSpinLock lock(&m_criticalSectionLock);
 
 		baseNode->SetBox (p0, p1);
-		for (dgNodeBase* parent = baseNode->m_parent; parent; parent = parent->m_parent) {
-			dgVector minBox;
-			dgVector maxBox;
-			CalculateSurfaceArea (parent->m_left, parent->m_right, minBox, maxBox);
-			if (dgBoxInclusionTest (minBox, maxBox, parent->m_p0, parent->m_p1)) {
-				break;
+		RefitParents (baseNode, true);
+
+		if (!m_structureChanged) {
+			AddChildMassProperties (instance, dgFloat64 (1.0f));
+			m_dirtyNodes.Append (baseNode);
+			if (m_dirtyNodes.GetCount() > m_array.GetCount()) {
+				// moving that many children is cheaper to resolve with a full refit
+				m_structureChanged = 1;
+				m_dirtyNodes.RemoveAll();
 			}
-			parent->SetBox (minBox, maxBox);
 		}
 	}
 }
@@ -1179,6 +1330,8 @@ void dgCollisionCompound::SetCollisionMatrix (dgTreeArray::dgTreeNode* const nod
 
 void dgCollisionCompound::RemoveCollision (dgNodeBase* const treeNode)
 {
+	m_structureChanged = 1;
+	m_dirtyNodes.RemoveAll();
 	if (!treeNode->m_parent) {
 		delete (m_root);
 		m_root = NULL;
@@ -1549,6 +1702,8 @@ dgInt32 dgCollisionCompound::CalculateContacts (dgBroadPhase::dgPair* const pair
 //				contactCount = CalculateContactsUserDefinedCollision (pair, proxy);
 			}
 
+		} else if (pair->m_splitChildPairs && !proxy.m_intersectionTestOnly) {
+			contactCount = CalculateContactsSplit (pair, proxy);
 		} else {
 			if (body1->m_collision->IsType (dgCollision::dgCollisionConvexShape_RTTI)) {
 				contactCount = CalculateContactsToSingle (pair, proxy);
@@ -1569,6 +1724,166 @@ dgInt32 dgCollisionCompound::CalculateContacts (dgBroadPhase::dgPair* const pair
 }
 
 
+bool dgCollisionCompound::SplitChildPairs (const dgCollisionInstance* const instance0, const dgCollisionInstance* const instance1)
+{
+	const dgCollisionInstance* compoundInstance = instance0;
+	const dgCollisionInstance* otherInstance = instance1;
+	if (!compoundInstance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		dgSwap (compoundInstance, otherInstance);
+	}
+	if (!compoundInstance->IsType (dgCollision::dgCollisionCompound_RTTI) || compoundInstance->IsType (dgCollision::dgCollisionScene_RTTI) || otherInstance->IsType (dgCollision::dgCollisionScene_RTTI)) {
+		return false;
+	}
+
+	const dgCollisionCompound* const compound = (dgCollisionCompound*)compoundInstance->GetChildShape();
+	const dgInt32 childCount = compound->m_array.GetCount();
+	if (otherInstance->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		const dgCollisionCompound* const otherCompound = (dgCollisionCompound*)otherInstance->GetChildShape();
+		return dgMax (childCount, otherCompound->m_array.GetCount()) >= DG_COMPOUND_SPLIT_CHILD_COUNT;
+	} else if (otherInstance->IsType (dgCollision::dgCollisionBVH_RTTI) || otherInstance->IsType (dgCollision::dgCollisionHeightField_RTTI)) {
+		return childCount >= DG_COMPOUND_SPLIT_CHILD_COUNT;
+	}
+	return false;
+}
+
+dgInt32 dgCollisionCompound::CalculateContactsSplit (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const
+{
+	dgContact* const contactJoint = pair->m_contact;
+	dgBody* const otherBody = contactJoint->GetBody1();
+
+	// collect the overlapping child pairs, the material callbacks still run on this thread
+	dgChildPairContext context (this, &proxy);
+	if (otherBody->m_collision->IsType (dgCollision::dgCollisionCompound_RTTI)) {
+		CalculateContactsToCompound (pair, proxy, &context);
+	} else if (otherBody->m_collision->IsType (dgCollision::dgCollisionBVH_RTTI)) {
+		CalculateContactsToCollisionTree (pair, proxy, &context);
+	} else {
+		dgAssert (otherBody->m_collision->IsType (dgCollision::dgCollisionHeightField_RTTI));
+		CalculateContactsToHeightField (pair, proxy, &context);
+	}
+
+	const dgInt32 threadCount = m_world->GetThreadCount();
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		m_world->QueueJob (CalculateChildPairContactsKernel, &context, m_world, "dgCollisionCompound::CalculateChildPairContacts");
+	}
+	m_world->SynchronizationBarrier();
+
+	// merge in traversal order, so the result does not depend on which thread did each pair
+	dgContactPoint* const contacts = proxy.m_contacts;
+	dgInt32 contactCount = 0;
+	dgFloat32 closestDist = dgFloat32 (1.0e10f);
+	for (dgInt32 i = 0; i < context.m_count; i ++) {
+		const dgChildPair& childPair = context.m_pairs[i];
+		closestDist = dgMin(closestDist, childPair.m_closestDistance);
+		if (childPair.m_isActive) {
+			contactJoint->m_isActive = 1;
+		}
+		if (childPair.m_contactCount) {
+			if ((contactCount + childPair.m_contactCount) > DG_MAX_CONTATCS) {
+				contactCount = m_world->PruneContacts(contactCount, contacts, contactJoint->GetPruningTolerance(), 16);
+			}
+			const dgContactPoint* const childContacts = &context.m_contacts[childPair.m_threadIndex][childPair.m_contactStart];
+			for (dgInt32 j = 0; j < childPair.m_contactCount; j ++) {
+				contacts[contactCount + j] = childContacts[j];
+			}
+			contactCount += childPair.m_contactCount;
+			if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
+				contactCount = m_world->PruneContacts(contactCount, contacts, contactJoint->GetPruningTolerance(), 16);
+			}
+		}
+	}
+
+	if (context.m_count) {
+		const dgChildPair& lastPair = context.m_pairs[context.m_count - 1];
+		contactJoint->m_separtingVector = lastPair.m_separatingVector;
+		contactJoint->m_isNewContact = lastPair.m_isNewContact;
+	}
+	contactJoint->m_closestDistance = closestDist;
+	proxy.m_contacts = contacts;
+	return contactCount;
+}
+
+void dgCollisionCompound::CalculateChildPairContactsKernel (void* const context, void* const, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgChildPairContext* const data = (dgChildPairContext*) context;
+	data->m_me->CalculateChildPairContacts (data, threadID);
+}
+
+void dgCollisionCompound::CalculateChildPairContacts (dgChildPairContext* const context, dgInt32 threadID) const
+{
+	dgContactPoint contacts[DG_MAX_CONTATCS];
+	const dgCollisionParamProxy& pairProxy = *context->m_proxy;
+	const dgContact* const contactJoint = pairProxy.m_contactJoint;
+
+	// each thread works on its own copy of the joint collision state
+	dgContact scratchJoint (contactJoint, m_allocator);
+
+	const dgMatrix& myMatrix = pairProxy.m_body0->m_collision->GetGlobalMatrix();
+	const dgMatrix& otherMatrix = pairProxy.m_body1->m_collision->GetGlobalMatrix();
+	dgArray<dgContactPoint>& contactBuffer = context->m_contacts[threadID];
+	dgInt32& contactBufferCount = context->m_contactCount[threadID];
+
+	const dgInt32 count = context->m_count;
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&context->m_atomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd(&context->m_atomicIndex, 1)) {
+		dgChildPair& childPair = context->m_pairs[i];
+
+		scratchJoint.m_separtingVector = contactJoint->m_separtingVector;
+		scratchJoint.m_isNewContact = contactJoint->m_isNewContact;
+		scratchJoint.m_isActive = contactJoint->m_isActive;
+
+		dgCollisionParamProxy proxy (pairProxy);
+		proxy.m_contactJoint = &scratchJoint;
+		proxy.m_contacts = contacts;
+		proxy.m_polyMeshData = NULL;
+		proxy.m_threadIndex = threadID;
+		proxy.m_maxContacts = DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3);
+
+		const dgCollisionInstance* const subShape = childPair.m_myNode->GetShape();
+		dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
+		childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * myMatrix;
+		proxy.m_instance0 = &childInstance; 
+
+		dgInt32 contactCount = 0;
+		if (childPair.m_otherNode) {
+			const dgCollisionInstance* const otherSubShape = childPair.m_otherNode->GetShape();
+			dgCollisionInstance otherChildInstance (*otherSubShape, otherSubShape->GetChildShape());
+			otherChildInstance.m_globalMatrix = otherChildInstance.GetLocalMatrix() * otherMatrix;
+			proxy.m_instance1 = &otherChildInstance; 
+
+			contactCount = m_world->CalculateConvexToConvexContacts (proxy);
+			for (dgInt32 j = 0; j < contactCount; j ++) {
+				dgAssert (contacts[j].m_collision0 == &childInstance);
+				dgAssert (contacts[j].m_collision1 == &otherChildInstance);
+				contacts[j].m_collision0 = subShape;
+				contacts[j].m_collision1 = otherSubShape;
+			}
+			otherChildInstance.m_material.m_userData = NULL;
+		} else {
+			contactCount = m_world->CalculateConvexToNonConvexContacts (proxy);
+			for (dgInt32 j = 0; j < contactCount; j ++) {
+				dgAssert (contacts[j].m_collision0 == &childInstance);
+				contacts[j].m_collision0 = subShape;
+			}
+		}
+		childInstance.m_material.m_userData = NULL;
+
+		childPair.m_separatingVector = scratchJoint.m_separtingVector;
+		childPair.m_closestDistance = scratchJoint.m_closestDistance;
+		childPair.m_isActive = scratchJoint.m_isActive;
+		childPair.m_isNewContact = scratchJoint.m_isNewContact;
+		childPair.m_threadIndex = threadID;
+		childPair.m_contactStart = contactBufferCount;
+		childPair.m_contactCount = contactCount;
+
+		contactBuffer.ResizeIfNecessary(contactBufferCount + contactCount);
+		for (dgInt32 j = 0; j < contactCount; j ++) {
+			contactBuffer[contactBufferCount + j] = contacts[j];
+		}
+		contactBufferCount += contactCount;
+	}
+}
+
 dgInt32 dgCollisionCompound::ClosestDistance (dgCollisionParamProxy& proxy) const
 {
 	int count = 0;
@@ -1752,7 +2067,7 @@ dgInt32 dgCollisionCompound::ClosestDistanceToCompound (dgCollisionParamProxy& p
 
 
 
-dgInt32 dgCollisionCompound::CalculateContactsToCompound (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const
+dgInt32 dgCollisionCompound::CalculateContactsToCompound (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs) const
 {
 	dgContactPoint* const contacts = proxy.m_contacts;
 	const dgNodeBase* stackPool[4 * DG_COMPOUND_STACK_DEPTH][2];
@@ -1801,43 +2116,47 @@ dgInt32 dgCollisionCompound::CalculateContactsToCompound (dgBroadPhase::dgPair*
 				}
 				if (processContacts) {
 					if (me->GetShape()->GetCollisionMode() & other->GetShape()->GetCollisionMode()) {
-						const dgCollisionInstance* const subShape = me->GetShape();
-						const dgCollisionInstance* const otherSubShape = other->GetShape();
+						if (childPairs) {
+							childPairs->AddPair (me, other);
+						} else {
+							const dgCollisionInstance* const subShape = me->GetShape();
+							const dgCollisionInstance* const otherSubShape = other->GetShape();
 
-						dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
-						childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * myMatrix;
-						proxy.m_instance0 = &childInstance; 
+							dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
+							childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * myMatrix;
+							proxy.m_instance0 = &childInstance; 
 
-						dgCollisionInstance otherChildInstance (*otherSubShape, otherSubShape->GetChildShape());
-						otherChildInstance.m_globalMatrix = otherChildInstance.GetLocalMatrix() * otherMatrix;
-						proxy.m_instance1 = &otherChildInstance; 
+							dgCollisionInstance otherChildInstance (*otherSubShape, otherSubShape->GetChildShape());
+							otherChildInstance.m_globalMatrix = otherChildInstance.GetLocalMatrix() * otherMatrix;
+							proxy.m_instance1 = &otherChildInstance; 
 
-						proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
-						proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
+							proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
+							proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
 
-						dgInt32 count = m_world->CalculateConvexToConvexContacts (proxy);
-						closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
+							dgInt32 count = m_world->CalculateConvexToConvexContacts (proxy);
+							closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
 
-						if (!proxy.m_intersectionTestOnly) {
-							for (dgInt32 i = 0; i < count; i ++) {
-								dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
-								dgAssert (contacts[contactCount + i].m_collision1 == &otherChildInstance);
-								contacts[contactCount + i].m_collision0 = subShape;
-								contacts[contactCount + i].m_collision1 = otherSubShape;
-							}
-							contactCount += count;
-							if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
-								contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+							if (!proxy.m_intersectionTestOnly) {
+								for (dgInt32 i = 0; i < count; i ++) {
+									dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
+									dgAssert (contacts[contactCount + i].m_collision1 == &otherChildInstance);
+									contacts[contactCount + i].m_collision0 = subShape;
+									contacts[contactCount + i].m_collision1 = otherSubShape;
+								}
+								contactCount += count;
+								if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
+									contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+								}
+							} else if (count == -1) {
+								contactCount = -1;
+								break;
 							}
-						} else if (count == -1) {
-							contactCount = -1;
-							break;
-						}
-						childInstance.m_material.m_userData = NULL;
-						otherChildInstance.m_material.m_userData = NULL;
+							childInstance.m_material.m_userData = NULL;
+							otherChildInstance.m_material.m_userData = NULL;
 
-						proxy.m_instance0 = NULL;
-						proxy.m_instance1 = NULL; 
+							proxy.m_instance0 = NULL;
+							proxy.m_instance1 = NULL; 
+						}
 					}
 				}
 
@@ -1900,7 +2219,7 @@ dgInt32 dgCollisionCompound::CalculateContactsToCompound (dgBroadPhase::dgPair*
 	return contactCount;
 }
 
-dgInt32 dgCollisionCompound::CalculateContactsToHeightField (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const
+dgInt32 dgCollisionCompound::CalculateContactsToHeightField (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs) const
 {
 	dgContactPoint* const contacts = proxy.m_contacts;
 
@@ -1963,33 +2282,37 @@ dgInt32 dgCollisionCompound::CalculateContactsToHeightField (dgBroadPhase::dgPai
 						processContacts = material->m_compoundAABBOverlap (*contactJoint, timestep, myBody, me->m_myNode, terrainBody, NULL, proxy.m_threadIndex);
 					}
 					if (processContacts) {
-						dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
-						childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * compoundMatrix;
-						proxy.m_instance0 = &childInstance; 
+						if (childPairs) {
+							childPairs->AddPair (me, NULL);
+						} else {
+							dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
+							childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * compoundMatrix;
+							proxy.m_instance0 = &childInstance; 
 
-						proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
-						proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
+							proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
+							proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
 
-						dgInt32 count = 0;
-						count += m_world->CalculateConvexToNonConvexContacts (proxy);
-						closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
+							dgInt32 count = 0;
+							count += m_world->CalculateConvexToNonConvexContacts (proxy);
+							closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
 
-						if (!proxy.m_intersectionTestOnly) {
-							for (dgInt32 i = 0; i < count; i ++) {
-								dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
-								contacts[contactCount + i].m_collision0 = subShape;
-							}
-							contactCount += count;
+							if (!proxy.m_intersectionTestOnly) {
+								for (dgInt32 i = 0; i < count; i ++) {
+									dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
+									contacts[contactCount + i].m_collision0 = subShape;
+								}
+								contactCount += count;
 
-							if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
-								contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+								if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
+									contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+								}
+							} else if (count == -1) {
+								contactCount = -1;
+								break;
 							}
-						} else if (count == -1) {
-							contactCount = -1;
-							break;
+							childInstance.m_material.m_userData = NULL;
+							proxy.m_instance0 = NULL;
 						}
-						childInstance.m_material.m_userData = NULL;
-						proxy.m_instance0 = NULL;
 					}
 				}
 
@@ -2210,7 +2533,7 @@ dgInt32 dgCollisionCompound::CalculateContactsToSingle (dgBroadPhase::dgPair* co
 }
 
 
-dgInt32 dgCollisionCompound::CalculateContactsToCollisionTree (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const
+dgInt32 dgCollisionCompound::CalculateContactsToCollisionTree (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs) const
 {
 	dgContactPoint* const contacts = proxy.m_contacts;
 
@@ -2284,33 +2607,37 @@ dgInt32 dgCollisionCompound::CalculateContactsToCollisionTree (dgBroadPhase::dgP
 						processContacts = material->m_compoundAABBOverlap (*contactJoint, timestep, myBody, me->m_myNode, treeBody, NULL, proxy.m_threadIndex);
 					}
 					if (processContacts) {
-						dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
-						childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * myMatrix;
-						proxy.m_instance0 = &childInstance; 
+						if (childPairs) {
+							childPairs->AddPair (me, NULL);
+						} else {
+							dgCollisionInstance childInstance (*subShape, subShape->GetChildShape());
+							childInstance.m_globalMatrix = childInstance.GetLocalMatrix() * myMatrix;
+							proxy.m_instance0 = &childInstance; 
 
-						proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
-						proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
+							proxy.m_maxContacts = DG_MAX_CONTATCS - contactCount;
+							proxy.m_contacts = contacts ? &contacts[contactCount] : contacts;
 
-						dgInt32 count = m_world->CalculateConvexToNonConvexContacts (proxy);
-						closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
+							dgInt32 count = m_world->CalculateConvexToNonConvexContacts (proxy);
+							closestDist = dgMin(closestDist, contactJoint->m_closestDistance);
 
-						if (!proxy.m_intersectionTestOnly) {
-							for (dgInt32 i = 0; i < count; i ++) {
-								dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
-								contacts[contactCount + i].m_collision0 = subShape;
-							}
-							contactCount += count;
-							if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
-								contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+							if (!proxy.m_intersectionTestOnly) {
+								for (dgInt32 i = 0; i < count; i ++) {
+									dgAssert (contacts[contactCount + i].m_collision0 == &childInstance);
+									contacts[contactCount + i].m_collision0 = subShape;
+								}
+								contactCount += count;
+								if (contactCount > (DG_MAX_CONTATCS - 2 * (DG_CONSTRAINT_MAX_ROWS / 3))) {
+									contactCount = m_world->PruneContacts(contactCount, contacts, proxy.m_contactJoint->GetPruningTolerance(), 16);
+								}
+							} else if (count == -1) {
+								contactCount = -1;
+								break;
 							}
-						} else if (count == -1) {
-							contactCount = -1;
-							break;
-						}
-						//childInstance.SetUserData(NULL);
+							//childInstance.SetUserData(NULL);
 
-						childInstance.m_material.m_userData = NULL;
-						proxy.m_instance0 = NULL; 
+							childInstance.m_material.m_userData = NULL;
+							proxy.m_instance0 = NULL; 
+						}
 					}
 				}
 
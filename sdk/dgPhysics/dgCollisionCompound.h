@@ -30,7 +30,8 @@ class dgCollisionBVH;
 class dgCollisionInstance;
 
 
-#define DG_COMPOUND_STACK_DEPTH	256
+#define DG_COMPOUND_STACK_DEPTH			256
+#define DG_COMPOUND_SPLIT_CHILD_COUNT	32
 
 class dgCollisionCompound: public dgCollision
 {
@@ -132,6 +133,8 @@ class dgCollisionCompound: public dgCollision
 
 	class dgSpliteInfo;
 	class dgHeapNodePair;
+	class dgChildPair;
+	class dgChildPairContext;
 
 	public:
 	dgCollisionCompound (dgWorld* const world);
@@ -157,6 +160,8 @@ class dgCollisionCompound: public dgCollision
 	dgTreeArray::dgTreeNode* GetNextNode (dgTreeArray::dgTreeNode* const node) const;
 	dgCollisionInstance* GetCollisionFromNode (dgTreeArray::dgTreeNode* const node) const;
 
+	static bool SplitChildPairs (const dgCollisionInstance* const instance0, const dgCollisionInstance* const instance1);
+
 	protected:
 	void RemoveCollision (dgNodeBase* const node);
 	virtual dgFloat32 GetVolume () const;
@@ -172,6 +177,8 @@ class dgCollisionCompound: public dgCollision
 	static void CalculateInertia (void* userData, int vertexCount, const dgFloat32* const FaceArray, int faceId);
 
 	virtual void MassProperties ();
+	virtual void ApplyMassProperties ();
+	void AddChildMassProperties (const dgCollisionInstance* const collision, dgFloat64 sign);
 	dgMatrix CalculateInertiaAndCenterOfMass (const dgMatrix& m_alignMatrix, const dgVector& localScale, const dgMatrix& matrix) const;
 	dgFloat32 CalculateMassProperties (const dgMatrix& offset, dgVector& inertia, dgVector& crossInertia, dgVector& centerOfMass) const;
 	virtual dgVector CalculateVolumeIntegral (const dgMatrix& globalMatrix, const dgVector& plane, const dgCollisionInstance& parentScale) const;
@@ -187,11 +194,13 @@ class dgCollisionCompound: public dgCollision
 
 	dgInt32 CalculateContactsToSingle (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
 	dgInt32 CalculateContactsToSingleContinue (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
-	dgInt32 CalculateContactsToCompound (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
+	dgInt32 CalculateContactsToCompound (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs = NULL) const;
 	dgInt32 CalculateContactsToCompoundContinue (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
-	dgInt32 CalculateContactsToCollisionTree (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
+	dgInt32 CalculateContactsToCollisionTree (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs = NULL) const;
 	dgInt32 CalculateContactsToCollisionTreeContinue (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
-	dgInt32 CalculateContactsToHeightField (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
+	dgInt32 CalculateContactsToHeightField (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy, dgChildPairContext* const childPairs = NULL) const;
+	dgInt32 CalculateContactsSplit (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
+	void CalculateChildPairContacts (dgChildPairContext* const context, dgInt32 threadID) const;
 	dgInt32 CalculateContactsUserDefinedCollision (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
 	dgInt32 ClosestDistance (dgCollisionParamProxy& proxy) const;
 	dgInt32 ClosestDistanceToConvex (dgCollisionParamProxy& proxy) const;
@@ -205,6 +214,10 @@ class dgCollisionCompound: public dgCollision
 	dgNodeBase* BuildTopDownBig (dgNodeBase** const leafArray, dgInt32 firstBox, dgInt32 lastBox, dgList<dgNodeBase*>::dgListNode** const nextNode);
 
 	dgFloat64 CalculateEntropy (dgList<dgNodeBase*>& list);
+	void FullRefit ();
+	bool RefitDirtyNodes ();
+	void RefitParents (dgNodeBase* const node, bool stopAtInclusion);
+	void ImproveParentsFitness (dgNodeBase* const node);
 
 	void ImproveNodeFitness (dgNodeBase* const node) const;
 	DG_INLINE dgFloat32 CalculateSurfaceArea (dgNodeBase* const node0, dgNodeBase* const node1, dgVector& minBox, dgVector& maxBox) const;
@@ -214,17 +227,25 @@ class dgCollisionCompound: public dgCollision
 	void PushNode (const dgMatrix& matrix, dgUpHeap<dgHeapNodePair, dgFloat32>& heap, dgNodeBase* const myNode, dgNodeBase* const otehrNode) const;
 
 	static dgInt32 CompareNodes (const dgNodeBase* const nodeA, const dgNodeBase* const nodeB, void* notUsed);
+	static void CalculateChildPairContactsKernel (void* const context, void* const worldContext, dgInt32 threadID);
 
 
 	dgWorld* m_world;	
 	dgNodeBase* m_root;
 	const dgCollisionInstance* m_myInstance;
 	dgTreeArray m_array;
+	dgList<dgNodeBase*> m_dirtyNodes;
+	dgBigVector m_massOrigin;
+	dgBigVector m_massInertiaII;
+	dgBigVector m_massInertiaIJ;
+	dgFloat64 m_massVolume;
 	dgFloat64 m_treeEntropy;
+	dgFloat64 m_treeCost;
 	dgFloat32 m_boxMinRadius;
 	dgFloat32 m_boxMaxRadius;
 	dgInt32 m_idIndex;
 	dgInt32 m_criticalSectionLock;
+	dgInt32 m_structureChanged;
 
 	static dgVector m_padding;
 	friend class dgBody;
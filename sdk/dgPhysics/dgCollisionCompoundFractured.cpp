@@ -968,7 +968,18 @@ dgCollisionCompoundFractured::dgCollisionCompoundFractured (dgWorld* const world
 	:dgCollisionCompound (world, deserialization, userData, myInstance, revisionNumber)
 	,m_conectivity (world->GetAllocator())
 	,m_conectivityMap (world->GetAllocator())
+	,m_vertexBuffer(NULL)
+	,m_impulseStrengthPerUnitMass(10.0f)
+	,m_impulseAbsortionFactor(0.5f)
+	,m_density(dgFloat32 (-1.0f))
+	,m_lru(0)
+	,m_materialCount(0)
+	,m_emitFracturedChunk(NULL) 
+	,m_emitFracturedCompound(NULL)
+	,m_reconstructMainMesh(NULL)
 {
+	m_rtti |= dgCollisionCompoundBreakable_RTTI;
+
 	m_conectivity.Deserialize(this, deserialization, userData);
 	m_vertexBuffer = new (m_world->GetAllocator()) dgVertexBuffer(m_world->GetAllocator(), deserialization, userData);
 
@@ -976,6 +987,8 @@ dgCollisionCompoundFractured::dgCollisionCompoundFractured (dgWorld* const world
 	deserialization (userData, &m_impulseAbsortionFactor, sizeof (m_impulseAbsortionFactor));
 	deserialization (userData, &m_density, sizeof (m_density));
 	deserialization (userData, &m_materialCount, sizeof (m_materialCount));
+
+	m_conectivityMap.Pupolate(m_conectivity);
 }
 
 
@@ -1336,7 +1349,18 @@ void dgCollisionCompoundFractured::RemoveCollision (dgTreeArray::dgTreeNode* con
 	dgAssert (mapNode);
 
 	dgConectivityGraph::dgListNode* const chunkNode = mapNode->GetInfo();
+	ExposeChunkFaces (chunkNode);
+
+	dgDebriNodeInfo& nodeInfo = chunkNode->GetInfo().m_nodeData;
+	dgCollisionInstance* const chunkCollision = nodeInfo.m_shapeNode->GetInfo()->GetShape();
+
+	m_conectivityMap.Remove (chunkCollision);
+	m_conectivity.DeleteNode(chunkNode);
+	dgCollisionCompound::RemoveCollision (node);
+}
 
+void dgCollisionCompoundFractured::ExposeChunkFaces (dgConectivityGraph::dgListNode* const chunkNode) const
+{
 	for (dgGraphNode<dgDebriNodeInfo, dgSharedNodeMesh>::dgListNode* edgeNode = chunkNode->GetInfo().GetFirst(); edgeNode; edgeNode = edgeNode->GetNext()) {
 		dgConectivityGraph::dgListNode* const node1 = edgeNode->GetInfo().m_node;
 		dgDebriNodeInfo& childNodeInfo = node1->GetInfo().m_nodeData;
@@ -1346,13 +1370,66 @@ void dgCollisionCompoundFractured::RemoveCollision (dgTreeArray::dgTreeNode* con
 			subMesh->m_visibleFaces = true;
 		}
 	}
+}
 
-	dgDebriNodeInfo& nodeInfo = chunkNode->GetInfo().m_nodeData;
-	dgCollisionInstance* const chunkCollision = nodeInfo.m_shapeNode->GetInfo()->GetShape();
+dgInt32 dgCollisionCompoundFractured::DetachChunks (dgBody* const myBody, dgTreeArray::dgTreeNode** const nodes, dgInt32 count)
+{
+	dgCollisionInstance* const myInstance = myBody->GetCollision();
+	dgAssert (myInstance->GetLodShape(0) == this);
 
-	m_conectivityMap.Remove (chunkCollision);
-	m_conectivity.DeleteNode(chunkNode);
-	dgCollisionCompound::RemoveCollision (node);
+	dgVector massMatrix (myBody->GetMass());
+	if (m_density < dgFloat32 (0.0f)) {
+		m_density = dgAbs (massMatrix.m_w * m_density);
+	}
+
+	m_lru ++;
+	dgInt32 chunkCount = 0;
+	dgStack<dgConectivityGraph::dgListNode*> chunks (dgMax (count, 1));
+	for (dgInt32 i = 0; i < count; i ++) {
+		dgConectivityGraphMap::dgTreeNode* const mapNode = nodes[i] ? m_conectivityMap.Find(nodes[i]->GetInfo()->GetShape()) : NULL;
+		if (mapNode) {
+			dgConectivityGraph::dgListNode* const chunkNode = mapNode->GetInfo();
+			dgDebriNodeInfo& nodeInfo = chunkNode->GetInfo().m_nodeData;
+			if (nodeInfo.m_lru != m_lru) {
+				nodeInfo.m_lru = m_lru;
+				chunks[chunkCount] = chunkNode;
+				chunkCount ++;
+			}
+		}
+	}
+
+	if (chunkCount) {
+		// lod proxies of the unbroken compound are stale after the detachment, and the mass must come from the full detail shape
+		myInstance->RemoveLodShapes();
+
+		// all chunks and the islands they leave behind are detached in one edit, 
+		// so the tree, the main mesh and the mass of the remaining body are rebuilt only once
+		dgCollisionCompound::BeginAddRemove ();
+		for (dgInt32 i = 0; i < chunkCount; i ++) {
+			dgConectivityGraph::dgListNode* const chunkNode = chunks[i];
+			dgDebriNodeInfo& nodeInfo = chunkNode->GetInfo().m_nodeData;
+			nodeInfo.m_mesh->m_isVisible = true;
+			for (dgMesh::dgListNode* meshSegment = nodeInfo.m_mesh->GetFirst(); meshSegment; meshSegment = meshSegment->GetNext()) {
+				dgSubMesh* const subMesh = &meshSegment->GetInfo();
+				subMesh->m_visibleFaces = true;
+			}
+			ExposeChunkFaces (chunkNode);
+			SpawnSingleChunk (myBody, myInstance, chunkNode);
+		}
+		SpawnDisjointChunks (myBody, myInstance, NULL, dgFloat32 (0.0f), dgFloat32 (0.0f));
+		EndAddRemove ();
+
+		if (m_reconstructMainMesh) {
+			m_reconstructMainMesh (myBody, m_conectivity.GetLast(), myInstance);
+		}
+		if (m_root) {
+			dgFloat32 mass = m_centerOfMass.m_w * m_density;
+			myBody->SetMassProperties(mass, myInstance);
+		} else {
+			myBody->SetMassProperties(dgFloat32 (0.0f), myInstance);
+		}
+	}
+	return chunkCount;
 }
 
 bool dgCollisionCompoundFractured::IsNodeSaseToDetach(dgTreeArray::dgTreeNode* const node) const
@@ -1684,7 +1761,6 @@ void dgCollisionCompoundFractured::SpawnSingleChunk (dgBody* const myBody, const
 	dgCollisionInstance* const chunkCollision = nodeInfo.m_shapeNode->GetInfo()->GetShape();
 	dgDynamicBody* const chunkBody = m_world->CreateDynamicBody (chunkCollision, matrix);
 	chunkBody->SetMassProperties(chunkCollision->GetVolume() * m_density, chunkBody->GetCollision());
-	m_world->GetBroadPhase()->AddInternallyGeneratedBody(chunkBody);
 
 	// calculate debris initial velocity
 	dgVector chunkOrigin (matrix.TransformVector(chunkCollision->GetLocalMatrix().m_posit));
@@ -1694,7 +1770,9 @@ void dgCollisionCompoundFractured::SpawnSingleChunk (dgBody* const myBody, const
 	chunkBody->SetVelocity(chunkVeloc);
 	chunkBody->SetGroupID(int (chunkCollision->GetUserDataID()));
 
-	m_emitFracturedChunk(chunkBody, chunkNode, myInstance);
+	if (m_emitFracturedChunk) {
+		m_emitFracturedChunk(chunkBody, chunkNode, myInstance);
+	}
 
 	m_conectivityMap.Remove (chunkCollision);
 	dgCollisionCompound::RemoveCollision (nodeInfo.m_shapeNode);
@@ -1743,7 +1821,6 @@ void dgCollisionCompoundFractured::SpawnComplexChunk (dgBody* const myBody, cons
 
 	dgDynamicBody* const chunkBody = m_world->CreateDynamicBody (childStructureInstance, matrix);
 	chunkBody->SetMassProperties(childStructureInstance->GetVolume() * m_density, chunkBody->GetCollision());
-	m_world->GetBroadPhase()->AddInternallyGeneratedBody(chunkBody);
 
 	// calculate debris initial velocity
 	dgVector chunkOrigin (matrix.TransformVector(childStructureInstance->GetLocalMatrix().m_posit));
@@ -1753,6 +1830,8 @@ void dgCollisionCompoundFractured::SpawnComplexChunk (dgBody* const myBody, cons
 	chunkBody->SetVelocity(chunkVeloc);
 	chunkBody->SetGroupID(int (childStructureInstance->GetUserDataID()));
 
-	m_emitFracturedCompound (chunkBody);
+	if (m_emitFracturedCompound) {
+		m_emitFracturedCompound (chunkBody);
+	}
 	childStructureInstance->Release();
 }
@@ -195,6 +195,7 @@ class dgCollisionCompoundFractured: public dgCollisionCompound
 	int GetFirstNiegborghArray (dgTreeArray::dgTreeNode* const node, dgTreeArray::dgTreeNode** const nodesArray, int maxCount) const;
 
 	dgCollisionCompoundFractured* PlaneClip (const dgVector& plane);
+	dgInt32 DetachChunks (dgBody* const myBody, dgTreeArray::dgTreeNode** const nodes, dgInt32 count);
 
 	private:
 	void BuildMainMeshSubMehes() const;
@@ -211,6 +212,7 @@ class dgCollisionCompoundFractured: public dgCollisionCompound
 	void SpawnSingleChunk (dgBody* const myBody, const dgCollisionInstance* const myInstance, dgConectivityGraph::dgListNode* const chunkNode);
 	void SpawnComplexChunk (dgBody* const myBody, const dgCollisionInstance* const myInstance, dgConectivityGraph::dgListNode* const chunkNode);
     bool CanChunk (dgConectivityGraph::dgListNode* const node) const;
+	void ExposeChunkFaces (dgConectivityGraph::dgListNode* const node) const;
 	
 	bool SanityCheck() const;
 	
@@ -31,7 +31,8 @@
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-#define DG_CONVEX_VERTEX_CHUNK_SIZE	4
+#define DG_CONVEX_VERTEX_CHUNK_SIZE		4
+#define DG_CONVEX_HULL_SOA_VERTEX_COUNT	32
 
 DG_MSC_VECTOR_ALIGMENT
 class dgCollisionConvexHull::dgConvexBox
@@ -51,6 +52,8 @@ dgCollisionConvexHull::dgCollisionConvexHull(dgMemoryAllocator* const allocator,
 	,m_faceArray (NULL)
 	,m_vertexToEdgeMapping(NULL)
 	,m_supportTree (NULL)
+	,m_soaVertex (NULL)
+	,m_soaBlockCount (0)
 {
 	m_edgeCount = 0;
 	m_vertexCount = 0;
@@ -66,6 +69,8 @@ dgCollisionConvexHull::dgCollisionConvexHull(dgMemoryAllocator* const allocator,
 	,m_faceArray (NULL)
 	,m_vertexToEdgeMapping(NULL)
 	,m_supportTree (NULL)
+	,m_soaVertex (NULL)
+	,m_soaBlockCount (0)
 {
 	m_edgeCount = 0;
 	m_vertexCount = 0;
@@ -83,6 +88,8 @@ dgCollisionConvexHull::dgCollisionConvexHull(dgWorld* const world, dgDeserialize
 	,m_faceArray (NULL)
 	,m_vertexToEdgeMapping(NULL)
 	,m_supportTree (NULL)
+	,m_soaVertex (NULL)
+	,m_soaBlockCount (0)
 {
 	m_rtti |= dgCollisionConvexHull_RTTI;
 	deserialization (userData, &m_vertexCount, sizeof (dgInt32));
@@ -124,6 +131,7 @@ dgCollisionConvexHull::dgCollisionConvexHull(dgWorld* const world, dgDeserialize
 	}
 
 	SetVolumeAndCG ();
+	BuildSoaVertexArray ();
 }
 
 dgCollisionConvexHull::~dgCollisionConvexHull()
@@ -138,6 +146,9 @@ dgCollisionConvexHull::~dgCollisionConvexHull()
 	if (m_supportTree) {
 		m_allocator->Free(m_supportTree);
 	}
+	if (m_soaVertex) {
+		m_allocator->Free(m_soaVertex);
+	}
 }
 
 void dgCollisionConvexHull::BuildHull (dgInt32 count, dgInt32 strideInBytes, dgFloat32 tolerance, const dgFloat32* const vertexArray)
@@ -744,6 +755,7 @@ bool dgCollisionConvexHull::Create (dgInt32 count, dgInt32 strideInBytes, const
 	}
 
 	SetVolumeAndCG ();
+	BuildSoaVertexArray ();
 	return true;
 }
 
@@ -803,10 +815,98 @@ void dgCollisionConvexHull::DebugCollision (const dgMatrix& matrix, dgCollision:
 	}
 }
 
+void dgCollisionConvexHull::BuildSoaVertexArray ()
+{
+	dgAssert (!m_soaVertex);
+	if ((m_vertexCount > DG_CONVEX_VERTEX_CHUNK_SIZE) && (m_vertexCount <= DG_CONVEX_HULL_SOA_VERTEX_COUNT)) {
+		// x, y, z planes of four vertices per block, the tail is padded with vertex zero
+		m_soaBlockCount = (m_vertexCount + 3) >> 2;
+		m_soaVertex = (dgVector*) m_allocator->Malloc (dgInt32 (3 * m_soaBlockCount * sizeof (dgVector)));
+		for (dgInt32 i = 0; i < m_soaBlockCount; i ++) {
+			dgVector* const block = &m_soaVertex[i * 3];
+			for (dgInt32 j = 0; j < 4; j ++) {
+				dgInt32 index = i * 4 + j;
+				const dgVector& p = m_vertex[(index < m_vertexCount) ? index : 0];
+				block[0][j] = p.m_x;
+				block[1][j] = p.m_y;
+				block[2][j] = p.m_z;
+			}
+		}
+	}
+}
+
+dgInt32 dgCollisionConvexHull::SupportVertexSoa (const dgVector& dir) const
+{
+	const dgVector dirX (dir.m_x);
+	const dgVector dirY (dir.m_y);
+	const dgVector dirZ (dir.m_z);
+	const dgVector four (dgFloat32 (4.0f));
+	dgVector laneIndex (dgFloat32 (0.0f), dgFloat32 (1.0f), dgFloat32 (2.0f), dgFloat32 (3.0f));
+	dgVector maxIndex (dgVector::m_negOne);
+	dgVector maxProj (dgFloat32 (-1.0e20f));
+	for (dgInt32 i = 0; i < m_soaBlockCount; i ++) {
+		const dgVector* const block = &m_soaVertex[i * 3];
+		dgVector proj (block[0] * dirX + block[1] * dirY + block[2] * dirZ);
+		dgVector mask (proj > maxProj);
+		maxIndex = maxIndex.Select(laneIndex, mask);
+		maxProj = maxProj.GetMax(proj);
+		laneIndex += four;
+	}
+
+	// on ties keep the lowest index, same answer as the linear scan
+	dgFloat32 maxValue = maxProj[0];
+	dgInt32 index = dgInt32 (maxIndex[0]);
+	for (dgInt32 i = 1; i < 4; i ++) {
+		dgInt32 laneVertex = dgInt32 (maxIndex[i]);
+		if ((maxProj[i] > maxValue) || ((maxProj[i] == maxValue) && (laneVertex < index))) {
+			maxValue = maxProj[i];
+			index = laneVertex;
+		}
+	}
+	dgAssert (index >= 0);
+	return (index < m_vertexCount) ? index : 0;
+}
+
+dgInt32 dgCollisionConvexHull::SupportVertexClimb (const dgVector& dir, dgInt32 startVertex) const
+{
+	// on a convex hull a vertex with no better neighbor is the global extreme, 
+	// so walking the adjacency from the last support vertex is exact 
+	const dgConvexSimplexEdge* edge = m_vertexToEdgeMapping[startVertex];
+	dgAssert (edge->m_vertex == startVertex);
+
+	dgInt32 index = startVertex;
+	dgFloat32 maxProj = m_vertex[index].DotProduct(dir).GetScalar();
+	const dgConvexSimplexEdge* ptr = edge;
+	dgInt32 maxCount = m_edgeCount;
+	do {
+		dgInt32 index1 = ptr->m_twin->m_vertex;
+		dgFloat32 proj = m_vertex[index1].DotProduct(dir).GetScalar();
+		if (proj > maxProj) {
+			index = index1;
+			maxProj = proj;
+			edge = ptr->m_twin;
+			ptr = edge;
+		}
+		ptr = ptr->m_twin->m_next;
+		maxCount --;
+	} while ((ptr != edge) && maxCount);
+	return maxCount ? index : -1;
+}
+
 dgVector dgCollisionConvexHull::SupportVertex (const dgVector& dir, dgInt32* const vertexIndex) const
 {
 	dgAssert (dir.m_w == dgFloat32 (0.0f));
-	dgInt32 index = -1;
+	dgInt32 index = m_soaVertex ? SupportVertexSoa (dir) : -1;
+	if ((index == -1) && vertexIndex && (*vertexIndex >= 0) && (*vertexIndex < m_vertexCount) && (m_vertexCount > DG_CONVEX_VERTEX_CHUNK_SIZE)) {
+		index = SupportVertexClimb (dir, *vertexIndex);
+	}
+	if (index != -1) {
+		if (vertexIndex) {
+			*vertexIndex = index;
+		}
+		return m_vertex[index];
+	}
+
 	dgVector maxProj (dgFloat32 (-1.0e20f)); 
 	if (m_vertexCount > DG_CONVEX_VERTEX_CHUNK_SIZE) {
 		dgFloat32 distPool[32];
@@ -48,6 +48,9 @@ class dgCollisionConvexHull: public dgCollisionConvex
 	bool CheckConvex (dgPolyhedra& polyhedra, const dgBigVector* hullVertexArray) const;
 
 	virtual dgVector SupportVertex (const dgVector& dir, dgInt32* const vertexIndex) const;
+	dgInt32 SupportVertexSoa (const dgVector& dir) const;
+	dgInt32 SupportVertexClimb (const dgVector& dir, dgInt32 startVertex) const;
+	void BuildSoaVertexArray ();
 
 	virtual dgInt32 CalculateSignature () const;
 	virtual void SetCollisionBBox (const dgVector& p0, const dgVector& p1);
@@ -65,6 +68,8 @@ class dgCollisionConvexHull: public dgCollisionConvex
 	dgConvexSimplexEdge** m_faceArray;
 	const dgConvexSimplexEdge** m_vertexToEdgeMapping;
 	dgConvexBox* m_supportTree;
+	dgVector* m_soaVertex;
+	dgInt32 m_soaBlockCount;
 
 	friend class dgWorld;
 	friend class dgCollisionConvex;
@@ -103,7 +103,9 @@ dgVector dgCollisionConvexPolygon::SupportVertex (const dgVector& dir, dgInt32*
 		}
 	}
 
-	dgAssert (vertexIndex == NULL);
+	if (vertexIndex) {
+		*vertexIndex = index;
+	}
 	return m_localPoly[index];
 }
 
@@ -25,7 +25,6 @@
 #include "dgCollisionHeightField.h"
 
 
-#define DG_HIGHTFIELD_DATA_ID 0x45AF5E07
 
 dgVector dgCollisionHeightField::m_yMask (0xffffffff, 0, 0xffffffff, 0);
 dgVector dgCollisionHeightField::m_padding (dgFloat32 (0.25f), dgFloat32 (0.25f), dgFloat32 (0.25f), dgFloat32 (0.0f));
@@ -69,6 +68,9 @@ dgCollisionHeightField::dgCollisionHeightField(
 	,m_horizontalScaleInv_z(dgFloat32(1.0f) / m_horizontalScale_z)
 	,m_userRayCastCallback(NULL)
 	,m_elevationDataType(elevationDataType)
+	,m_elevationPyramid(NULL)
+	,m_pyramidLevels(0)
+	,m_pageTable(NULL)
 {
 	m_rtti |= dgCollisionHeightField_RTTI;
 
@@ -227,23 +229,7 @@ dgCollisionHeightField::dgCollisionHeightField(
 	}
 	memcpy (m_atributeMap, atributeMap, m_width * m_height * sizeof (dgInt8));
 
-	dgTree<void*, unsigned>::dgTreeNode* nodeData = world->m_perInstanceData.Find(DG_HIGHTFIELD_DATA_ID);
-	if (!nodeData) {
-		m_instanceData = (dgPerIntanceData*) new dgPerIntanceData();
-		m_instanceData->m_refCount = 0;
-		m_instanceData->m_world = world;
-		for (dgInt32 i = 0 ; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
-			m_instanceData->m_vertex[i] = NULL;
-			m_instanceData->m_vertexCount[i] = 0;
-			m_instanceData->m_vertex[i].SetAllocator(world->GetAllocator());
-			AllocateVertex(world, i);
-		}
-		nodeData = world->m_perInstanceData.Insert (m_instanceData, DG_HIGHTFIELD_DATA_ID);
-	}
-	m_instanceData = (dgPerIntanceData*) nodeData->GetInfo();
-
-	m_instanceData->m_refCount ++;
-
+	BuildElevationPyramid();
 	CalculateAABB();
 	SetCollisionBBox(m_minBox, m_maxBox);
 }
@@ -256,6 +242,9 @@ dgCollisionHeightField::dgCollisionHeightField (dgWorld* const world, dgDeserial
 	dgInt32 elevationDataType;
 
 	m_userRayCastCallback = NULL;
+	m_elevationPyramid = NULL;
+	m_pyramidLevels = 0;
+	m_pageTable = NULL;
 	deserialization (userData, &m_width, sizeof (dgInt32));
 	deserialization (userData, &m_height, sizeof (dgInt32));
 	deserialization (userData, &m_diagonalMode, sizeof (dgInt32));
@@ -294,40 +283,461 @@ dgCollisionHeightField::dgCollisionHeightField (dgWorld* const world, dgDeserial
 	m_horizontalScaleInv_x = dgFloat32 (1.0f) / m_horizontalScale_x;
 	m_horizontalScaleInv_z = dgFloat32 (1.0f) / m_horizontalScale_z;
 
-	dgTree<void*, unsigned>::dgTreeNode* nodeData = world->m_perInstanceData.Find(DG_HIGHTFIELD_DATA_ID);
-	if (!nodeData) {
-		m_instanceData = (dgPerIntanceData*) new dgPerIntanceData();
-		m_instanceData->m_refCount = 0;
-		m_instanceData->m_world = world;
-		for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i++) {
-			m_instanceData->m_vertex[i] = NULL;
-			m_instanceData->m_vertexCount[i] = 0;
-			m_instanceData->m_vertex[i].SetAllocator(world->GetAllocator());
-			AllocateVertex(world, i);
-		}
-		nodeData = world->m_perInstanceData.Insert(m_instanceData, DG_HIGHTFIELD_DATA_ID);
+	BuildElevationPyramid();
+	SetCollisionBBox(m_minBox, m_maxBox);
+}
+
+dgCollisionHeightField::dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 contructionMode, 
+	dgElevationType elevationDataType, dgFloat32 minElevation, dgFloat32 maxElevation, dgFloat32 verticalScale, 
+	dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z, 
+	dgCollisionHeightFieldPageProvider pageProvider, void* const providerUserData, dgInt32 memoryBudgetInBytes)
+	:dgCollisionMesh (world, m_heightField)
+	,m_width(width)
+	,m_height(height)
+	,m_diagonalMode (dgCollisionHeightFieldGridConstruction  (dgClamp (contructionMode, dgInt32 (m_normalDiagonals), dgInt32 (m_starInvertexDiagonals))))
+	,m_atributeMap(NULL)
+	,m_diagonals(NULL)
+	,m_elevationMap(NULL)
+	,m_verticalScale(verticalScale)
+	,m_horizontalScale_x(horizontalScale_x)
+	,m_horizontalScaleInv_x (dgFloat32 (1.0f) / m_horizontalScale_x)
+	,m_horizontalScale_z(horizontalScale_z)
+	,m_horizontalScaleInv_z(dgFloat32(1.0f) / m_horizontalScale_z)
+	,m_userRayCastCallback(NULL)
+	,m_elevationDataType(elevationDataType)
+	,m_elevationPyramid(NULL)
+	,m_pyramidLevels(0)
+	,m_pageTable(NULL)
+{
+	m_rtti |= dgCollisionHeightField_RTTI;
+	dgAssert (pageProvider);
+
+	const dgInt32 pagesX = dgMax ((m_width - 1 + DG_HEIGHTFIELD_PAGE_SIZE - 1) >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 1);
+	const dgInt32 pagesZ = dgMax ((m_height - 1 + DG_HEIGHTFIELD_PAGE_SIZE - 1) >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 1);
+	const dgInt32 pageSamples = (DG_HEIGHTFIELD_PAGE_SIZE + 1) * (DG_HEIGHTFIELD_PAGE_SIZE + 1);
+	const dgInt32 sampleSize = (m_elevationDataType == m_float32Bit) ? sizeof (dgFloat32) : sizeof (dgUnsigned16);
+
+	m_pageTable = (dgPageTable*) dgMallocStack(sizeof (dgPageTable));
+	m_pageTable->m_pages = (dgElevationPage**) dgMallocStack(pagesX * pagesZ * sizeof (dgElevationPage*));
+	m_pageTable->m_requested = (dgInt8*) dgMallocStack(pagesX * pagesZ * sizeof (dgInt8));
+	m_pageTable->m_queue = (dgInt32*) dgMallocStack(pagesX * pagesZ * sizeof (dgInt32));
+	m_pageTable->m_loader = NULL;
+	m_pageTable->m_provider = pageProvider;
+	m_pageTable->m_userData = providerUserData;
+	m_pageTable->m_pagesX = pagesX;
+	m_pageTable->m_pagesZ = pagesZ;
+	m_pageTable->m_pageBytes = dgInt32 (sizeof (dgElevationPage)) + ((pageSamples * (sampleSize + 1) + 15) & -16);
+	m_pageTable->m_memoryUsed = 0;
+	m_pageTable->m_memoryBudget = dgMax (memoryBudgetInBytes, m_pageTable->m_pageBytes);
+	m_pageTable->m_residentPages = 0;
+	m_pageTable->m_requestedPages = 0;
+	m_pageTable->m_fallbackCells = 0;
+	m_pageTable->m_queueHead = 0;
+	m_pageTable->m_queueCount = 0;
+	m_pageTable->m_lru = 1;
+	m_pageTable->m_lock = 0;
+	memset (m_pageTable->m_pages, 0, pagesX * pagesZ * sizeof (dgElevationPage*));
+	memset (m_pageTable->m_requested, 0, pagesX * pagesZ * sizeof (dgInt8));
+
+	// until a page is loaded, all we know about its elevation is the range provided by the application
+	BuildElevationPyramid();
+	for (dgInt32 i = m_pyramidOffset[m_pyramidLevels - 1]; i >= 0; i --) {
+		m_elevationPyramid[i].m_minHeight = dgMin (minElevation, maxElevation);
+		m_elevationPyramid[i].m_maxHeight = dgMax (minElevation, maxElevation);
 	}
-	m_instanceData = (dgPerIntanceData*)nodeData->GetInfo();
 
-	m_instanceData->m_refCount ++;
+	CalculateAABB();
 	SetCollisionBBox(m_minBox, m_maxBox);
+
+	m_pageTable->m_loader = new (m_allocator) dgPageLoader (this);
 }
 
 dgCollisionHeightField::~dgCollisionHeightField(void)
 {
-	m_instanceData->m_refCount --;
-	if (!m_instanceData->m_refCount) {
-		dgWorld* const world = m_instanceData->m_world;
-		delete m_instanceData;
-		world->m_perInstanceData.Remove(DG_HIGHTFIELD_DATA_ID);
+	if (m_pageTable) {
+		// stop the loader first, it may be in the middle of reading a page
+		delete m_pageTable->m_loader;
+		for (dgInt32 i = 0; i < m_pageTable->m_pagesX * m_pageTable->m_pagesZ; i ++) {
+			if (m_pageTable->m_pages[i]) {
+				FreePage (i);
+			}
+		}
+		dgFreeStack(m_pageTable->m_pages);
+		dgFreeStack(m_pageTable->m_requested);
+		dgFreeStack(m_pageTable->m_queue);
+		dgFreeStack(m_pageTable);
+	} else {
+		dgFreeStack(m_elevationMap);
+		dgFreeStack(m_atributeMap);
+		dgFreeStack(m_diagonals);
+	}
+	dgFreeStack(m_elevationPyramid);
+}
+
+dgInt8 dgCollisionHeightField::CalculateDiagonal (dgInt32 x, dgInt32 z) const
+{
+	switch (m_diagonalMode)
+	{
+		case m_invertedDiagonals:
+			return 1;
+		case m_alternateOddRowsDiagonals:
+			return dgInt8 (z & 1);
+		case m_alternateEvenRowsDiagonals:
+			return dgInt8 (!(z & 1));
+		case m_alternateOddColumsDiagonals:
+			return dgInt8 (x & 1);
+		case m_alternateEvenColumsDiagonals:
+			return dgInt8 (!(x & 1));
+		case m_starDiagonals:
+			return dgInt8 ((x ^ z) & 1);
+		case m_starInvertexDiagonals:
+			return dgInt8 (!((x ^ z) & 1));
+		case m_normalDiagonals:
+		default:
+			return 0;
+	}
+}
+
+void dgCollisionHeightField::FreePage (dgInt32 index)
+{
+	dgElevationPage* const page = m_pageTable->m_pages[index];
+	dgAssert (page);
+	m_pageTable->m_pages[index] = NULL;
+	m_pageTable->m_memoryUsed -= m_pageTable->m_pageBytes;
+	m_pageTable->m_residentPages --;
+	dgFreeStack(page);
+}
+
+dgCollisionHeightField::dgPageLoader::dgPageLoader(const dgCollisionHeightField* const heightField)
+	:dgThread()
+	,m_heightField(heightField)
+	,m_semaphore()
+{
+	Init ("dgHeightFieldPageLoader", 0);
+}
+
+dgCollisionHeightField::dgPageLoader::~dgPageLoader()
+{
+	dgInterlockedExchange(&m_terminate, 1);
+	m_semaphore.Release();
+	Close();
+}
+
+void dgCollisionHeightField::dgPageLoader::Signal()
+{
+	m_semaphore.Release();
+}
+
+void dgCollisionHeightField::dgPageLoader::Execute (dgInt32 threadId)
+{
+	while (!m_terminate) {
+		m_semaphore.Wait();
+		if (!m_terminate) {
+			m_heightField->LoadQueuedPages();
+		}
+	}
+}
+
+dgCollisionHeightField::dgElevationPage* dgCollisionHeightField::LoadPage (dgInt32 pageX, dgInt32 pageZ) const
+{
+	// the loader thread and prefetch calls may overlap a residency update, 
+	// so pages are only looked up and touched while holding the page table lock
+	dgAssert (m_pageTable);
+	const dgInt32 index = pageZ * m_pageTable->m_pagesX + pageX;
+	for (;;) {
+		{
+			dgScopeSpinLock lock (&m_pageTable->m_lock);
+			dgElevationPage* const page = m_pageTable->m_pages[index];
+			if (page) {
+				page->m_lru = m_pageTable->m_lru;
+				return page;
+			}
+
+			dgInt8& state = m_pageTable->m_requested[index];
+			if (state != m_pageLoading) {
+				if ((m_pageTable->m_memoryUsed + m_pageTable->m_pageBytes) > m_pageTable->m_memoryBudget) {
+					// no room, defer the load until the next residency update can evict old pages
+					if (state == m_pageIdle) {
+						m_pageTable->m_requestedPages ++;
+					}
+					state = m_pageDeferred;
+					return NULL;
+				}
+				if (state != m_pageIdle) {
+					m_pageTable->m_requestedPages --;
+				}
+				// reserve the memory now, so that concurrent loads stay within the budget
+				state = m_pageLoading;
+				m_pageTable->m_memoryUsed += m_pageTable->m_pageBytes;
+				break;
+			}
+		}
+		// another thread is reading this page, wait for it rather than colliding with the fallback
+		dgThreadYield();
+	}
+
+	// the provider may do file or network io, it runs without holding the page table lock
+	const dgInt32 x0 = pageX << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+	const dgInt32 z0 = pageZ << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+	const dgInt32 width = dgMin (x0 + DG_HEIGHTFIELD_PAGE_SIZE, m_width - 1) - x0 + 1;
+	const dgInt32 height = dgMin (z0 + DG_HEIGHTFIELD_PAGE_SIZE, m_height - 1) - z0 + 1;
+	const dgInt32 sampleSize = (m_elevationDataType == m_float32Bit) ? sizeof (dgFloat32) : sizeof (dgUnsigned16);
+
+	dgElevationPage* const newPage = (dgElevationPage*) dgMallocStack(m_pageTable->m_pageBytes);
+	newPage->m_elevation = &newPage[1];
+	newPage->m_atributes = ((dgInt8*) newPage->m_elevation) + (DG_HEIGHTFIELD_PAGE_SIZE + 1) * (DG_HEIGHTFIELD_PAGE_SIZE + 1) * sampleSize;
+	newPage->m_stride = width;
+	m_pageTable->m_provider (m_pageTable->m_userData, x0, z0, width, height, newPage->m_elevation, newPage->m_atributes);
+
+	dgScopeSpinLock lock (&m_pageTable->m_lock);
+	RefinePyramid (pageX, pageZ, newPage);
+	newPage->m_lru = m_pageTable->m_lru;
+	m_pageTable->m_requested[index] = m_pageIdle;
+	m_pageTable->m_residentPages ++;
+
+	// publish the page only after its content is complete, collision queries read it without the lock
+	dgInterlockedExchange ((void**) &m_pageTable->m_pages[index], newPage);
+	return newPage;
+}
+
+void dgCollisionHeightField::RequestPage (dgInt32 pageX, dgInt32 pageZ) const
+{
+	dgAssert (m_pageTable);
+	if (!m_pageTable->m_loader->IsThreadActive()) {
+		// no loader thread when threads are emulated
+		LoadPage (pageX, pageZ);
+		return;
+	}
+
+	bool signal = false;
+	{
+		dgScopeSpinLock lock (&m_pageTable->m_lock);
+		const dgInt32 index = pageZ * m_pageTable->m_pagesX + pageX;
+		const dgInt32 count = m_pageTable->m_pagesX * m_pageTable->m_pagesZ;
+		dgElevationPage* const page = m_pageTable->m_pages[index];
+		if (page) {
+			page->m_lru = m_pageTable->m_lru;
+		} else if ((m_pageTable->m_requested[index] == m_pageIdle) && (m_pageTable->m_queueCount < count)) {
+			m_pageTable->m_requested[index] = m_pageQueued;
+			m_pageTable->m_requestedPages ++;
+			m_pageTable->m_queue[(m_pageTable->m_queueHead + m_pageTable->m_queueCount) % count] = index;
+			m_pageTable->m_queueCount ++;
+			signal = true;
+		}
+	}
+	if (signal) {
+		m_pageTable->m_loader->Signal();
+	}
+}
+
+void dgCollisionHeightField::LoadQueuedPages () const
+{
+	// runs on the loader thread, pages already loaded by a collision query since they were queued are skipped by LoadPage
+	const dgInt32 count = m_pageTable->m_pagesX * m_pageTable->m_pagesZ;
+	for (;;) {
+		dgInt32 index;
+		{
+			dgScopeSpinLock lock (&m_pageTable->m_lock);
+			if (!m_pageTable->m_queueCount) {
+				break;
+			}
+			index = m_pageTable->m_queue[m_pageTable->m_queueHead];
+			m_pageTable->m_queueHead = (m_pageTable->m_queueHead + 1) % count;
+			m_pageTable->m_queueCount --;
+		}
+		LoadPage (index % m_pageTable->m_pagesX, index / m_pageTable->m_pagesX);
+	}
+}
+
+dgCollisionHeightField::dgElevationPage* dgCollisionHeightField::FindPage (dgInt32 x, dgInt32 z, dgInt32& localX, dgInt32& localZ) const
+{
+	// lock free, only collision queries call it and they never overlap a residency update
+	// samples on a page border belong to both pages, pick the one that starts at the sample
+	const dgInt32 pageX = dgMin (x >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, m_pageTable->m_pagesX - 1);
+	const dgInt32 pageZ = dgMin (z >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, m_pageTable->m_pagesZ - 1);
+	localX = x - (pageX << DG_HEIGHTFIELD_PAGE_SIZE_LG2);
+	localZ = z - (pageZ << DG_HEIGHTFIELD_PAGE_SIZE_LG2);
+	dgElevationPage* const page = m_pageTable->m_pages[pageZ * m_pageTable->m_pagesX + pageX];
+	if (page) {
+		page->m_lru = m_pageTable->m_lru;
+	}
+	return page;
+}
+
+void dgCollisionHeightField::EnsurePagesResident (dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, bool wait) const
+{
+	const dgInt32 pageX0 = dgClamp (x0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 0, m_pageTable->m_pagesX - 1);
+	const dgInt32 pageX1 = dgClamp (x1 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 0, m_pageTable->m_pagesX - 1);
+	const dgInt32 pageZ0 = dgClamp (z0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 0, m_pageTable->m_pagesZ - 1);
+	const dgInt32 pageZ1 = dgClamp (z1 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, 0, m_pageTable->m_pagesZ - 1);
+	for (dgInt32 z = pageZ0; z <= pageZ1; z ++) {
+		for (dgInt32 x = pageX0; x <= pageX1; x ++) {
+			if (wait) {
+				LoadPage (x, z);
+			} else {
+				RequestPage (x, z);
+			}
+		}
+	}
+}
+
+void dgCollisionHeightField::RefinePyramid (dgInt32 pageX, dgInt32 pageZ, const dgElevationPage* const page) const
+{
+	// loaded pages narrow the conservative bounds, bounds only ever shrink 
+	// so concurrent readers always see a valid range
+	const dgInt32 tilesPerPage = 1 << (DG_HEIGHTFIELD_PAGE_SIZE_LG2 - DG_HEIGHTFIELD_TILE_SIZE_LG2);
+	const dgInt32 pageX0 = pageX << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+	const dgInt32 pageZ0 = pageZ << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+
+	dgInt32 tileX0 = pageX * tilesPerPage;
+	dgInt32 tileZ0 = pageZ * tilesPerPage;
+	dgInt32 tileX1 = dgMin (tileX0 + tilesPerPage, m_pyramidWidth[0]);
+	dgInt32 tileZ1 = dgMin (tileZ0 + tilesPerPage, m_pyramidHeight[0]);
+	for (dgInt32 tz = tileZ0; tz < tileZ1; tz ++) {
+		const dgInt32 z0 = (tz << DG_HEIGHTFIELD_TILE_SIZE_LG2) - pageZ0;
+		const dgInt32 z1 = dgMin ((tz << DG_HEIGHTFIELD_TILE_SIZE_LG2) + DG_HEIGHTFIELD_TILE_SIZE, m_height - 1) - pageZ0;
+		for (dgInt32 tx = tileX0; tx < tileX1; tx ++) {
+			const dgInt32 x0 = (tx << DG_HEIGHTFIELD_TILE_SIZE_LG2) - pageX0;
+			const dgInt32 x1 = dgMin ((tx << DG_HEIGHTFIELD_TILE_SIZE_LG2) + DG_HEIGHTFIELD_TILE_SIZE, m_width - 1) - pageX0;
+			dgFloat32 minHeight = dgFloat32 (1.0e10f);
+			dgFloat32 maxHeight = dgFloat32 (-1.0e10f);
+			for (dgInt32 z = z0; z <= z1; z ++) {
+				for (dgInt32 x = x0; x <= x1; x ++) {
+					dgFloat32 high = GetPageSample (page, x, z);
+					minHeight = dgMin (minHeight, high);
+					maxHeight = dgMax (maxHeight, high);
+				}
+			}
+			dgElevationBounds& bounds = m_elevationPyramid[tz * m_pyramidWidth[0] + tx];
+			bounds.m_minHeight = dgMax (bounds.m_minHeight, minHeight);
+			bounds.m_maxHeight = dgMin (bounds.m_maxHeight, maxHeight);
+		}
+	}
+
+	for (dgInt32 level = 1; level < m_pyramidLevels; level ++) {
+		tileX0 >>= 1;
+		tileZ0 >>= 1;
+		tileX1 = dgMin ((tileX1 + 1) >> 1, m_pyramidWidth[level]);
+		tileZ1 = dgMin ((tileZ1 + 1) >> 1, m_pyramidHeight[level]);
+		const dgInt32 childWidth = m_pyramidWidth[level - 1];
+		const dgInt32 childHeight = m_pyramidHeight[level - 1];
+		const dgElevationBounds* const children = &m_elevationPyramid[m_pyramidOffset[level - 1]];
+		dgElevationBounds* const parents = &m_elevationPyramid[m_pyramidOffset[level]];
+		for (dgInt32 tz = tileZ0; tz < tileZ1; tz ++) {
+			for (dgInt32 tx = tileX0; tx < tileX1; tx ++) {
+				dgFloat32 minHeight = dgFloat32 (1.0e10f);
+				dgFloat32 maxHeight = dgFloat32 (-1.0e10f);
+				const dgInt32 x1 = dgMin (2 * tx + 2, childWidth);
+				const dgInt32 z1 = dgMin (2 * tz + 2, childHeight);
+				for (dgInt32 j = 2 * tz; j < z1; j ++) {
+					for (dgInt32 i = 2 * tx; i < x1; i ++) {
+						minHeight = dgMin (minHeight, children[j * childWidth + i].m_minHeight);
+						maxHeight = dgMax (maxHeight, children[j * childWidth + i].m_maxHeight);
+					}
+				}
+				dgElevationBounds& bounds = parents[tz * m_pyramidWidth[level] + tx];
+				bounds.m_minHeight = dgMax (bounds.m_minHeight, minHeight);
+				bounds.m_maxHeight = dgMin (bounds.m_maxHeight, maxHeight);
+			}
+		}
+	}
+}
+
+dgFloat32 dgCollisionHeightField::GetPagedElevation (dgInt32 x, dgInt32 z) const
+{
+	dgInt32 localX;
+	dgInt32 localZ;
+	const dgElevationPage* const page = FindPage (x, z, localX, localZ);
+	if (page) {
+		return GetPageSample (page, localX, localZ);
+	}
+
+	// conservative fallback, a flat patch at the lowest elevation of the tile
+	const dgInt32 tileX = dgMin (x, m_width - 2) >> DG_HEIGHTFIELD_TILE_SIZE_LG2;
+	const dgInt32 tileZ = dgMin (z, m_height - 2) >> DG_HEIGHTFIELD_TILE_SIZE_LG2;
+	return m_elevationPyramid[tileZ * m_pyramidWidth[0] + tileX].m_minHeight;
+}
+
+dgInt8 dgCollisionHeightField::GetPagedAtribute (dgInt32 x, dgInt32 z) const
+{
+	dgInt32 localX;
+	dgInt32 localZ;
+	const dgElevationPage* const page = FindPage (x, z, localX, localZ);
+	return page ? page->m_atributes[localZ * page->m_stride + localX] : 0;
+}
+
+void dgCollisionHeightField::PrefetchPages (const dgVector& p0, const dgVector& p1) const
+{
+	if (m_pageTable) {
+		const dgInt32 x0 = dgFastInt (p0.m_x * m_horizontalScaleInv_x);
+		const dgInt32 x1 = dgFastInt (p1.m_x * m_horizontalScaleInv_x);
+		const dgInt32 z0 = dgFastInt (p0.m_z * m_horizontalScaleInv_z);
+		const dgInt32 z1 = dgFastInt (p1.m_z * m_horizontalScaleInv_z);
+		EnsurePagesResident (x0, x1, z0, z1, false);
+	}
+}
+
+void dgCollisionHeightField::UpdatePageResidency ()
+{
+	// must not run concurrently with collision queries, this is the only place pages are evicted.
+	// the loader thread may still be reading pages, so the table is only edited under the lock
+	if (m_pageTable) {
+		const dgInt32 count = m_pageTable->m_pagesX * m_pageTable->m_pagesZ;
+		for (dgInt32 i = 0; (i < count) && m_pageTable->m_requestedPages; i ++) {
+			bool load = false;
+			{
+				dgScopeSpinLock lock (&m_pageTable->m_lock);
+				if ((m_pageTable->m_requested[i] != m_pageDeferred) && (m_pageTable->m_requested[i] != m_pageQueued)) {
+					continue;
+				}
+				while ((m_pageTable->m_memoryUsed + m_pageTable->m_pageBytes) > m_pageTable->m_memoryBudget) {
+					// evict the least recently used page that was not touched since the last update
+					dgInt32 victim = -1;
+					dgUnsigned32 oldest = m_pageTable->m_lru;
+					for (dgInt32 j = 0; j < count; j ++) {
+						const dgElevationPage* const page = m_pageTable->m_pages[j];
+						if (page && (page->m_lru < oldest)) {
+							oldest = page->m_lru;
+							victim = j;
+						}
+					}
+					if (victim == -1) {
+						break;
+					}
+					FreePage (victim);
+				}
+				if ((m_pageTable->m_memoryUsed + m_pageTable->m_pageBytes) > m_pageTable->m_memoryBudget) {
+					break;
+				}
+				load = true;
+			}
+			if (load) {
+				LoadPage (i % m_pageTable->m_pagesX, i / m_pageTable->m_pagesX);
+			}
+		}
+		m_pageTable->m_lru ++;
+	}
+}
+
+void dgCollisionHeightField::GetPageStats (dgPageStats& stats) const
+{
+	memset (&stats, 0, sizeof (dgPageStats));
+	if (m_pageTable) {
+		stats.m_residentPages = m_pageTable->m_residentPages;
+		stats.m_requestedPages = m_pageTable->m_requestedPages;
+		stats.m_memoryUsed = m_pageTable->m_memoryUsed;
+		stats.m_memoryBudget = m_pageTable->m_memoryBudget;
+		stats.m_fallbackCells = m_pageTable->m_fallbackCells;
 	}
-	dgFreeStack(m_elevationMap);
-	dgFreeStack(m_atributeMap);
-	dgFreeStack(m_diagonals);
 }
 
 void dgCollisionHeightField::Serialize(dgSerialize callback, void* const userData) const
 {
+	if (m_pageTable) {
+		SerializePaged(callback, userData);
+		return;
+	}
+
 	SerializeLow(callback, userData);
 
 	dgInt32 elevationDataType = m_elevationDataType;
@@ -361,15 +771,138 @@ void dgCollisionHeightField::Serialize(dgSerialize callback, void* const userDat
 	callback (userData, m_diagonals, attibutePaddedMapSize * sizeof (dgInt8));
 }
 
-void dgCollisionHeightField::SetCollisionRayCastCallback (dgCollisionHeightFieldRayCastCallback rayCastCallback)
+void dgCollisionHeightField::SerializePaged(dgSerialize callback, void* const userData) const
 {
-	m_userRayCastCallback = rayCastCallback;
+	// a paged height field is saved as a regular one, pages are streamed one row 
+	// of pages at the time without going through the page cache
+	SerializeLow(callback, userData);
+
+	dgInt32 elevationDataType = m_elevationDataType;
+	callback (userData, &m_width, sizeof (dgInt32));
+	callback (userData, &m_height, sizeof (dgInt32));
+	callback (userData, &m_diagonalMode, sizeof (dgInt32));
+	callback (userData, &elevationDataType, sizeof (dgInt32));
+	callback (userData, &m_verticalScale, sizeof (dgFloat32));
+	callback (userData, &m_horizontalScale_x, sizeof (dgFloat32));
+	callback (userData, &m_horizontalScale_z, sizeof (dgFloat32));
+	callback (userData, &m_minBox.m_x, sizeof (dgVector)); 
+	callback (userData, &m_maxBox.m_x, sizeof (dgVector)); 
+
+	const dgInt32 sampleSize = (m_elevationDataType == m_float32Bit) ? sizeof (dgFloat32) : sizeof (dgUnsigned16);
+	const dgInt32 pageSamples = (DG_HEIGHTFIELD_PAGE_SIZE + 1) * (DG_HEIGHTFIELD_PAGE_SIZE + 1);
+	dgInt8* const pageElevation = (dgInt8*) dgMallocStack(pageSamples * sampleSize);
+	dgInt8* const pageAtributes = (dgInt8*) dgMallocStack(pageSamples * sizeof (dgInt8));
+	dgInt8* const strip = (dgInt8*) dgMallocStack((DG_HEIGHTFIELD_PAGE_SIZE + 1) * m_width * sampleSize);
+
+	// first pass writes the elevation, second pass the attributes
+	for (dgInt32 pass = 0; pass < 2; pass ++) {
+		const dgInt32 elementSize = pass ? sizeof (dgInt8) : sampleSize;
+		for (dgInt32 pageZ = 0; pageZ < m_pageTable->m_pagesZ; pageZ ++) {
+			const dgInt32 z0 = pageZ << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+			const dgInt32 rows = dgMin (z0 + DG_HEIGHTFIELD_PAGE_SIZE, m_height - 1) - z0 + 1;
+			for (dgInt32 pageX = 0; pageX < m_pageTable->m_pagesX; pageX ++) {
+				const dgInt32 x0 = pageX << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+				const dgInt32 columns = dgMin (x0 + DG_HEIGHTFIELD_PAGE_SIZE, m_width - 1) - x0 + 1;
+				const dgElevationPage* const page = m_pageTable->m_pages[pageZ * m_pageTable->m_pagesX + pageX];
+				const dgInt8* source;
+				if (page) {
+					source = pass ? page->m_atributes : (dgInt8*)page->m_elevation;
+				} else {
+					m_pageTable->m_provider (m_pageTable->m_userData, x0, z0, columns, rows, pageElevation, pageAtributes);
+					source = pass ? pageAtributes : pageElevation;
+				}
+				for (dgInt32 z = 0; z < rows; z ++) {
+					memcpy (&strip[(z * m_width + x0) * elementSize], &source[z * columns * elementSize], columns * elementSize);
+				}
+			}
+			// the last row of a strip is the first row of the next one
+			const dgInt32 rowsToWrite = (pageZ == (m_pageTable->m_pagesZ - 1)) ? rows : rows - 1;
+			callback (userData, strip, rowsToWrite * m_width * elementSize);
+		}
+
+		const dgInt32 attibutePaddedMapSize = (m_width * m_height + 4) & -4; 
+		if (pass && (attibutePaddedMapSize > m_width * m_height)) {
+			dgInt8 padding[4];
+			memset (padding, 0, sizeof (padding));
+			callback (userData, padding, attibutePaddedMapSize - m_width * m_height);
+		}
+	}
+
+	dgInt8* const diagonalRow = strip;
+	for (dgInt32 z = 0; z < m_height; z ++) {
+		for (dgInt32 x = 0; x < m_width; x ++) {
+			diagonalRow[x] = CalculateDiagonal (x, z);
+		}
+		callback (userData, diagonalRow, m_width * sizeof (dgInt8));
+	}
+	const dgInt32 diagonalPaddedMapSize = (m_width * m_height + 4) & -4; 
+	if (diagonalPaddedMapSize > m_width * m_height) {
+		dgInt8 padding[4];
+		memset (padding, 0, sizeof (padding));
+		callback (userData, padding, diagonalPaddedMapSize - m_width * m_height);
+	}
+
+	dgFreeStack(strip);
+	dgFreeStack(pageAtributes);
+	dgFreeStack(pageElevation);
 }
 
-void dgCollisionHeightField::AllocateVertex(dgWorld* const world, dgInt32 threadIndex) const
+void dgCollisionHeightField::DebugCollisionPaged (const dgMatrix& matrix, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const
 {
-	m_instanceData->m_vertex[threadIndex].Resize (m_instanceData->m_vertex[threadIndex].GetElementsCapacity() * 2);
-	m_instanceData->m_vertexCount[threadIndex] = m_instanceData->m_vertex[threadIndex].GetElementsCapacity();
+	// only the resident pages are displayed
+	for (dgInt32 pageZ = 0; pageZ < m_pageTable->m_pagesZ; pageZ ++) {
+		for (dgInt32 pageX = 0; pageX < m_pageTable->m_pagesX; pageX ++) {
+			const dgElevationPage* const page = m_pageTable->m_pages[pageZ * m_pageTable->m_pagesX + pageX];
+			if (!page) {
+				continue;
+			}
+			const dgInt32 x0 = pageX << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+			const dgInt32 z0 = pageZ << DG_HEIGHTFIELD_PAGE_SIZE_LG2;
+			const dgInt32 x1 = dgMin (x0 + DG_HEIGHTFIELD_PAGE_SIZE, m_width - 1);
+			const dgInt32 z1 = dgMin (z0 + DG_HEIGHTFIELD_PAGE_SIZE, m_height - 1);
+			for (dgInt32 z = z0; z < z1; z ++) {
+				for (dgInt32 x = x0; x < x1; x ++) {
+					dgVector points[4];
+					dgTriplex triangle[3];
+					points[0 * 2 + 0] = matrix.TransformVector(dgVector ((x + 0) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, x - x0 + 0, z - z0 + 0), (z + 0) * m_horizontalScale_z, dgFloat32 (0.0f)));
+					points[0 * 2 + 1] = matrix.TransformVector(dgVector ((x + 1) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, x - x0 + 1, z - z0 + 0), (z + 0) * m_horizontalScale_z, dgFloat32 (0.0f)));
+					points[1 * 2 + 0] = matrix.TransformVector(dgVector ((x + 0) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, x - x0 + 0, z - z0 + 1), (z + 1) * m_horizontalScale_z, dgFloat32 (0.0f)));
+					points[1 * 2 + 1] = matrix.TransformVector(dgVector ((x + 1) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, x - x0 + 1, z - z0 + 1), (z + 1) * m_horizontalScale_z, dgFloat32 (0.0f)));
+
+					const dgInt32* const indirectIndex = &m_cellIndices[dgInt32 (CalculateDiagonal (x, z))][0];
+					const dgInt32 i0 = indirectIndex[0];
+					const dgInt32 i1 = indirectIndex[1];
+					const dgInt32 i2 = indirectIndex[2];
+					const dgInt32 i3 = indirectIndex[3];
+					const dgInt32 atribute = page->m_atributes[(z - z0) * page->m_stride + x - x0];
+
+					triangle[0].m_x = points[i1].m_x;
+					triangle[0].m_y = points[i1].m_y;
+					triangle[0].m_z = points[i1].m_z;
+					triangle[1].m_x = points[i0].m_x;
+					triangle[1].m_y = points[i0].m_y;
+					triangle[1].m_z = points[i0].m_z;
+					triangle[2].m_x = points[i2].m_x;
+					triangle[2].m_y = points[i2].m_y;
+					triangle[2].m_z = points[i2].m_z;
+					callback (userData, 3, &triangle[0].m_x, atribute);
+
+					triangle[1].m_x = points[i2].m_x;
+					triangle[1].m_y = points[i2].m_y;
+					triangle[1].m_z = points[i2].m_z;
+					triangle[2].m_x = points[i3].m_x;
+					triangle[2].m_y = points[i3].m_y;
+					triangle[2].m_z = points[i3].m_z;
+					callback (userData, 3, &triangle[0].m_x, atribute);
+				}
+			}
+		}
+	}
+}
+
+void dgCollisionHeightField::SetCollisionRayCastCallback (dgCollisionHeightFieldRayCastCallback rayCastCallback)
+{
+	m_userRayCastCallback = rayCastCallback;
 }
 
 DG_INLINE void dgCollisionHeightField::CalculateMinExtend2d(const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const
@@ -417,31 +950,94 @@ DG_INLINE void dgCollisionHeightField::CalculateMinExtend3d(const dgVector& p0,
 	boxP1 = boxP1.GetMin(maxBox);
 }
 
-void dgCollisionHeightField::CalculateAABB()
+void dgCollisionHeightField::BuildElevationPyramid()
 {
-	dgFloat32 y0 = dgFloat32 (dgFloat32 (1.0e10f));
-	dgFloat32 y1 = dgFloat32 (-dgFloat32 (1.0e10f));
-	switch (m_elevationDataType) 
-	{
-		case m_float32Bit:
-		{
-			const dgFloat32* const elevation = (dgFloat32*)m_elevationMap;
-			for (dgInt32 i = 0; i < m_width * m_height; i ++) {
-				y0 = dgMin(y0, elevation[i]);
-				y1 = dgMax(y1, elevation[i]);
-			}
+	// level zero bounds a tile of cells, each one of the parent levels bounds 2 x 2 children
+	dgInt32 tilesX = dgMax ((m_width - 1 + DG_HEIGHTFIELD_TILE_SIZE - 1) >> DG_HEIGHTFIELD_TILE_SIZE_LG2, 1);
+	dgInt32 tilesZ = dgMax ((m_height - 1 + DG_HEIGHTFIELD_TILE_SIZE - 1) >> DG_HEIGHTFIELD_TILE_SIZE_LG2, 1);
+
+	dgInt32 entries = 0;
+	m_pyramidLevels = 0;
+	do {
+		dgAssert (m_pyramidLevels < DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS);
+		m_pyramidOffset[m_pyramidLevels] = entries;
+		m_pyramidWidth[m_pyramidLevels] = tilesX;
+		m_pyramidHeight[m_pyramidLevels] = tilesZ;
+		entries += tilesX * tilesZ;
+		m_pyramidLevels ++;
+		if ((tilesX == 1) && (tilesZ == 1)) {
 			break;
 		}
+		tilesX = (tilesX + 1) >> 1;
+		tilesZ = (tilesZ + 1) >> 1;
+	} while (true);
 
-		case m_unsigned16Bit:
-		{
-			const dgUnsigned16* const elevation = (dgUnsigned16*)m_elevationMap;
-			for (dgInt32 i = 0; i < m_width * m_height; i ++) {
-				y0 = dgMin(y0, dgFloat32 (elevation[i]));
-				y1 = dgMax(y1, dgFloat32 (elevation[i]));
+	if (m_elevationPyramid) {
+		dgFreeStack(m_elevationPyramid);
+	}
+	m_elevationPyramid = (dgElevationBounds*) dgMallocStack(entries * sizeof (dgElevationBounds));
+	if (m_pageTable) {
+		// paged height fields are bounded by the application range, and refined as pages load
+		return;
+	}
+
+	dgElevationBounds* const tiles = &m_elevationPyramid[0];
+	for (dgInt32 z = 0; z < m_pyramidHeight[0]; z ++) {
+		dgInt32 z0 = z << DG_HEIGHTFIELD_TILE_SIZE_LG2;
+		dgInt32 z1 = dgMin (z0 + DG_HEIGHTFIELD_TILE_SIZE, m_height - 1);
+		for (dgInt32 x = 0; x < m_pyramidWidth[0]; x ++) {
+			dgInt32 x0 = x << DG_HEIGHTFIELD_TILE_SIZE_LG2;
+			dgInt32 x1 = dgMin (x0 + DG_HEIGHTFIELD_TILE_SIZE, m_width - 1);
+			dgElevationBounds& bounds = tiles[z * m_pyramidWidth[0] + x];
+			bounds.m_minHeight = dgFloat32 (1.0e10f);
+			bounds.m_maxHeight = dgFloat32 (-1.0e10f);
+			switch (m_elevationDataType) 
+			{
+				case m_float32Bit:
+				{
+					CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgFloat32*)m_elevationMap, bounds.m_minHeight, bounds.m_maxHeight);
+					break;
+				}
+
+				case m_unsigned16Bit:
+				{
+					CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgUnsigned16*)m_elevationMap, bounds.m_minHeight, bounds.m_maxHeight);
+					break;
+				}
+			}
+		}
+	}
+
+	for (dgInt32 level = 1; level < m_pyramidLevels; level ++) {
+		const dgInt32 childWidth = m_pyramidWidth[level - 1];
+		const dgInt32 childHeight = m_pyramidHeight[level - 1];
+		const dgElevationBounds* const children = &m_elevationPyramid[m_pyramidOffset[level - 1]];
+		dgElevationBounds* const parents = &m_elevationPyramid[m_pyramidOffset[level]];
+		for (dgInt32 z = 0; z < m_pyramidHeight[level]; z ++) {
+			for (dgInt32 x = 0; x < m_pyramidWidth[level]; x ++) {
+				dgElevationBounds& bounds = parents[z * m_pyramidWidth[level] + x];
+				bounds.m_minHeight = dgFloat32 (1.0e10f);
+				bounds.m_maxHeight = dgFloat32 (-1.0e10f);
+				const dgInt32 x1 = dgMin (2 * x + 2, childWidth);
+				const dgInt32 z1 = dgMin (2 * z + 2, childHeight);
+				for (dgInt32 j = 2 * z; j < z1; j ++) {
+					for (dgInt32 i = 2 * x; i < x1; i ++) {
+						const dgElevationBounds& child = children[j * childWidth + i];
+						bounds.m_minHeight = dgMin (bounds.m_minHeight, child.m_minHeight);
+						bounds.m_maxHeight = dgMax (bounds.m_maxHeight, child.m_maxHeight);
+					}
+				}
 			}
 		}
 	}
+}
+
+void dgCollisionHeightField::CalculateAABB()
+{
+	dgAssert (m_elevationPyramid);
+	const dgElevationBounds& root = m_elevationPyramid[m_pyramidOffset[m_pyramidLevels - 1]];
+	dgFloat32 y0 = root.m_minHeight;
+	dgFloat32 y1 = root.m_maxHeight;
 
 	m_minBox = dgVector (dgFloat32 (dgFloat32 (0.0f)),                  y0 * m_verticalScale, dgFloat32 (dgFloat32 (0.0f)),               dgFloat32 (0.0f)); 
 	m_maxBox = dgVector (dgFloat32 (m_width - 1) * m_horizontalScale_x, y1 * m_verticalScale, dgFloat32 (m_height-1) * m_horizontalScale_z, dgFloat32 (0.0f)); 
@@ -459,6 +1055,7 @@ void dgCollisionHeightField::GetCollisionInfo(dgCollisionInfo* const info) const
 	data.m_verticalScale = m_verticalScale;
 	data.m_horizonalScale_x = m_horizontalScale_x;
 	data.m_horizonalScale_z = m_horizontalScale_z;
+	// paged height fields have no resident maps, both pointers are NULL
 	data.m_atributes = m_atributeMap;
 	data.m_elevation = m_elevationMap;
 }
@@ -477,7 +1074,18 @@ dgFloat32 dgCollisionHeightField::RayCastCell (const dgFastRayTest& ray, dgInt32
 
 	dgInt32 base = zIndex0 * m_width + xIndex0;
 	
-	switch (m_elevationDataType) 
+	if (m_pageTable) {
+		const dgElevationPage* const page = LoadPage (xIndex0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2, zIndex0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2);
+		if (!page) {
+			return dgFloat32 (1.2f);
+		}
+		const dgInt32 localX = xIndex0 - ((xIndex0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2) << DG_HEIGHTFIELD_PAGE_SIZE_LG2);
+		const dgInt32 localZ = zIndex0 - ((zIndex0 >> DG_HEIGHTFIELD_PAGE_SIZE_LG2) << DG_HEIGHTFIELD_PAGE_SIZE_LG2);
+		points[0 * 2 + 0] = dgVector ((xIndex0 + 0) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, localX + 0, localZ + 0), (zIndex0 + 0) * m_horizontalScale_z, dgFloat32 (0.0f));
+		points[0 * 2 + 1] = dgVector ((xIndex0 + 1) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, localX + 1, localZ + 0), (zIndex0 + 0) * m_horizontalScale_z, dgFloat32 (0.0f));
+		points[1 * 2 + 1] = dgVector ((xIndex0 + 1) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, localX + 1, localZ + 1), (zIndex0 + 1) * m_horizontalScale_z, dgFloat32 (0.0f));
+		points[1 * 2 + 0] = dgVector ((xIndex0 + 0) * m_horizontalScale_x, m_verticalScale * GetPageSample (page, localX + 0, localZ + 1), (zIndex0 + 1) * m_horizontalScale_z, dgFloat32 (0.0f));
+	} else switch (m_elevationDataType) 
 	{
 		case m_float32Bit:
 		{
@@ -501,8 +1109,10 @@ dgFloat32 dgCollisionHeightField::RayCastCell (const dgFastRayTest& ray, dgInt32
 		}
 	}
 	
+	const dgInt8 diagonal = m_pageTable ? CalculateDiagonal (xIndex0, zIndex0) : m_diagonals[base];
+
 	dgFloat32 t = dgFloat32 (1.2f);
-	if (!m_diagonals[base]) {
+	if (!diagonal) {
 		triangle[0] = 1;
 		triangle[1] = 2;
 		triangle[2] = 3;
@@ -629,15 +1239,32 @@ dgFloat32 dgCollisionHeightField::RayCast (const dgVector& q0, const dgVector& q
 		dgInt32 zIndex0 = iz0;
 		dgFastRayTest ray (q0, q1); 
 
+		dgFloat32 scale_y = m_verticalScale;
+		dgFloat32 tEnter = dgFloat32 (0.0f);
+		const dgInt32 tileStride = m_pyramidWidth[0];
+		const dgElevationBounds* const tiles = m_elevationPyramid;
+
 		// for each cell touched by the line
 		do {
-			dgFloat32 t = RayCastCell (ray, xIndex0, zIndex0, normalOut, maxT);
+			dgFloat32 t = dgFloat32 (1.2f);
+			if ((xIndex0 >= 0) && (zIndex0 >= 0) && (xIndex0 < (m_width - 1)) && (zIndex0 < (m_height - 1))) {
+				// skip the cell when the ray segment inside it is above or below its tile elevation range
+				const dgElevationBounds& tile = tiles[(zIndex0 >> DG_HEIGHTFIELD_TILE_SIZE_LG2) * tileStride + (xIndex0 >> DG_HEIGHTFIELD_TILE_SIZE_LG2)];
+				dgFloat32 tExit = dgMin (dgMin (txAcc, tzAcc), dgFloat32 (1.0f));
+				dgFloat32 y0 = p0.m_y + dp.m_y * tEnter;
+				dgFloat32 y1 = p0.m_y + dp.m_y * tExit;
+				dgFloat32 h0 = scale_y * tile.m_minHeight;
+				dgFloat32 h1 = scale_y * tile.m_maxHeight;
+				if ((dgMax (y0, y1) >= (dgMin (h0, h1) - m_padding.m_y)) && (dgMin (y0, y1) <= (dgMax (h0, h1) + m_padding.m_y))) {
+					t = RayCastCell (ray, xIndex0, zIndex0, normalOut, maxT);
+				}
+			}
 			if (t < maxT) {
 				// bail out at the first intersection and copy the data into the descriptor
 				dgAssert (normalOut.m_w == dgFloat32 (0.0f));
 				contactOut.m_normal = normalOut.Normalize();
-				contactOut.m_shapeId0 = m_atributeMap[zIndex0 * m_width + xIndex0];
-				contactOut.m_shapeId1 = m_atributeMap[zIndex0 * m_width + xIndex0];
+				contactOut.m_shapeId0 = m_pageTable ? GetPagedAtribute (xIndex0, zIndex0) : m_atributeMap[zIndex0 * m_width + xIndex0];
+				contactOut.m_shapeId1 = contactOut.m_shapeId0;
 
 				if (m_userRayCastCallback) {
 					dgVector normal (body->GetCollision()->GetGlobalMatrix().RotateVector (contactOut.m_normal));
@@ -650,10 +1277,12 @@ dgFloat32 dgCollisionHeightField::RayCast (const dgVector& q0, const dgVector& q
 			if (txAcc < tzAcc) {
 				xIndex0 += xInc;
 				tx = txAcc;
+				tEnter = txAcc;
 				txAcc += stepX;
 			} else {
 				zIndex0 += zInc;
 				tz = tzAcc;
+				tEnter = tzAcc;
 				tzAcc += stepZ;
 			}
 		} while ((tx <= dgFloat32 (1.0f)) || (tz <= dgFloat32 (1.0f)));
@@ -681,7 +1310,10 @@ dgVector dgCollisionHeightField::SupportVertex (const dgVector& dir, dgInt32* co
 {
 	dgFloat32 maxProject (dgFloat32 (-1.e-20f));
 	dgVector support (dgFloat32 (0.0f));
-	if (m_elevationDataType == m_float32Bit)  {
+	if (m_pageTable) {
+		// the samples may not be resident, the bounding box is a conservative support
+		support = m_minBox.Select (m_maxBox, dir > dgVector::m_zero);
+	} else if (m_elevationDataType == m_float32Bit)  {
 		const dgFloat32* const elevation = (dgFloat32*)m_elevationMap;
 		for (dgInt32 z = 0; z < m_height - 1; z ++) {
 			dgInt32 base = z * m_width;
@@ -722,6 +1354,11 @@ dgVector dgCollisionHeightField::SupportVertexSpecial (const dgVector& dir, dgFl
 
 void dgCollisionHeightField::DebugCollision (const dgMatrix& matrix, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const
 {
+	if (m_pageTable) {
+		DebugCollisionPaged (matrix, callback, userData);
+		return;
+	}
+
 	dgVector points[4];
 
 	dgInt32 base = 0;
@@ -839,6 +1476,94 @@ void dgCollisionHeightField::CalculateMinAndMaxElevation(dgInt32 x0, dgInt32 x1,
 }
 
 
+void dgCollisionHeightField::CalculateMinAndMaxElevation(dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, dgFloat32& minHeight, dgFloat32& maxHeight) const
+{
+	// walk the min max pyramid from the root, only tiles partially overlapped 
+	// by the query rectangle and that can still extend the bounds are scanned.
+	dgInt32 stack[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS * 4][3];
+
+	dgInt32 stackIndex = 1;
+	stack[0][0] = m_pyramidLevels - 1;
+	stack[0][1] = 0;
+	stack[0][2] = 0;
+	while (stackIndex) {
+		stackIndex --;
+		const dgInt32 level = stack[stackIndex][0];
+		const dgInt32 tileX = stack[stackIndex][1];
+		const dgInt32 tileZ = stack[stackIndex][2];
+
+		const dgElevationBounds& bounds = m_elevationPyramid[m_pyramidOffset[level] + tileZ * m_pyramidWidth[level] + tileX];
+		if ((bounds.m_minHeight >= minHeight) && (bounds.m_maxHeight <= maxHeight)) {
+			continue;
+		}
+
+		const dgInt32 shift = level + DG_HEIGHTFIELD_TILE_SIZE_LG2;
+		const dgInt32 tileX0 = tileX << shift;
+		const dgInt32 tileZ0 = tileZ << shift;
+		const dgInt32 tileX1 = dgMin (tileX0 + (1 << shift), m_width - 1);
+		const dgInt32 tileZ1 = dgMin (tileZ0 + (1 << shift), m_height - 1);
+		if ((tileX0 > x1) || (tileX1 < x0) || (tileZ0 > z1) || (tileZ1 < z0)) {
+			continue;
+		}
+
+		if ((x0 <= tileX0) && (x1 >= tileX1) && (z0 <= tileZ0) && (z1 >= tileZ1)) {
+			minHeight = dgMin (minHeight, bounds.m_minHeight);
+			maxHeight = dgMax (maxHeight, bounds.m_maxHeight);
+		} else if (level == 0) {
+			const dgInt32 scanX0 = dgMax (x0, tileX0);
+			const dgInt32 scanX1 = dgMin (x1, tileX1);
+			const dgInt32 scanZ0 = dgMax (z0, tileZ0);
+			const dgInt32 scanZ1 = dgMin (z1, tileZ1);
+			if (m_pageTable) {
+				// a tile never straddles two pages
+				dgInt32 localX;
+				dgInt32 localZ;
+				const dgElevationPage* const page = FindPage (tileX0, tileZ0, localX, localZ);
+				if (page) {
+					for (dgInt32 z = scanZ0; z <= scanZ1; z ++) {
+						for (dgInt32 x = scanX0; x <= scanX1; x ++) {
+							dgFloat32 high = GetPageSample (page, localX + x - tileX0, localZ + z - tileZ0);
+							minHeight = dgMin (minHeight, high);
+							maxHeight = dgMax (maxHeight, high);
+						}
+					}
+				} else {
+					minHeight = dgMin (minHeight, bounds.m_minHeight);
+					maxHeight = dgMax (maxHeight, bounds.m_maxHeight);
+				}
+				continue;
+			}
+			switch (m_elevationDataType) 
+			{
+				case m_float32Bit:
+				{
+					CalculateMinAndMaxElevation(scanX0, scanX1, scanZ0, scanZ1, (dgFloat32*)m_elevationMap, minHeight, maxHeight);
+					break;
+				}
+
+				case m_unsigned16Bit:
+				{
+					CalculateMinAndMaxElevation(scanX0, scanX1, scanZ0, scanZ1, (dgUnsigned16*)m_elevationMap, minHeight, maxHeight);
+					break;
+				}
+			}
+		} else {
+			const dgInt32 childLevel = level - 1;
+			const dgInt32 childX1 = dgMin (2 * tileX + 2, m_pyramidWidth[childLevel]);
+			const dgInt32 childZ1 = dgMin (2 * tileZ + 2, m_pyramidHeight[childLevel]);
+			for (dgInt32 j = 2 * tileZ; j < childZ1; j ++) {
+				for (dgInt32 i = 2 * tileX; i < childX1; i ++) {
+					dgAssert (stackIndex < dgInt32 (sizeof (stack) / sizeof (stack[0])));
+					stack[stackIndex][0] = childLevel;
+					stack[stackIndex][1] = i;
+					stack[stackIndex][2] = j;
+					stackIndex ++;
+				}
+			}
+		}
+	}
+}
+
 void dgCollisionHeightField::GetLocalAABB (const dgVector& q0, const dgVector& q1, dgVector& boxP0, dgVector& boxP1) const
 {
 	// the user data is the pointer to the collision geometry
@@ -859,21 +1584,7 @@ void dgCollisionHeightField::GetLocalAABB (const dgVector& q0, const dgVector& q
 
 	dgFloat32 minHeight = dgFloat32 (1.0e10f);
 	dgFloat32 maxHeight = dgFloat32 (-1.0e10f);
-	//dgInt32 base = z0 * m_width;
-	switch (m_elevationDataType) 
-	{
-		case m_float32Bit:
-		{
-			CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgFloat32*)m_elevationMap, minHeight, maxHeight);
-			break;
-		}
-
-		case m_unsigned16Bit:
-		{
-			CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgUnsigned16*)m_elevationMap, minHeight, maxHeight);
-			break;
-		}
-	}
+	CalculateMinAndMaxElevation(x0, x1, z0, z1, minHeight, maxHeight);
 
 	boxP0.m_y = m_verticalScale * minHeight;
 	boxP1.m_y = m_verticalScale * maxHeight;
@@ -909,40 +1620,71 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 	dgInt32 z0 = dgInt32 (p0.m_iz);
 	dgInt32 z1 = dgInt32 (p1.m_iz);
 
+	if (m_pageTable) {
+		// queue the pages around the body box to the loader thread, so they are usually resident 
+		// by the time the body reaches them, then load whatever the query itself still misses
+		const dgInt32 margin = DG_HEIGHTFIELD_PAGE_SIZE / 2;
+		EnsurePagesResident (x0 - margin, x1 + margin, z0 - margin, z1 + margin, false);
+		EnsurePagesResident (x0, x1, z0, z1, true);
+	}
+
 	data->m_separationDistance = dgFloat32 (0.0f);
 	dgFloat32 minHeight = dgFloat32 (1.0e10f);
 	dgFloat32 maxHeight = dgFloat32 (-1.0e10f);
-//	dgInt32 base = z0 * m_width;
-	switch (m_elevationDataType) 
-	{
-		case m_float32Bit:
-		{
-			CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgFloat32*)m_elevationMap, minHeight, maxHeight);
-			break;
-		}
-
-		case m_unsigned16Bit:
-		{
-			CalculateMinAndMaxElevation(x0, x1, z0, z1, (dgUnsigned16*)m_elevationMap, minHeight, maxHeight);
-			break;
-		}
-	}
+	CalculateMinAndMaxElevation(x0, x1, z0, z1, minHeight, maxHeight);
 
 	minHeight *= m_verticalScale;
 	maxHeight *= m_verticalScale;
 
 	if (!((maxHeight < boxP0.m_y) || (minHeight > boxP1.m_y))) {
 		// scan the vertices's intersected by the box extend
-		dgInt32 base = (z1 - z0 + 1) * (x1 - x0 + 1) + 2 * (z1 - z0) * (x1 - x0);
-		while (base > m_instanceData->m_vertexCount[data->m_threadNumber]) {
-			AllocateVertex(world, data->m_threadNumber);
-		}
+		const dgInt32 scratchCount = (z1 - z0 + 1) * (x1 - x0 + 1) + 2 * (z1 - z0) * (x1 - x0);
+		const dgInt32 windowBytes = 2 * (z1 - z0 + 1) * (x1 - x0 + 1);
+		const dgInt32 windowCount = (windowBytes + dgInt32 (sizeof (dgVector)) - 1) / dgInt32 (sizeof (dgVector));
+		dgVector* const vertex = world->GetMeshScratchPool().GetVertexBuffer(data->m_threadNumber, scratchCount + (m_pageTable ? windowCount : 0));
 
 		dgInt32 vertexIndex = 0;
-		base = z0 * m_width;
-		dgVector* const vertex = &m_instanceData->m_vertex[data->m_threadNumber][0];
-
-		switch (m_elevationDataType) 
+		dgInt32 base = z0 * m_width;
+
+		// diagonals and attributes of the cells under the box, row stride is windowStride
+		dgInt32 windowStride = m_width;
+		const dgInt8* diagonals = m_diagonals ? &m_diagonals[base + x0] : NULL;
+		const dgInt8* atributes = m_atributeMap ? &m_atributeMap[base + x0] : NULL;
+
+		if (m_pageTable) {
+			// copy the window out of the pages into the tail of the scratch buffer
+			windowStride = x1 - x0 + 1;
+			dgInt8* const diagonalWindow = (dgInt8*) &vertex[scratchCount];
+			dgInt8* const atributeWindow = &diagonalWindow[windowBytes / 2];
+			dgInt32 fallbackCells = 0;
+			for (dgInt32 z = z0; z <= z1; z ++) {
+				dgFloat32 zVal = m_horizontalScale_z * z;
+				const dgInt32 row = (z - z0) * windowStride - x0;
+				for (dgInt32 x = x0; x <= x1; x ++) {
+					dgInt32 localX;
+					dgInt32 localZ;
+					const dgElevationPage* const page = FindPage (x, z, localX, localZ);
+					dgFloat32 high;
+					if (page) {
+						high = GetPageSample (page, localX, localZ);
+						atributeWindow[row + x] = page->m_atributes[localZ * page->m_stride + localX];
+					} else {
+						high = GetPagedElevation (x, z);
+						atributeWindow[row + x] = 0;
+						fallbackCells ++;
+					}
+					diagonalWindow[row + x] = CalculateDiagonal (x, z);
+					vertex[vertexIndex] = dgVector(m_horizontalScale_x * x, m_verticalScale * high, zVal, dgFloat32 (0.0f));
+					vertexIndex ++;
+					dgAssert (vertexIndex <= scratchCount); 
+				}
+			}
+			if (fallbackCells) {
+				dgAtomicExchangeAndAdd (&m_pageTable->m_fallbackCells, fallbackCells);
+			}
+			diagonals = diagonalWindow;
+			atributes = atributeWindow;
+		} else switch (m_elevationDataType) 
 		{
 			case m_float32Bit:
 			{
@@ -952,7 +1694,7 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 					for (dgInt32 x = x0; x <= x1; x ++) {
 						vertex[vertexIndex] = dgVector(m_horizontalScale_x * x, m_verticalScale * elevation[base + x], zVal, dgFloat32 (0.0f));
 						vertexIndex ++;
-						dgAssert (vertexIndex <= m_instanceData->m_vertexCount[data->m_threadNumber]); 
+						dgAssert (vertexIndex <= scratchCount); 
 					}
 					base += m_width;
 				}
@@ -967,7 +1709,7 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 					for (dgInt32 x = x0; x <= x1; x ++) {
 						vertex[vertexIndex] = dgVector(m_horizontalScale_x * x, m_verticalScale * dgFloat32 (elevation[base + x]), zVal, dgFloat32 (0.0f));
 						vertexIndex ++;
-						dgAssert (vertexIndex <= m_instanceData->m_vertexCount[data->m_threadNumber]); 
+						dgAssert (vertexIndex <= scratchCount); 
 					}
 					base += m_width;
 				}
@@ -985,9 +1727,9 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 		dgInt32 faceSize = dgInt32 (dgMax (m_horizontalScale_x, m_horizontalScale_z) * dgFloat32 (2.0f)); 
 
 		for (dgInt32 z = z0; (z < z1) && (faceCount < DG_MAX_COLLIDING_FACES); z ++) {
-			dgInt32 zStep = z * m_width;
+			dgInt32 zStep = (z - z0) * windowStride - x0;
 			for (dgInt32 x = x0; (x < x1) && (faceCount < DG_MAX_COLLIDING_FACES); x ++) {
-				const dgInt32* const indirectIndex = &m_cellIndices[dgInt32 (m_diagonals[zStep + x])][0];
+				const dgInt32* const indirectIndex = &m_cellIndices[dgInt32 (diagonals[zStep + x])][0];
 
 				dgInt32 vIndex[4];
 				vIndex[0] = vertexIndex;
@@ -1021,7 +1763,7 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 				indices[index + 0 + 0] = i2;
 				indices[index + 0 + 1] = i1;
 				indices[index + 0 + 2] = i0;
-				indices[index + 0 + 3] = m_atributeMap[zStep + x];
+				indices[index + 0 + 3] = atributes[zStep + x];
 				indices[index + 0 + 4] = normalIndex0;
 				indices[index + 0 + 5] = normalIndex0;
 				indices[index + 0 + 6] = normalIndex0;
@@ -1032,7 +1774,7 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 				indices[index + 9 + 0] = i1;
 				indices[index + 9 + 1] = i2;
 				indices[index + 9 + 2] = i3;
-				indices[index + 9 + 3] = m_atributeMap[zStep + x];
+				indices[index + 9 + 3] = atributes[zStep + x];
 				indices[index + 9 + 4] = normalIndex1;
 				indices[index + 9 + 5] = normalIndex1;
 				indices[index + 9 + 6] = normalIndex1;
@@ -1065,12 +1807,12 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 		const int maxIndex = index;
 		dgInt32 stepBase = (x1 - x0) * (2 * 9);
 		for (dgInt32 z = z0; z < z1; z ++) {
-			const dgInt32 diagBase = m_width * z;
+			const dgInt32 diagBase = (z - z0) * windowStride - x0;
 			const dgInt32 triangleIndexBase = (z - z0) * stepBase;
 			for (dgInt32 x = x0; x < (x1 - 1); x ++) {
 				dgInt32 index1 = (x - x0) * (2 * 9) + triangleIndexBase;
 				if (index1 < maxIndex) {
-					const dgInt32 code = (m_diagonals[diagBase + x] << 1) + m_diagonals[diagBase + x + 1];
+					const dgInt32 code = (diagonals[diagBase + x] << 1) + diagonals[diagBase + x + 1];
 					const dgInt32* const edgeMap = &m_horizontalEdgeMap[code][0];
 				
 					dgInt32* const triangles = &indices[index1];
@@ -1101,8 +1843,8 @@ void dgCollisionHeightField::GetCollidingFaces (dgPolygonMeshDesc* const data) c
 			for (dgInt32 z = z0; z < (z1 - 1); z ++) {	
 				dgInt32 index1 = (z - z0) * stepBase + triangleIndexBase;
 				if (index1 < maxIndex) {
-					const dgInt32 diagBase = m_width * z;
-					const dgInt32 code = (m_diagonals[diagBase + x] << 1) + m_diagonals[diagBase + m_width + x];
+					const dgInt32 diagBase = (z - z0) * windowStride - x0;
+					const dgInt32 code = (diagonals[diagBase + x] << 1) + diagonals[diagBase + windowStride + x];
 					const dgInt32* const edgeMap = &m_verticalEdgeMap[code][0];
 
 					dgInt32* const triangles = &indices[index1];
@@ -25,8 +25,15 @@
 #include "dgCollision.h"
 #include "dgCollisionMesh.h"
 
+#define DG_HEIGHTFIELD_TILE_SIZE_LG2		3
+#define DG_HEIGHTFIELD_TILE_SIZE			(1<<DG_HEIGHTFIELD_TILE_SIZE_LG2)
+#define DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS	24
+#define DG_HEIGHTFIELD_PAGE_SIZE_LG2		6
+#define DG_HEIGHTFIELD_PAGE_SIZE			(1<<DG_HEIGHTFIELD_PAGE_SIZE_LG2)
+
 class dgCollisionHeightField;
 typedef dgFloat32 (*dgCollisionHeightFieldRayCastCallback) (const dgBody* const body, const dgCollisionHeightField* const heightFieldCollision, dgFloat32 interception, dgInt32 row, dgInt32 col, dgVector* const normal, int faceId, void* const usedData);
+typedef void (*dgCollisionHeightFieldPageProvider) (void* const userData, dgInt32 x0, dgInt32 z0, dgInt32 width, dgInt32 height, void* const elevation, dgInt8* const atributes);
 
 
 class dgCollisionHeightField: public dgCollisionMesh
@@ -49,10 +56,28 @@ class dgCollisionHeightField: public dgCollisionMesh
 		m_starDiagonals,
 		m_starInvertexDiagonals,
 	};
+	class dgPageStats
+	{
+		public:
+		dgInt32 m_residentPages;
+		dgInt32 m_requestedPages;
+		dgInt32 m_memoryUsed;
+		dgInt32 m_memoryBudget;
+		dgInt32 m_fallbackCells;
+	};
+
 	dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 contructionMode, 
 							const void* const elevationMap, dgElevationType elevationDataType, dgFloat32 verticalScale, 
 							const dgInt8* const atributeMap, dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z);
 
+	// paged height field, elevation and attributes are pulled from the page provider on demand 
+	// and only the pages that fit in the memory budget stay resident. 
+	// pages around the collision queries are read ahead by a loader thread owned by the shape.
+	dgCollisionHeightField (dgWorld* const world, dgInt32 width, dgInt32 height, dgInt32 contructionMode, 
+							dgElevationType elevationDataType, dgFloat32 minElevation, dgFloat32 maxElevation, dgFloat32 verticalScale, 
+							dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z, 
+							dgCollisionHeightFieldPageProvider pageProvider, void* const providerUserData, dgInt32 memoryBudgetInBytes);
+
 	dgCollisionHeightField (dgWorld* const world, dgDeserialize deserialization, void* const userData, dgInt32 revisionNumber);
 
 	virtual ~dgCollisionHeightField(void);
@@ -60,25 +85,103 @@ class dgCollisionHeightField: public dgCollisionMesh
 	void SetCollisionRayCastCallback (dgCollisionHeightFieldRayCastCallback rayCastCallback);
 	dgCollisionHeightFieldRayCastCallback GetDebugRayCastCallback() const { return m_userRayCastCallback;} 
 
+	bool IsPaged() const { return m_pageTable ? true : false;}
+	void PrefetchPages (const dgVector& p0, const dgVector& p1) const;
+	void UpdatePageResidency ();
+	void GetPageStats (dgPageStats& stats) const;
+
 	private:
-	class dgPerIntanceData
+	class dgElevationPage
+	{
+		public:
+		void* m_elevation;
+		dgInt8* m_atributes;
+		dgInt32 m_stride;
+		dgUnsigned32 m_lru;
+	};
+
+	enum dgPageState
+	{
+		m_pageIdle = 0,
+		m_pageDeferred,
+		m_pageQueued,
+		m_pageLoading,
+	};
+
+	class dgPageLoader: public dgThread
+	{
+		public:
+		DG_CLASS_ALLOCATOR(allocator)
+
+		dgPageLoader(const dgCollisionHeightField* const heightField);
+		~dgPageLoader();
+
+		void Signal();
+		virtual void Execute (dgInt32 threadId);
+
+		const dgCollisionHeightField* m_heightField;
+		dgSemaphore m_semaphore;
+	};
+
+	class dgPageTable
+	{
+		public:
+		dgElevationPage** m_pages;
+		dgInt8* m_requested;
+		dgInt32* m_queue;
+		dgPageLoader* m_loader;
+		dgCollisionHeightFieldPageProvider m_provider;
+		void* m_userData;
+		dgInt32 m_pagesX;
+		dgInt32 m_pagesZ;
+		dgInt32 m_pageBytes;
+		dgInt32 m_memoryUsed;
+		dgInt32 m_memoryBudget;
+		dgInt32 m_residentPages;
+		dgInt32 m_requestedPages;
+		dgInt32 m_fallbackCells;
+		dgInt32 m_queueHead;
+		dgInt32 m_queueCount;
+		dgUnsigned32 m_lru;
+		dgInt32 m_lock;
+	};
+
+	class dgElevationBounds
 	{
 		public:
-		dgWorld* m_world;
-		dgInt32 m_refCount;
-		dgInt32 m_vertexCount[DG_MAX_THREADS_HIVE_COUNT];
-		dgArray<dgVector> m_vertex[DG_MAX_THREADS_HIVE_COUNT];
+		dgFloat32 m_minHeight;
+		dgFloat32 m_maxHeight;
 	};
 
 	void CalculateAABB();
+	void BuildElevationPyramid();
+	void CalculateMinAndMaxElevation(dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, dgFloat32& minHeight, dgFloat32& maxHeight) const;
 	void CalculateMinAndMaxElevation(dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, const dgUnsigned16* const elevation, dgFloat32& minHeight, dgFloat32& maxHeight) const;
 	void CalculateMinAndMaxElevation(dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, const dgFloat32* const elevation, dgFloat32& minHeight, dgFloat32& maxHeight) const;
 		
-	void AllocateVertex(dgWorld* const world, dgInt32 thread) const;
 	void CalculateMinExtend2d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
 	void CalculateMinExtend3d (const dgVector& p0, const dgVector& p1, dgVector& boxP0, dgVector& boxP1) const;
 	dgFloat32 RayCastCell (const dgFastRayTest& ray, dgInt32 xIndex0, dgInt32 zIndex0, dgVector& normalOut, dgFloat32 maxT) const;
 
+	dgInt8 CalculateDiagonal (dgInt32 x, dgInt32 z) const;
+	dgElevationPage* LoadPage (dgInt32 pageX, dgInt32 pageZ) const;
+	void RequestPage (dgInt32 pageX, dgInt32 pageZ) const;
+	void LoadQueuedPages () const;
+	dgElevationPage* FindPage (dgInt32 x, dgInt32 z, dgInt32& localX, dgInt32& localZ) const;
+	void EnsurePagesResident (dgInt32 x0, dgInt32 x1, dgInt32 z0, dgInt32 z1, bool wait) const;
+	void RefinePyramid (dgInt32 pageX, dgInt32 pageZ, const dgElevationPage* const page) const;
+	void FreePage (dgInt32 index);
+	dgFloat32 GetPagedElevation (dgInt32 x, dgInt32 z) const;
+	dgInt8 GetPagedAtribute (dgInt32 x, dgInt32 z) const;
+	void SerializePaged(dgSerialize callback, void* const userData) const;
+	void DebugCollisionPaged (const dgMatrix& matrix, dgCollision::OnDebugCollisionMeshCallback callback, void* const userData) const;
+
+	DG_INLINE dgFloat32 GetPageSample (const dgElevationPage* const page, dgInt32 localX, dgInt32 localZ) const
+	{
+		const dgInt32 index = localZ * page->m_stride + localX;
+		return (m_elevationDataType == m_float32Bit) ? ((dgFloat32*)page->m_elevation)[index] : dgFloat32 (((dgUnsigned16*)page->m_elevation)[index]);
+	}
+
 	virtual void Serialize(dgSerialize callback, void* const userData) const;
 	virtual dgFloat32 RayCast (const dgVector& localP0, const dgVector& localP1, dgFloat32 maxT, dgContactPoint& contactOut, const dgBody* const body, void* const userData, OnRayPrecastAction preFilter) const;
 	virtual void GetCollidingFaces (dgPolygonMeshDesc* const data) const;
@@ -118,6 +221,17 @@ class dgCollisionHeightField: public dgCollisionMesh
 	dgCollisionHeightFieldRayCastCallback m_userRayCastCallback;
 	dgElevationType m_elevationDataType;
 
+	// min max elevation quad tree, level zero stores one entry per tile of 
+	// DG_HEIGHTFIELD_TILE_SIZE x DG_HEIGHTFIELD_TILE_SIZE cells, the last level is the root
+	dgElevationBounds* m_elevationPyramid;
+	dgInt32 m_pyramidLevels;
+	dgInt32 m_pyramidOffset[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+	dgInt32 m_pyramidWidth[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+	dgInt32 m_pyramidHeight[DG_HEIGHTFIELD_MAX_PYRAMID_LEVELS];
+
+	// NULL unless the height field is paged
+	dgPageTable* m_pageTable;
+
 	
 	static dgVector m_yMask;
 	static dgVector m_padding;
@@ -125,8 +239,6 @@ class dgCollisionHeightField: public dgCollisionMesh
 	static dgInt32 m_cellIndices[][4];
 	static dgInt32 m_verticalEdgeMap[][7];
 	static dgInt32 m_horizontalEdgeMap[][7];
-	
-	dgPerIntanceData* m_instanceData;
 	friend class dgCollisionCompound;
 };
 
@@ -62,6 +62,8 @@ dgCollisionInstance::dgCollisionInstance()
 	,m_skinThickness(dgFloat32 (0.0f))
 	,m_collisionMode(1)
 	,m_refCount(1)
+	,m_lodCount(0)
+	,m_activeLod(0)
 	,m_scaleType(m_unit)
 	,m_isExternal(true)
 {
@@ -82,6 +84,8 @@ dgCollisionInstance::dgCollisionInstance(const dgWorld* const world, const dgCol
 	,m_skinThickness(dgFloat32 (0.0f))
 	,m_collisionMode(1)
 	,m_refCount(1)
+	,m_lodCount(0)
+	,m_activeLod(0)
 	,m_scaleType(m_unit)
 	,m_isExternal(true)
 {
@@ -98,12 +102,14 @@ dgCollisionInstance::dgCollisionInstance(const dgCollisionInstance& instance)
 	,m_maxScale(instance.m_maxScale)
 	,m_material(instance.m_material)
 	,m_world(instance.m_world)
-	,m_childShape (instance.m_childShape)
+	,m_childShape (instance.GetLodShape(0))
 	,m_subCollisionHandle(NULL)
 	,m_parent(NULL)
 	,m_skinThickness(instance.m_skinThickness)
 	,m_collisionMode(instance.m_collisionMode)
 	,m_refCount(1)
+	,m_lodCount(0)
+	,m_activeLod(0)
 	,m_scaleType(instance.m_scaleType)
 	,m_isExternal(true)
 {
@@ -128,6 +134,15 @@ dgCollisionInstance::dgCollisionInstance(const dgCollisionInstance& instance)
 		m_childShape->AddRef();
 	}
 
+	if (instance.m_lodCount) {
+		// copies start at full detail, the proxies are immutable and can be shared
+		m_lodShapes[0] = m_childShape;
+		for (dgInt32 i = 1; i < instance.m_lodCount; i ++) {
+			m_lodShapes[i] = instance.m_lodShapes[i]->AddRef();
+		}
+		m_lodCount = instance.m_lodCount;
+	}
+
 	if (m_world->m_onCollisionInstanceCopyConstrutor) {
 		m_world->m_onCollisionInstanceCopyConstrutor (m_world, this, &instance);
 	}
@@ -148,6 +163,8 @@ dgCollisionInstance::dgCollisionInstance(const dgWorld* const constWorld, dgDese
 	,m_skinThickness(dgFloat32 (0.0f))
 	,m_collisionMode(1)
 	,m_refCount(1)
+	,m_lodCount(0)
+	,m_activeLod(0)
 	,m_scaleType(m_unit)
 	,m_isExternal(true)
 {
@@ -174,18 +191,11 @@ dgCollisionInstance::dgCollisionInstance(const dgWorld* const constWorld, dgDese
 
 	dgWorld* const world = (dgWorld*) constWorld;
 	if (saved) {
-		const dgCollision* collision = NULL;
-		dgBodyCollisionList::dgTreeNode* node = world->dgBodyCollisionList::Find (dgUnsigned32 (signature));
-
-		if (node) {
-			collision = node->GetInfo();
-			collision->AddRef();
-
-		} else {
-
-			dgCollisionID primitiveType = dgCollisionID(primitive);
+		dgCollisionID primitiveType = dgCollisionID(primitive);
+		const dgCollision* collision = world->FindCachedShape (dgUnsigned32 (signature), primitiveType);
 
-			dgMemoryAllocator* const allocator = world->GetAllocator();
+		if (!collision) {
+			dgMemoryAllocator* const allocator = world->GetShapeAllocator(primitiveType);
 			switch (primitiveType)
 			{
 				case m_heightField:
@@ -197,6 +207,9 @@ dgCollisionInstance::dgCollisionInstance(const dgWorld* const constWorld, dgDese
 				case m_boundingBoxHierachy:
 				{
 					collision = new (allocator) dgCollisionBVH (world, serialize, userData, revisionNumber);
+					if (allocator != world->GetAllocator()) {
+						collision = world->AddCachedShape (collision);
+					}
 					break;
 				}
 
@@ -222,64 +235,56 @@ dgCollisionInstance::dgCollisionInstance(const dgWorld* const constWorld, dgDese
 				case m_sphereCollision:
 				{
 					collision = new (allocator) dgCollisionSphere (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_boxCollision:
 				{
 					collision = new (allocator) dgCollisionBox (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_coneCollision:
 				{
 					collision = new (allocator) dgCollisionCone (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_capsuleCollision:
 				{
 					collision = new (allocator) dgCollisionCapsule (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_cylinderCollision:
 				{
 					collision = new (allocator) dgCollisionCylinder (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_chamferCylinderCollision:
 				{
 					collision = new (allocator) dgCollisionChamferCylinder (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_convexHullCollision:
 				{
 					collision = new (allocator) dgCollisionConvexHull (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
 				case m_nullCollision:
 				{
 					collision = new (allocator) dgCollisionNull (world, serialize, userData, revisionNumber);
-					node = world->dgBodyCollisionList::Insert (collision, collision->GetSignature());
-					collision->AddRef();
+					collision = world->AddCachedShape (collision);
 					break;
 				}
 
@@ -304,14 +309,62 @@ dgCollisionInstance::~dgCollisionInstance()
 		m_world->m_onCollisionInstanceDestruction (m_world, this);
 	}
 	dgWorld* const world = (dgWorld*)m_world;
-	world->ReleaseCollision(m_childShape);
+	if (m_lodCount) {
+		for (dgInt32 i = 0; i < m_lodCount; i ++) {
+			world->ReleaseCollision(m_lodShapes[i]);
+		}
+	} else {
+		world->ReleaseCollision(m_childShape);
+	}
+}
+
+void dgCollisionInstance::SetChildShape (dgCollision* const shape)
+{
+	RemoveLodShapes();
+	shape->AddRef();
+	if (m_childShape) {
+		// shapes from a foreign allocator belong to the shape cache
+		((dgWorld*)m_world)->ReleaseCollision(m_childShape);
+	}
+
+	m_childShape = shape;
+}
+
+dgInt32 dgCollisionInstance::AddLodShape (const dgCollision* const shape)
+{
+	if (m_lodCount >= DG_MAX_COLLISION_LOD) {
+		return -1;
+	}
+	if (!m_lodCount) {
+		// the first level takes over the reference of the full detail shape
+		m_lodShapes[0] = m_childShape;
+		m_lodCount = 1;
+	}
+	m_lodShapes[m_lodCount] = shape->AddRef();
+	m_lodCount ++;
+	return m_lodCount - 1;
+}
+
+void dgCollisionInstance::RemoveLodShapes ()
+{
+	if (m_lodCount) {
+		dgWorld* const world = (dgWorld*)m_world;
+		m_childShape = m_lodShapes[0];
+		for (dgInt32 i = 1; i < m_lodCount; i ++) {
+			world->ReleaseCollision(m_lodShapes[i]);
+		}
+		m_lodCount = 0;
+		m_activeLod = 0;
+	}
 }
 
 void dgCollisionInstance::Serialize(dgSerialize serialize, void* const userData, bool saveShape) const
 {
+	// lod proxies are not saved, the full detail shape is
+	const dgCollision* const shape = GetLodShape(0);
 	dgInt32 save = saveShape ? 1 : 0;
-	dgInt32 primitiveType = m_childShape->GetCollisionPrimityType();
-	dgInt32 signature = m_childShape->GetSignature();
+	dgInt32 primitiveType = shape->GetCollisionPrimityType();
+	dgInt32 signature = shape->GetSignature();
 	dgInt32 scaleType = m_scaleType;
 
 	serialize (userData, &m_globalMatrix, sizeof (m_globalMatrix));
@@ -328,7 +381,7 @@ void dgCollisionInstance::Serialize(dgSerialize serialize, void* const userData,
 	serialize (userData, &signature, sizeof (signature));
 	serialize (userData, &save, sizeof (save));
 	if (saveShape) {
-		m_childShape->Serialize(serialize, userData);
+		shape->Serialize(serialize, userData);
 	}
 	dgSerializeMarker(serialize, userData);
 }
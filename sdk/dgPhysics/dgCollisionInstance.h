@@ -24,6 +24,7 @@
 
 
 #define DG_MAX_COLLISION_AABB_PADDING		dgFloat32 (1.0f / 16.0f)
+#define DG_MAX_COLLISION_LOD				4
 
 #include "dgCollision.h"
 
@@ -38,6 +39,12 @@ class dgCollisionInstance
 		m_global,
 	};
 
+	enum dgLodType
+	{
+		m_lodConvexHull,
+		m_lodBoundingBox,
+	};
+
 	DG_CLASS_ALLOCATOR(allocator)
 	dgCollisionInstance();
 	dgCollisionInstance(const dgCollisionInstance& instance);
@@ -87,6 +94,14 @@ class dgCollisionInstance
 	void SetWorld (dgWorld* const world);
 	void SetChildShape (dgCollision* const shape);
 
+	// level zero is the full detail shape, the active level is the child shape seen by the collision system
+	dgInt32 GetLodCount() const;
+	dgInt32 GetActiveLod() const;
+	const dgCollision* GetLodShape(dgInt32 lod) const;
+	dgInt32 AddLodShape (const dgCollision* const shape);
+	bool SetActiveLod (dgInt32 lod);
+	void RemoveLodShapes ();
+
 	dgFloat32 GetVolume () const;
 	void GetCollisionInfo(dgCollisionInfo* const info) const;
 
@@ -143,9 +158,12 @@ class dgCollisionInstance
 	const dgCollision* m_childShape;
 	const void* m_subCollisionHandle;
 	const dgCollisionInstance* m_parent;
+	const dgCollision* m_lodShapes[DG_MAX_COLLISION_LOD];
 	dgFloat32 m_skinThickness;
 	dgInt32 m_collisionMode;
 	dgInt32 m_refCount;
+	dgInt32 m_lodCount;
+	dgInt32 m_activeLod;
 	dgScaleType m_scaleType;
 	bool m_isExternal;
 
@@ -167,6 +185,8 @@ DG_INLINE dgCollisionInstance::dgCollisionInstance(const dgCollisionInstance& me
 	,m_skinThickness(meshInstance.m_skinThickness)
 	,m_collisionMode(meshInstance.m_collisionMode)
 	,m_refCount(1)
+	,m_lodCount(0)
+	,m_activeLod(0)
 	,m_scaleType(meshInstance.m_scaleType)
 	,m_isExternal(false)
 {
@@ -211,14 +231,30 @@ DG_INLINE void dgCollisionInstance::SetWorld (dgWorld* const world)
 	m_world = world;
 }
 
-DG_INLINE void dgCollisionInstance::SetChildShape (dgCollision* const shape)
+DG_INLINE dgInt32 dgCollisionInstance::GetLodCount() const
 {
-	shape->AddRef();
-	if (m_childShape) {
-		m_childShape->Release();
-	}
+	return m_lodCount;
+}
 
-	m_childShape = shape;
+DG_INLINE dgInt32 dgCollisionInstance::GetActiveLod() const
+{
+	return m_activeLod;
+}
+
+DG_INLINE const dgCollision* dgCollisionInstance::GetLodShape(dgInt32 lod) const
+{
+	return m_lodCount ? m_lodShapes[dgClamp (lod, 0, m_lodCount - 1)] : m_childShape;
+}
+
+DG_INLINE bool dgCollisionInstance::SetActiveLod (dgInt32 lod)
+{
+	lod = dgClamp (lod, 0, dgMax (m_lodCount - 1, 0));
+	if (lod == m_activeLod) {
+		return false;
+	}
+	m_activeLod = lod;
+	m_childShape = m_lodShapes[lod];
+	return true;
 }
 
 DG_INLINE void dgCollisionInstance::GetCollisionInfo(dgCollisionInfo* const info) const
@@ -187,9 +187,60 @@ void dgPolygonMeshDesc::SortFaceArray ()
 #endif
 }
 
+dgPolygonMeshScratchPool::dgPolygonMeshScratchPool(dgMemoryAllocator* const allocator)
+{
+	for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+		m_highWaterMark[i] = 0;
+		m_vertex[i].SetAllocator(allocator);
+	}
+}
+
+dgPolygonMeshScratchPool::~dgPolygonMeshScratchPool()
+{
+}
+
+void dgPolygonMeshScratchPool::Grow (dgInt32 threadIndex, dgInt32 vertexCount)
+{
+	// the content is scratch, so there is no need to copy the old buffer over
+	dgArray<dgVector>& buffer = m_vertex[threadIndex];
+	dgInt32 capacity = dgMax (buffer.GetElementsCapacity(), 256);
+	while (capacity < vertexCount) {
+		capacity *= 2;
+	}
+	buffer.Clear();
+	buffer.Resize(capacity);
+}
+
+void dgPolygonMeshScratchPool::Reserve (dgInt32 vertexCount)
+{
+	for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+		if (vertexCount > m_vertex[i].GetElementsCapacity()) {
+			Grow (i, vertexCount);
+		}
+	}
+}
+
+dgInt32 dgPolygonMeshScratchPool::GetHighWaterMark() const
+{
+	dgInt32 highWaterMark = 0;
+	for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+		highWaterMark = dgMax (highWaterMark, m_highWaterMark[i]);
+	}
+	return highWaterMark;
+}
+
+dgInt32 dgPolygonMeshScratchPool::GetMemoryUsed() const
+{
+	dgInt32 bytes = 0;
+	for (dgInt32 i = 0; i < DG_MAX_THREADS_HIVE_COUNT; i ++) {
+		bytes += m_vertex[i].GetBytesCapacity();
+	}
+	return bytes;
+}
+
 
 dgCollisionMesh::dgCollisionMesh(dgWorld* const world, dgCollisionID type)
-	:dgCollision(world->GetAllocator(), 0, type)
+	:dgCollision(world->GetShapeAllocator(type), 0, type)
 {
 	m_rtti |= dgCollisionMesh_RTTI;
 	m_debugCallback = NULL;
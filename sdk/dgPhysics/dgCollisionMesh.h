@@ -127,7 +127,37 @@ class dgPolygonMeshDesc: public dgFastAABBInfo
 	dgMesh m_meshData;
 } DG_GCC_VECTOR_ALIGMENT;
 
-DG_MSC_VECTOR_ALIGMENT 
+// per thread, growth only, scratch memory shared by all mesh vs convex queries.
+// buffers are never shrunk, so after a few frames queries do not allocate at all.
+class dgPolygonMeshScratchPool
+{
+	public:
+	dgPolygonMeshScratchPool(dgMemoryAllocator* const allocator);
+	~dgPolygonMeshScratchPool();
+
+	DG_INLINE dgVector* GetVertexBuffer(dgInt32 threadIndex, dgInt32 vertexCount)
+	{
+		dgAssert (threadIndex >= 0);
+		dgAssert (threadIndex < DG_MAX_THREADS_HIVE_COUNT);
+		if (vertexCount > m_vertex[threadIndex].GetElementsCapacity()) {
+			Grow (threadIndex, vertexCount);
+		}
+		m_highWaterMark[threadIndex] = dgMax (m_highWaterMark[threadIndex], vertexCount);
+		return &m_vertex[threadIndex][0];
+	}
+
+	void Reserve (dgInt32 vertexCount);
+	dgInt32 GetHighWaterMark() const;
+	dgInt32 GetMemoryUsed() const;
+
+	private:
+	void Grow (dgInt32 threadIndex, dgInt32 vertexCount);
+
+	dgArray<dgVector> m_vertex[DG_MAX_THREADS_HIVE_COUNT];
+	dgInt32 m_highWaterMark[DG_MAX_THREADS_HIVE_COUNT];
+};
+
+DG_MSC_VECTOR_ALIGMENT
 class dgCollisionMeshRayHitDesc
 {
 	public:
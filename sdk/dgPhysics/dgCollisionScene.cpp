@@ -69,6 +69,11 @@ void dgCollisionScene::MassProperties ()
 	m_crossInertia = dgVector::m_zero;
 }
 
+void dgCollisionScene::ApplyMassProperties ()
+{
+	MassProperties ();
+}
+
 void dgCollisionScene::CollidePair (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const
 {
 	const dgNodeBase* stackPool[DG_COMPOUND_STACK_DEPTH];
@@ -39,6 +39,7 @@ class dgCollisionScene: public dgCollisionCompound
 	void CollidePair (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
 	void CollideCompoundPair (dgBroadPhase::dgPair* const pair, dgCollisionParamProxy& proxy) const;
 	virtual void MassProperties ();
+	virtual void ApplyMassProperties ();
 	virtual void Serialize(dgSerialize callback, void* const userData) const;
 
 	dgFloat32 GetBoxMinRadius () const;
@@ -0,0 +1,173 @@
+/* Copyright (c) <2003-2019> <Julio Jerez, Newton Game Dynamics>
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "dgPhysicsStdafx.h"
+#include "dgCollisionShapeCache.h"
+
+
+class dgCollisionShapeCache::dgShapeStream
+{
+	public:
+	dgShapeStream(const dgCollision* const shape)
+		:m_buffer(NULL)
+		,m_size(0)
+		,m_capacity(0)
+	{
+		shape->Serialize(Write, this);
+	}
+
+	~dgShapeStream()
+	{
+		if (m_buffer) {
+			dgFreeStack(m_buffer);
+		}
+	}
+
+	static void dgApi Write(void* const userData, const void* const buffer, dgInt32 size)
+	{
+		dgShapeStream* const me = (dgShapeStream*)userData;
+		if ((me->m_size + size) > me->m_capacity) {
+			dgInt32 capacity = dgMax(2 * me->m_capacity, me->m_size + size + 256);
+			dgUnsigned8* const data = (dgUnsigned8*)dgMallocStack(capacity);
+			if (me->m_buffer) {
+				memcpy(data, me->m_buffer, me->m_size);
+				dgFreeStack(me->m_buffer);
+			}
+			me->m_buffer = data;
+			me->m_capacity = capacity;
+		}
+		memcpy(&me->m_buffer[me->m_size], buffer, size);
+		me->m_size += size;
+	}
+
+	dgUnsigned8* m_buffer;
+	dgInt32 m_size;
+	dgInt32 m_capacity;
+};
+
+dgCollisionShapeCache::dgCollisionShapeCache()
+	:m_allocator()
+	,m_shapes(&m_allocator)
+	,m_hitCount(0)
+	,m_missCount(0)
+	,m_lock(0)
+{
+}
+
+dgCollisionShapeCache::~dgCollisionShapeCache()
+{
+	// shapes still alive at exit belong to instances that were never released
+	dgAssert(!m_shapes.GetCount());
+}
+
+dgCollisionShapeCache& dgCollisionShapeCache::GetCache()
+{
+	static dgCollisionShapeCache cache;
+	return cache;
+}
+
+dgUnsigned32 dgCollisionShapeCache::CalculateSignature(const dgCollision* const shape)
+{
+	dgShapeStream stream(shape);
+	return dgCRC(stream.m_buffer, stream.m_size);
+}
+
+bool dgCollisionShapeCache::IsEqual(const dgCollision* const shape0, const dgCollision* const shape1)
+{
+	if (shape0->GetCollisionPrimityType() != shape1->GetCollisionPrimityType()) {
+		return false;
+	}
+	dgShapeStream stream0(shape0);
+	dgShapeStream stream1(shape1);
+	return (stream0.m_size == stream1.m_size) && !memcmp(stream0.m_buffer, stream1.m_buffer, stream0.m_size);
+}
+
+const dgCollision* dgCollisionShapeCache::Find(dgUnsigned32 signature, dgCollisionID id)
+{
+	dgScopeSpinLock lock(&m_lock);
+	dgTree<const dgCollision*, dgUnsigned64>::dgTreeNode* const node = m_shapes.Find(GetKey(signature, id));
+	if (node) {
+		m_hitCount++;
+		return node->GetInfo()->AddRef();
+	}
+	return NULL;
+}
+
+const dgCollision* dgCollisionShapeCache::AddShape(const dgCollision* const shape)
+{
+	dgAssert(shape->GetAllocator() == &m_allocator);
+	dgAssert(IsCacheable(shape->GetCollisionPrimityType()));
+
+	dgScopeSpinLock lock(&m_lock);
+	const dgUnsigned64 key = GetKey(shape->GetSignature(), shape->GetCollisionPrimityType());
+	dgTree<const dgCollision*, dgUnsigned64>::dgTreeNode* const node = m_shapes.Find(key);
+	if (!node) {
+		m_missCount++;
+		m_shapes.Insert(shape, key);
+		shape->AddRef();
+		return shape;
+	}
+
+	const dgCollision* const cachedShape = node->GetInfo();
+	if (cachedShape == shape) {
+		return shape;
+	}
+
+	if (IsEqual(cachedShape, shape)) {
+		// another thread or another world built the same shape first
+		m_hitCount++;
+		cachedShape->AddRef();
+		shape->Release();
+		return cachedShape;
+	}
+
+	// signature collision with a different shape, leave it private
+	m_missCount++;
+	return shape;
+}
+
+void dgCollisionShapeCache::ReleaseShape(const dgCollision* const shape)
+{
+	// the decrement and the eviction test happen under the lock, so two releases can not both
+	// see the last instance reference and a concurrent Find can not revive an evicted shape
+	dgScopeSpinLock lock(&m_lock);
+	dgTree<const dgCollision*, dgUnsigned64>::dgTreeNode* const node = m_shapes.Find(GetKey(shape->GetSignature(), shape->GetCollisionPrimityType()));
+	if (node && (node->GetInfo() == shape) && (shape->m_refCount == 2)) {
+		m_shapes.Remove(node);
+		shape->Release();
+	}
+	shape->Release();
+}
+
+void dgCollisionShapeCache::GetStats(dgCollisionShapeCacheStats& stats)
+{
+	dgScopeSpinLock lock(&m_lock);
+	stats.m_shapeCount = m_shapes.GetCount();
+	stats.m_instanceCount = 0;
+	stats.m_hitCount = m_hitCount;
+	stats.m_missCount = m_missCount;
+	stats.m_memoryUsed = m_allocator.GetMemoryUsed();
+
+	dgTree<const dgCollision*, dgUnsigned64>::Iterator iter(m_shapes);
+	for (iter.Begin(); iter; iter++) {
+		stats.m_instanceCount += iter.GetNode()->GetInfo()->m_refCount - 1;
+	}
+}
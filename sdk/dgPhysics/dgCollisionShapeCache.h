@@ -0,0 +1,85 @@
+/* Copyright (c) <2003-2019> <Julio Jerez, Newton Game Dynamics>
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+*
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+*
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _DG_COLLISION_SHAPE_CACHE_H_
+#define _DG_COLLISION_SHAPE_CACHE_H_
+
+#include "dgCollision.h"
+
+class dgCollisionShapeCacheStats
+{
+	public:
+	dgInt32 m_shapeCount;
+	dgInt32 m_instanceCount;
+	dgInt32 m_hitCount;
+	dgInt32 m_missCount;
+	dgInt32 m_memoryUsed;
+};
+
+// process wide cache of immutable shapes, shared by all worlds that enable it.
+// shapes are allocated from the cache allocator so that they can outlive the world that created them.
+class dgCollisionShapeCache
+{
+	public:
+	static dgCollisionShapeCache& GetCache();
+	static bool IsCacheable (dgCollisionID id);
+	static dgUnsigned32 CalculateSignature (const dgCollision* const shape);
+
+	dgMemoryAllocator* GetAllocator();
+
+	const dgCollision* Find (dgUnsigned32 signature, dgCollisionID id);
+	const dgCollision* AddShape (const dgCollision* const shape);
+	void ReleaseShape (const dgCollision* const shape);
+	void GetStats (dgCollisionShapeCacheStats& stats);
+
+	private:
+	class dgShapeStream;
+
+	dgCollisionShapeCache();
+	~dgCollisionShapeCache();
+
+	static dgUnsigned64 GetKey (dgUnsigned32 signature, dgCollisionID id);
+	static bool IsEqual (const dgCollision* const shape0, const dgCollision* const shape1);
+
+	dgMemoryAllocator m_allocator;
+	dgTree<const dgCollision*, dgUnsigned64> m_shapes;
+	dgInt32 m_hitCount;
+	dgInt32 m_missCount;
+	dgInt32 m_lock;
+};
+
+inline dgMemoryAllocator* dgCollisionShapeCache::GetAllocator()
+{
+	return &m_allocator;
+}
+
+inline bool dgCollisionShapeCache::IsCacheable (dgCollisionID id)
+{
+	return (id <= m_nullCollision) || (id == m_boundingBoxHierachy);
+}
+
+inline dgUnsigned64 dgCollisionShapeCache::GetKey (dgUnsigned32 signature, dgCollisionID id)
+{
+	return (dgUnsigned64 (id) << 32) | signature;
+}
+
+#endif
+
@@ -80,6 +80,7 @@ dgContact::dgContact(dgWorld* const world, const dgContactMaterial* const materi
 	,m_isNewContact(1)
 	,m_skeletonIntraCollision(1)
 	,m_skeletonSelftCollision(1)
+	,m_isScratch(0)
 {
 	dgAssert ((((dgUnsigned64) this) & 15) == 0);
 	m_maxDOF = 0;
@@ -120,6 +121,7 @@ dgContact::dgContact(dgContact* const clone)
 	,m_isNewContact(clone->m_isNewContact)
 	,m_skeletonIntraCollision(clone->m_skeletonIntraCollision)
 	,m_skeletonSelftCollision(clone->m_skeletonSelftCollision)
+	,m_isScratch(0)
 {
 	dgAssert((((dgUnsigned64) this) & 15) == 0);
 	m_body0 = clone->m_body0;
@@ -139,10 +141,41 @@ dgContact::dgContact(dgContact* const clone)
 	}
 }
 
+// narrow phase stand in for a joint whose child pairs are solved on several threads.
+// it carries the joint collision state but it is never seen by the world or the solver.
+dgContact::dgContact(const dgContact* const source, dgMemoryAllocator* const allocator)
+	:dgConstraint()
+	,dgList<dgContactMaterial>(allocator)
+	,m_positAcc(source->m_positAcc)
+	,m_rotationAcc(source->m_rotationAcc)
+	,m_separtingVector (source->m_separtingVector)
+	,m_material(source->m_material)
+	,m_closestDistance(source->m_closestDistance)
+	,m_separationDistance(source->m_separationDistance)
+	,m_timeOfImpact(source->m_timeOfImpact)
+	,m_impulseSpeed (source->m_impulseSpeed)
+	,m_contactPruningTolereance(source->m_contactPruningTolereance)
+	,m_broadphaseLru(source->m_broadphaseLru)
+	,m_killContact(0)
+	,m_isNewContact(source->m_isNewContact)
+	,m_skeletonIntraCollision(source->m_skeletonIntraCollision)
+	,m_skeletonSelftCollision(source->m_skeletonSelftCollision)
+	,m_isScratch(1)
+{
+	dgAssert((((dgUnsigned64) this) & 15) == 0);
+	m_userData = source->m_userData;
+	m_body0 = source->m_body0;
+	m_body1 = source->m_body1;
+	m_maxDOF = 0;
+	m_constId = m_contactConstraint;
+	m_isActive = source->m_isActive;
+	m_enableCollision = source->m_enableCollision;
+}
+
 dgContact::~dgContact()
 {
 	dgAssert(m_body0);
-	if (m_body0->m_world && m_body0->m_world->m_onDestroyContact) {
+	if (!m_isScratch && m_body0->m_world && m_body0->m_world->m_onDestroyContact) {
 		m_body0->m_world->m_onDestroyContact(m_body0->m_world, this);
 	}
 
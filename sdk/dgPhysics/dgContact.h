@@ -212,6 +212,7 @@ class dgContact: public dgConstraint, public dgList<dgContactMaterial>
 	protected:
 	dgContact(dgContact* const clone);
 	dgContact(dgWorld* const world, const dgContactMaterial* const material, dgBody* const body0, dgBody* const body1);
+	dgContact(const dgContact* const source, dgMemoryAllocator* const allocator);
 	virtual ~dgContact();
 
 	DG_CLASS_ALLOCATOR(allocator)
@@ -250,6 +251,7 @@ class dgContact: public dgConstraint, public dgList<dgContactMaterial>
 	dgUnsigned32 m_isNewContact				: 1;
 	dgUnsigned32 m_skeletonIntraCollision	: 1;
 	dgUnsigned32 m_skeletonSelftCollision	: 1;
+	dgUnsigned32 m_isScratch				: 1;
 
     friend class dgBody;
 	friend class dgWorld;
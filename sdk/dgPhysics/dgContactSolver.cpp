@@ -63,6 +63,8 @@ dgContactSolver::dgContactSolver(dgCollisionInstance* const instance)
 	,m_instance0(instance)
 	,m_instance1(instance)
 	,m_vertexIndex(0)
+	,m_supportIndex0(-1)
+	,m_supportIndex1(-1)
 {
 }
 
@@ -73,6 +75,8 @@ dgContactSolver::dgContactSolver(dgCollisionParamProxy* const proxy)
 	,m_instance0(proxy->m_instance0)
 	,m_instance1(proxy->m_instance1)
 	,m_vertexIndex(0)
+	,m_supportIndex0(-1)
+	,m_supportIndex1(-1)
 {
 }
 
@@ -84,8 +88,8 @@ DG_INLINE void dgContactSolver::SupportVertex(const dgVector& dir0, dgInt32 vert
 
 	const dgMatrix& matrix0 = m_instance0->m_globalMatrix;
 	const dgMatrix& matrix1 = m_instance1->m_globalMatrix;
-	dgVector p(matrix0.TransformVector(m_instance0->SupportVertexSpecial(matrix0.UnrotateVector (dir0), NULL)) & dgVector::m_triplexMask);
-	dgVector q(matrix1.TransformVector(m_instance1->SupportVertexSpecial(matrix1.UnrotateVector (dir1), NULL)) & dgVector::m_triplexMask);
+	dgVector p(matrix0.TransformVector(m_instance0->SupportVertexSpecial(matrix0.UnrotateVector (dir0), &m_supportIndex0)) & dgVector::m_triplexMask);
+	dgVector q(matrix1.TransformVector(m_instance1->SupportVertexSpecial(matrix1.UnrotateVector (dir1), &m_supportIndex1)) & dgVector::m_triplexMask);
 	m_hullDiff[vertexIndex] = p - q;
 	m_hullSum[vertexIndex] = p + q;
 }
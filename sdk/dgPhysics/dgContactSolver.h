@@ -113,6 +113,8 @@ class dgContactSolver: public dgDownHeap<dgMinkFace *, dgFloat32>
 	dgFaceFreeList* m_freeFace; 
 	dgInt32 m_vertexIndex;
 	dgInt32 m_faceIndex;
+	dgInt32 m_supportIndex0;
+	dgInt32 m_supportIndex1;
 
 	dgVector m_hullDiff[DG_CONVEX_MINK_MAX_POINTS];
 	dgVector m_hullSum[DG_CONVEX_MINK_MAX_POINTS];
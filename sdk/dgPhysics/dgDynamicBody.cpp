@@ -115,10 +115,13 @@ dgDynamicBody::dgDynamicBody()
 	,m_externalTorque(dgVector::m_zero)
 	,m_savedExternalForce(dgVector::m_zero)
 	,m_savedExternalTorque(dgVector::m_zero)
+	,m_stepImpulseForce(dgVector::m_zero)
+	,m_stepImpulseTorque(dgVector::m_zero)
 	,m_dampCoef(dgVector::m_zero)
 	,m_cachedDampCoef(dgVector::m_zero)
 	,m_cachedTimeStep(dgFloat32(0.0f))
 	,m_sleepingCounter(0)
+	,m_skeletonSolverMode(0)
 	,m_isInDestructionArrayLRU(0)
 	,m_skeleton(NULL)
 	,m_applyExtForces(NULL)
@@ -134,10 +137,13 @@ dgDynamicBody::dgDynamicBody (dgWorld* const world, const dgTree<const dgCollisi
 	,m_externalTorque(dgVector::m_zero)
 	,m_savedExternalForce(dgVector::m_zero)
 	,m_savedExternalTorque(dgVector::m_zero)
+	,m_stepImpulseForce(dgVector::m_zero)
+	,m_stepImpulseTorque(dgVector::m_zero)
 	,m_dampCoef(dgVector::m_zero)
 	,m_cachedDampCoef(dgVector::m_zero)
 	,m_cachedTimeStep(dgFloat32(0.0f))
 	,m_sleepingCounter(0)
+	,m_skeletonSolverMode(0)
 	,m_isInDestructionArrayLRU(0)
 	,m_skeleton(NULL)
 	,m_applyExtForces(NULL)
@@ -248,6 +254,9 @@ void dgDynamicBody::ApplyExtenalForces (dgFloat32 timestep, dgInt32 threadIndex)
 	m_gyroRotation = m_rotation;
 	m_gyroTorque = dgVector::m_zero;
 
+	// lightweight sub steps keep the external force, they remove the impulse part after the first sub step
+	m_stepImpulseForce = m_impulseForce;
+	m_stepImpulseTorque = m_impulseTorque;
 	m_externalForce += m_impulseForce;
 	m_externalTorque += m_impulseTorque;
 	m_impulseForce = dgVector::m_zero;
@@ -80,6 +80,8 @@ class dgDynamicBody : public dgBody
 
 	virtual dgSkeletonContainer* GetSkeleton() const;
 	void SetSkeleton(dgSkeletonContainer* const skeleton);
+	dgInt32 GetSkeletonSolverMode() const;
+	void SetSkeletonSolverMode(dgInt32 mode);
 
 	void IntegrateImplicit(dgFloat32 timeStep);
 	virtual void IntegrateOpenLoopExternalForce(dgFloat32 timeStep);
@@ -99,10 +101,13 @@ class dgDynamicBody : public dgBody
 	dgVector m_externalTorque;
 	dgVector m_savedExternalForce;
 	dgVector m_savedExternalTorque;
+	dgVector m_stepImpulseForce;
+	dgVector m_stepImpulseTorque;
 	dgVector m_dampCoef;
 	dgVector m_cachedDampCoef;
 	dgFloat32 m_cachedTimeStep;
 	dgInt32 m_sleepingCounter;
+	dgInt32 m_skeletonSolverMode;
 	dgUnsigned32 m_isInDestructionArrayLRU;
 	dgSkeletonContainer* m_skeleton;
 	OnApplyExtForceAndTorque m_applyExtForces;
@@ -240,6 +245,16 @@ DG_INLINE void dgDynamicBody::SetSkeleton(dgSkeletonContainer* const skeleton)
 	m_skeleton = skeleton;
 }
 
+DG_INLINE dgInt32 dgDynamicBody::GetSkeletonSolverMode() const
+{
+	return m_skeletonSolverMode;
+}
+
+DG_INLINE void dgDynamicBody::SetSkeletonSolverMode(dgInt32 mode)
+{
+	m_skeletonSolverMode = mode;
+}
+
 DG_INLINE const dgVector& dgDynamicBody::GetDampCoeffcient (dgFloat32 timestep)
 {
 	if (dgAbs(m_cachedTimeStep - timestep) > dgFloat32(1.0e-6f)) {
@@ -150,9 +150,6 @@ dgUnsigned32 dgHingeConstraint::JacobianDerivative (dgContraintDescritor& params
 	dgAssert (dgAbs (1.0f - matrix0.m_right.DotProduct(matrix0.m_right).GetScalar()) < dgFloat32 (1.0e-5f)); 
 
 	const dgVector& dir0 = matrix0.m_front;
-	const dgVector& dir1 = matrix0.m_up;
-	const dgVector& dir2 = matrix0.m_right;
-
 	const dgVector& p0 = matrix0.m_posit;
 	const dgVector& p1 = matrix1.m_posit;
 	dgVector q0 (p0 + matrix0.m_front.Scale(MIN_JOINT_PIN_LENGTH));
@@ -165,13 +162,9 @@ dgUnsigned32 dgHingeConstraint::JacobianDerivative (dgContraintDescritor& params
 	InitPointParam (pointDataP, m_stiffness, p0, p1);
 	InitPointParam (pointDataQ, m_stiffness, q0, q1);
 
-	CalculatePointDerivative (0, params, dir0, pointDataP, &m_jointForce[0]); 
-	CalculatePointDerivative (1, params, dir1, pointDataP, &m_jointForce[1]); 
-	CalculatePointDerivative (2, params, dir2, pointDataP, &m_jointForce[2]); 
-	CalculatePointDerivative (3, params, dir1, pointDataQ, &m_jointForce[3]); 
-	CalculatePointDerivative (4, params, dir2, pointDataQ, &m_jointForce[4]); 
+	dgInt32 ret = CalculatePointDerivatives (0, params, matrix0, 0x07, pointDataP, &m_jointForce[0]); 
+	ret += CalculatePointDerivatives (ret, params, matrix0, 0x06, pointDataQ, &m_jointForce[ret]); 
 
-	dgInt32 ret = 5;
 	if (m_jointAccelFnt) {
 		dgJointCallbackParam axisParam;
 		axisParam.m_accel = dgFloat32 (0.0f);
@@ -653,6 +653,20 @@ void dgInverseDynamics::Finalize()
 	}
 }
 
+DG_INLINE dgFloat32 dgInverseDynamics::DotProduct(dgInt32 size, const dgFloat32* const a, const dgFloat32* const b) const
+{
+	dgInt32 i = 0;
+	dgVector acc(dgVector::m_zero);
+	for (; i <= size - 4; i += 4) {
+		acc = acc + dgVector(&a[i]) * dgVector(&b[i]);
+	}
+	dgFloat32 dot = acc.AddHorizontal().GetScalar();
+	for (; i < size; i++) {
+		dot += a[i] * b[i];
+	}
+	return dot;
+}
+
 void dgInverseDynamics::InitMassMatrix(const dgJointInfo* const jointInfoArray, dgLeftHandSide* const matrixRow, dgRightHandSide* const rightHandSide, dgInt8* const memoryBuffer)
 {
 	dgInt32 rowCount = 0;
@@ -857,18 +871,12 @@ void dgInverseDynamics::InitMassMatrix(const dgJointInfo* const jointInfoArray,
 			}
 
 			dgFloat32* const matrixRow11 = &m_massMatrix11[i * m_auxiliaryRowCount];
-			dgFloat32 diagonal = matrixRow11[i];
-			for (dgInt32 k = 0; k < primaryCount; k++) {
-				diagonal += deltaForcePtr[k] * matrixRow10[k];
-			}
+			const dgFloat32 diagonal = matrixRow11[i] + DotProduct(primaryCount, deltaForcePtr, matrixRow10);
 			matrixRow11[i] = dgMax(diagonal, diagDamp[i]);
 
 			for (dgInt32 j = i + 1; j < m_auxiliaryRowCount; j++) {
-				dgFloat32 offDiagonal = dgFloat32(0.0f);
 				const dgFloat32* const row10 = &m_massMatrix10[j * primaryCount];
-				for (dgInt32 k = 0; k < primaryCount; k++) {
-					offDiagonal += deltaForcePtr[k] * row10[k];
-				}
+				const dgFloat32 offDiagonal = DotProduct(primaryCount, deltaForcePtr, row10);
 				matrixRow11[j] += offDiagonal;
 				m_massMatrix11[j * m_auxiliaryRowCount + i] += offDiagonal;
 			}
@@ -1091,7 +1099,7 @@ void dgInverseDynamics::CalculateCloseLoopsForces(dgJacobian* const externalForc
 	for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
 		dgFloat32* const matrixRow10 = &m_massMatrix10[i * primaryCount];
 		u[i] = dgFloat32(0.0f);
-		b[i] -= dgDotProduct(primaryCount, matrixRow10, f);
+		b[i] -= DotProduct(primaryCount, matrixRow10, f);
 	}
 
 	//dgSolveDantzigLCP(m_auxiliaryRowCount, massMatrix11, u, b, low, high);
@@ -83,6 +83,7 @@ class dgInverseDynamics
 	bool SanityCheck(const dgForcePair* const force, const dgForcePair* const accel) const;
 	
 	DG_INLINE void CalculateOpenLoopForce (dgForcePair* const force, const dgForcePair* const accel) const;
+	DG_INLINE dgFloat32 DotProduct (dgInt32 size, const dgFloat32* const a, const dgFloat32* const b) const;
 	DG_INLINE dgInt32 GetJacobianDerivatives (dgBilateralConstraint* const constraint, dgContraintDescritor& constraintParams) const;
 	DG_INLINE void CalculateJointAccel(dgJointInfo* const jointInfoArray, dgRightHandSide* const rightHandSide, dgForcePair* const accel) const;
 	DG_INLINE void CalculateRowJacobianDerivatives(dgInt32 index, const dgVector& invMass0, const dgVector& invMass1, const dgMatrix& invInertia0, const dgMatrix& invInertia1, const dgContraintDescritor& constraintParams, dgLeftHandSide* const row, dgRightHandSide* const rightHandSide, int isIkRow) const;
@@ -132,108 +132,208 @@ dgVector dgCollisionContactCloud::m_pruneUpDir(dgFloat32(0.0f), dgFloat32(0.0f),
 dgVector dgCollisionContactCloud::m_pruneSupportX(dgFloat32(1.0f), dgFloat32(0.0f), dgFloat32(0.0f), dgFloat32(0.0f));
 
 
+const dgCollision* dgWorld::FindCachedShape (dgUnsigned32 signature, dgCollisionID id)
+{
+	if (m_sharedShapeCache && dgCollisionShapeCache::IsCacheable(id)) {
+		// meshes saved from a world that does not share shapes have no signature
+		return signature ? dgCollisionShapeCache::GetCache().Find (signature, id) : NULL;
+	}
+	dgBodyCollisionList::dgTreeNode* const node = dgBodyCollisionList::Find (signature);
+	return node ? node->GetInfo()->AddRef() : NULL;
+}
+
+const dgCollision* dgWorld::AddCachedShape (const dgCollision* const shape)
+{
+	if (shape->GetAllocator() != m_allocator) {
+		if (shape->IsType (dgCollision::dgCollisionMesh_RTTI)) {
+			// meshes are only known after they are built, they are keyed by content
+			dgCollision* const mesh = (dgCollision*) shape;
+			mesh->SetSignature (0);
+			mesh->SetSignature (dgInt32 (dgCollisionShapeCache::CalculateSignature (mesh)));
+		}
+		return dgCollisionShapeCache::GetCache().AddShape (shape);
+	}
+	if (dgBodyCollisionList::Insert (shape, shape->GetSignature())) {
+		shape->AddRef();
+	}
+	return shape;
+}
+
+dgCollisionInstance* dgWorld::CreateCachedInstance (const dgCollision* const shape, dgInt32 shapeID, const dgMatrix& offsetMatrix)
+{
+	dgCollisionInstance* const instance = CreateInstance (shape, shapeID, offsetMatrix);
+	shape->Release();
+	return instance;
+}
+
+void dgWorld::ShareCollisionShape (dgCollisionInstance* const instance)
+{
+	dgCollision* const shape = (dgCollision*) instance->GetChildShape();
+	if (shape->IsType (dgCollision::dgCollisionBVH_RTTI) && (shape->GetAllocator() == dgCollisionShapeCache::GetCache().GetAllocator())) {
+		shape->AddRef();
+		const dgCollision* const sharedShape = AddCachedShape (shape);
+		instance->SetChildShape ((dgCollision*) sharedShape);
+		sharedShape->Release();
+	}
+}
+
 dgCollisionInstance* dgWorld::CreateNull ()
 {
 	dgUnsigned32 crc = dgCollision::dgCollisionNull_RTTI;
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* const collision = new  (m_allocator) dgCollisionNull (m_allocator, crc);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_nullCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_nullCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionNull (allocator, crc));
 	}
-	return CreateInstance (node->GetInfo(), 0, dgGetIdentityMatrix());
+	return CreateCachedInstance (collision, 0, dgGetIdentityMatrix());
 }
 
 dgCollisionInstance* dgWorld::CreateSphere(dgFloat32 radii, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionSphere::CalculateSignature (radii);
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* const collision = new  (m_allocator) dgCollisionSphere (m_allocator, crc, dgAbs(radii));
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_sphereCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_sphereCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionSphere (allocator, crc, dgAbs(radii)));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateBox(dgFloat32 dx, dgFloat32 dy, dgFloat32 dz, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionBox::CalculateSignature(dx, dy, dz);
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* const collision = new  (m_allocator) dgCollisionBox (m_allocator, crc, dx, dy, dz);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_boxCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_boxCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionBox (allocator, crc, dx, dy, dz));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateCapsule (dgFloat32 radio0, dgFloat32 radio1, dgFloat32 height, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionCapsule::CalculateSignature(dgAbs (radio0), dgAbs (radio1), dgAbs (height) * dgFloat32 (0.5f));
-
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* collision = new  (m_allocator) dgCollisionCapsule (m_allocator, crc, radio0, radio1, height);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_capsuleCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_capsuleCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionCapsule (allocator, crc, radio0, radio1, height));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateCylinder (dgFloat32 radio0, dgFloat32 radio1, dgFloat32 height, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionCylinder::CalculateSignature(dgAbs (radio0), dgAbs (radio1), dgAbs (height) * dgFloat32 (0.5f));
-
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* collision = new  (m_allocator) dgCollisionCylinder (m_allocator, crc, radio0, radio1, height);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_cylinderCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_cylinderCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionCylinder (allocator, crc, radio0, radio1, height));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateChamferCylinder (dgFloat32 radius, dgFloat32 height, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionChamferCylinder::CalculateSignature(dgAbs (radius), dgAbs (height) * dgFloat32 (0.5f));
-
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* collision = new  (m_allocator) dgCollisionChamferCylinder (m_allocator, crc, radius, height);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_chamferCylinderCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_chamferCylinderCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionChamferCylinder (allocator, crc, radius, height));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateCone (dgFloat32 radius, dgFloat32 height, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionCone::CalculateSignature (dgAbs (radius), dgAbs (height) * dgFloat32 (0.5f));
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-	if (!node) {
-		dgCollision* const collision = new (m_allocator) dgCollisionCone (m_allocator, crc, radius, height);
-		node = dgBodyCollisionList::Insert (collision, crc);
+	const dgCollision* collision = FindCachedShape (crc, m_coneCollision);
+	if (!collision) {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_coneCollision);
+		collision = AddCachedShape (new (allocator) dgCollisionCone (allocator, crc, radius, height));
 	}
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
 }
 
 dgCollisionInstance* dgWorld::CreateConvexHull (dgInt32 count, const dgFloat32* const vertexArray, dgInt32 strideInBytes, dgFloat32 tolerance, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgUnsigned32 crc = dgCollisionConvexHull::CalculateSignature (count, vertexArray, strideInBytes);
-
-	dgBodyCollisionList::dgTreeNode* node = dgBodyCollisionList::Find (crc);
-
-	if (!node) {
+	const dgCollision* collision = FindCachedShape (crc, m_convexHullCollision);
+	if (!collision) {
 		// shape not found create a new one and add to the cache
-		dgCollisionConvexHull* const collision = new (m_allocator) dgCollisionConvexHull (m_allocator, crc, count, strideInBytes, tolerance, vertexArray);
-		if (collision->GetConvexVertexCount()) {
-			node = dgBodyCollisionList::Insert (collision, crc);
-		} else {
+		dgMemoryAllocator* const allocator = GetShapeAllocator (m_convexHullCollision);
+		dgCollisionConvexHull* const hull = new (allocator) dgCollisionConvexHull (allocator, crc, count, strideInBytes, tolerance, vertexArray);
+		if (!hull->GetConvexVertexCount()) {
 			//most likely the point cloud is a plane or a line
 			//could not make the shape destroy the shell and return NULL 
 			//note this is the only newton shape that can return NULL;
-			collision->Release();
+			hull->Release();
 			return NULL;
 		}
+		collision = AddCachedShape (hull);
 	}
 
 	// add reference to the shape and return the collision pointer
-	return CreateInstance (node->GetInfo(), shapeID, offsetMatrix);
+	return CreateCachedInstance (collision, shapeID, offsetMatrix);
+}
+
+dgInt32 dgWorld::CreateCollisionLod (dgCollisionInstance* const instance, dgCollisionInstance::dgLodType type, dgInt32 maxVertexCount)
+{
+	const dgCollision* const shape = instance->GetLodShape(0);
+	const bool isConvex = shape->IsType (dgCollision::dgCollisionConvexShape_RTTI);
+	const bool isCompound = shape->IsType (dgCollision::dgCollisionCompound_RTTI) && !shape->IsType (dgCollision::dgCollisionScene_RTTI);
+	if (!(isConvex || isCompound) || (instance->GetLodCount() >= DG_MAX_COLLISION_LOD)) {
+		return -1;
+	}
+
+	// proxies are made in the space of the full detail shape so that the instance matrix and scale apply to all levels
+	dgCollisionInstance* proxy = NULL;
+	switch (type) 
+	{
+		case dgCollisionInstance::m_lodBoundingBox:
+		{
+			dgVector p0;
+			dgVector p1;
+			shape->CalcAABB (dgGetIdentityMatrix(), p0, p1);
+			const dgVector size (p1 - p0);
+			const dgVector origin ((p1 + p0) * dgVector::m_half);
+			if (origin.DotProduct(origin).GetScalar() < dgFloat32 (1.0e-6f) * size.DotProduct(size).GetScalar()) {
+				proxy = CreateBox (size.m_x, size.m_y, size.m_z, 0, dgGetIdentityMatrix());
+			} else {
+				dgVector box[8];
+				for (dgInt32 i = 0; i < 8; i ++) {
+					box[i] = dgVector ((i & 1) ? p1.m_x : p0.m_x, (i & 2) ? p1.m_y : p0.m_y, (i & 4) ? p1.m_z : p0.m_z, dgFloat32 (0.0f));
+				}
+				proxy = CreateConvexHull (8, &box[0].m_x, sizeof (dgVector), dgFloat32 (0.0f), 0, dgGetIdentityMatrix());
+			}
+			break;
+		}
+
+		case dgCollisionInstance::m_lodConvexHull:
+		default:
+		{
+			// support points along a spiral of directions, the hull has at most one vertex per direction
+			const dgInt32 count = dgClamp (maxVertexCount, 8, 256);
+			dgStack<dgVector> pointPool (count);
+			dgVector* const points = &pointPool[0];
+			const dgFloat32 goldenAngle = dgPi * (dgFloat32 (3.0f) - dgSqrt (dgFloat32 (5.0f)));
+			for (dgInt32 i = 0; i < count; i ++) {
+				const dgFloat32 y = dgFloat32 (1.0f) - dgFloat32 (2.0f) * (dgFloat32 (i) + dgFloat32 (0.5f)) / count;
+				const dgFloat32 r = dgSqrt (dgMax (dgFloat32 (1.0f) - y * y, dgFloat32 (0.0f)));
+				const dgFloat32 angle = goldenAngle * dgFloat32 (i);
+				const dgVector dir (dgCos (angle) * r, y, dgSin (angle) * r, dgFloat32 (0.0f));
+				points[i] = shape->SupportVertex (dir, NULL) & dgVector::m_triplexMask;
+			}
+			proxy = CreateConvexHull (count, &points[0].m_x, sizeof (dgVector), dgFloat32 (1.0e-3f), 0, dgGetIdentityMatrix());
+			break;
+		}
+	}
+
+	if (!proxy) {
+		return -1;
+	}
+	const dgInt32 lod = instance->AddLodShape (proxy->GetChildShape());
+	proxy->Release();
+	return lod;
 }
 
 dgCollisionInstance* dgWorld::CreateCompound ()
@@ -286,8 +386,21 @@ dgCollisionInstance* dgWorld::CreateDeformableSolid (dgMeshEffect* const mesh, d
 
 dgCollisionInstance* dgWorld::CreateBVH ()	
 {
-	// collision tree are not cached
-	dgCollision* const collision = new  (m_allocator) dgCollisionBVH (this);
+	// collision tree are only cached when the world shares shapes, see ShareCollisionShape
+	dgCollision* const collision = new  (GetShapeAllocator (m_boundingBoxHierachy)) dgCollisionBVH (this);
+	dgCollisionInstance* const instance = CreateInstance (collision, 0, dgGetIdentityMatrix()); 
+	collision->Release();
+	return instance;
+}
+
+dgCollisionInstance* dgWorld::CreateBVHFromImage (const void* const image, dgInt32 sizeInBytes)
+{
+	// the image is used in place and must outlive the collision
+	const dgAABBPolygonSoup::dgImageHeader* const header = dgAABBPolygonSoup::GetImageHeader (image, sizeInBytes);
+	if (!header) {
+		return NULL;
+	}
+	dgCollision* const collision = new  (m_allocator) dgCollisionBVH (this, header);
 	dgCollisionInstance* const instance = CreateInstance (collision, 0, dgGetIdentityMatrix()); 
 	collision->Release();
 	return instance;
@@ -315,6 +428,20 @@ dgCollisionInstance* dgWorld::CreateHeightField(
 	return instance;
 }
 
+dgCollisionInstance* dgWorld::CreatePagedHeightField(
+	dgInt32 width, dgInt32 height, dgInt32 contructionMode, dgInt32 elevationDataType, 
+	dgFloat32 minElevation, dgFloat32 maxElevation, dgFloat32 verticalScale, dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z, 
+	dgCollisionHeightFieldPageProvider pageProvider, void* const providerUserData, dgInt32 memoryBudgetInBytes)
+{
+	dgCollision* const collision = new  (m_allocator) dgCollisionHeightField (this, width, height, contructionMode, 
+																			  elevationDataType	? dgCollisionHeightField::m_unsigned16Bit : dgCollisionHeightField::m_float32Bit,	
+																			  minElevation, maxElevation, verticalScale, horizontalScale_x, horizontalScale_z,
+																			  pageProvider, providerUserData, memoryBudgetInBytes);
+	dgCollisionInstance* const instance = CreateInstance (collision, 0, dgGetIdentityMatrix()); 
+	collision->Release();
+	return instance;
+}
+
 dgCollisionInstance* dgWorld::CreateInstance (const dgCollision* const child, dgInt32 shapeID, const dgMatrix& offsetMatrix)
 {
 	dgAssert (dgAbs (offsetMatrix[0].DotProduct(offsetMatrix[0]).GetScalar() - dgFloat32 (1.0f)) < dgFloat32 (1.0e-5f));
@@ -400,13 +527,17 @@ dgUnsigned32 dgWorld::CreateBodyGroupID()
 
 void dgWorld::ReleaseCollision(const dgCollision* const collision)
 {
-	dgInt32 ref = collision->Release();
-	if (ref == 1) {
-		dgBodyCollisionList::dgTreeNode* const node = dgBodyCollisionList::Find (collision->m_signature);
-		if (node) {
-			dgAssert (node->GetInfo() == collision);
-			collision->Release();
-			dgBodyCollisionList::Remove (node);
+	if (collision->GetAllocator() != m_allocator) {
+		dgCollisionShapeCache::GetCache().ReleaseShape (collision);
+	} else {
+		dgInt32 ref = collision->Release();
+		if (ref == 1) {
+			dgBodyCollisionList::dgTreeNode* const node = dgBodyCollisionList::Find (collision->m_signature);
+			if (node) {
+				dgAssert (node->GetInfo() == collision);
+				collision->Release();
+				dgBodyCollisionList::Remove (node);
+			}
 		}
 	}
 }
@@ -61,6 +61,15 @@ class dgSkeletonContainer::dgBodyJointMatrixDataPair
 	dgMatriData m_joint;
 } DG_GCC_VECTOR_ALIGMENT;
 
+// a closed range of the post order node array that only depends on the trunk through its subtree roots
+class dgSkeletonContainer::dgSubtree
+{
+	public:
+	dgInt16 m_start;
+	dgInt16 m_end;
+	dgInt32 m_auxiliaryRowCount;
+};
+
 class dgSkeletonContainer::dgNode
 {
 	public:
@@ -370,6 +379,499 @@ class dgSkeletonContainer::dgNode
 
 dgInt64 dgSkeletonContainer::dgNode::m_ordinalInit = 0x050403020100ll;
 
+// supernodal Cholesky factorization of the joint space mass matrix of all unbounded rows. 
+// each supernode is a run of rows acting on the same pair of bodies, the elimination order is 
+// a minimum degree ordering of the supernode graph and the symbolic factorization is reused
+// for as long as the rows and the body pairs of the skeleton do not change.
+class dgSkeletonContainer::dgSparseSolver
+{
+	public:
+	DG_CLASS_ALLOCATOR(allocator)
+
+	dgSparseSolver(dgMemoryAllocator* const allocator)
+		:m_signatureRowCount(allocator)
+		,m_signaturePairs(allocator)
+		,m_rowStart(allocator)
+		,m_rowCount(allocator)
+		,m_pairs(allocator)
+		,m_columnStart(allocator)
+		,m_columnIndex(allocator)
+		,m_blockOffset(allocator)
+		,m_diagOffset(allocator)
+		,m_values(allocator)
+		,m_boundedMemory(allocator)
+		,m_boundedMatrix10(NULL)
+		,m_boundedDeltaForce(NULL)
+		,m_boundedMatrix11(NULL)
+		,m_superNodeCount(0)
+		,m_valueCount(0)
+		,m_size(0)
+	{
+	}
+
+	static DG_INLINE dgFloat32 CalculateRowCoupling(const dgLeftHandSide* const row_i, const dgNodePair& pair_i, const dgLeftHandSide* const row_j, const dgNodePair& pair_j)
+	{
+		dgVector acc(dgVector::m_zero);
+		if (pair_i.m_m0 == pair_j.m_m0) {
+			acc += row_i->m_JMinv.m_jacobianM0.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + row_i->m_JMinv.m_jacobianM0.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
+		} else if (pair_i.m_m0 == pair_j.m_m1) {
+			acc += row_i->m_JMinv.m_jacobianM0.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + row_i->m_JMinv.m_jacobianM0.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
+		}
+
+		if (pair_i.m_m1 == pair_j.m_m1) {
+			acc += row_i->m_JMinv.m_jacobianM1.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + row_i->m_JMinv.m_jacobianM1.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
+		} else if (pair_i.m_m1 == pair_j.m_m0) {
+			acc += row_i->m_JMinv.m_jacobianM1.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + row_i->m_JMinv.m_jacobianM1.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
+		}
+		return acc.AddHorizontal().GetScalar();
+	}
+
+	static DG_INLINE bool AreCoupled(const dgNodePair& pair_i, const dgNodePair& pair_j)
+	{
+		// index zero is the sentinel body, rows attached to static bodies do not couple through it
+		return (pair_i.m_m0 && ((pair_i.m_m0 == pair_j.m_m0) || (pair_i.m_m0 == pair_j.m_m1))) ||
+			   (pair_i.m_m1 && ((pair_i.m_m1 == pair_j.m_m0) || (pair_i.m_m1 == pair_j.m_m1)));
+	}
+
+	static DG_INLINE dgInt32 BitCount(dgUnsigned32 bits)
+	{
+		bits = bits - ((bits >> 1) & 0x55555555);
+		bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+		return dgInt32((((bits + (bits >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24);
+	}
+
+	bool Init(const dgNodePair* const pairs, dgInt32 size)
+	{
+		// split the rows in runs acting on the same bodies, and compare with the previous frame
+		dgInt32 count = 0;
+		bool changed = (size != m_size);
+		for (dgInt32 i = 0; i < size; ) {
+			dgInt32 rows = 1;
+			while (((i + rows) < size) && (rows < DG_SKELETON_SUPERNODE_MAX_ROWS) && (pairs[i + rows].m_m0 == pairs[i].m_m0) && (pairs[i + rows].m_m1 == pairs[i].m_m1)) {
+				rows++;
+			}
+			if (!changed) {
+				changed = (count >= m_superNodeCount) || (m_signatureRowCount[count] != rows) || (m_signaturePairs[count].m_m0 != pairs[i].m_m0) || (m_signaturePairs[count].m_m1 != pairs[i].m_m1);
+			}
+			m_signatureRowCount[count] = rows;
+			m_signaturePairs[count] = pairs[i];
+			count++;
+			i += rows;
+		}
+		changed = changed || (count != m_superNodeCount);
+		m_superNodeCount = count;
+		m_size = size;
+		if (changed) {
+			BuildSymbolicFactorization();
+		}
+		return changed;
+	}
+
+	void BuildSymbolicFactorization()
+	{
+		D_TRACKTIME();
+		const dgInt32 count = m_superNodeCount;
+		for (dgInt32 i = 0, rowStart = 0; i < count; i++) {
+			m_rowStart[i] = rowStart;
+			m_rowCount[i] = m_signatureRowCount[i];
+			m_pairs[i] = m_signaturePairs[i];
+			rowStart += m_signatureRowCount[i];
+		}
+
+		const dgInt32 words = (count + 31) >> 5;
+		dgStack<dgUnsigned32> graphPool(count * words);
+		dgStack<dgInt32> degreePool(count);
+		dgStack<dgInt32> positionPool(count);
+		dgStack<dgInt32> permutationPool(count);
+		dgUnsigned32* const graph = &graphPool[0];
+		dgInt32* const degree = &degreePool[0];
+		dgInt32* const position = &positionPool[0];
+		dgInt32* const permutation = &permutationPool[0];
+
+		memset(graph, 0, count * words * sizeof(dgUnsigned32));
+		for (dgInt32 i = 0; i < count; i++) {
+			for (dgInt32 j = i + 1; j < count; j++) {
+				if (AreCoupled(m_pairs[i], m_pairs[j])) {
+					graph[i * words + (j >> 5)] |= dgUnsigned32(1) << (j & 31);
+					graph[j * words + (i >> 5)] |= dgUnsigned32(1) << (i & 31);
+				}
+			}
+		}
+		for (dgInt32 i = 0; i < count; i++) {
+			dgInt32 acc = 0;
+			for (dgInt32 j = 0; j < words; j++) {
+				acc += BitCount(graph[i * words + j]);
+			}
+			degree[i] = acc;
+			position[i] = -1;
+		}
+
+		// minimum degree ordering on the elimination graph, the neighbors of each
+		// eliminated supernode are the block structure of its column in the factor.
+		dgInt32 structureCount = 0;
+		m_columnStart[0] = 0;
+		for (dgInt32 k = 0; k < count; k++) {
+			dgInt32 pivot = -1;
+			for (dgInt32 i = 0; i < count; i++) {
+				if ((position[i] < 0) && ((pivot < 0) || (degree[i] < degree[pivot]))) {
+					pivot = i;
+				}
+			}
+			position[pivot] = k;
+			permutation[k] = pivot;
+
+			dgUnsigned32* const pivotRow = &graph[pivot * words];
+			for (dgInt32 j = 0; j < words; j++) {
+				for (dgUnsigned32 bits = pivotRow[j]; bits; bits &= bits - 1) {
+					const dgInt32 neighbor = (j << 5) + BitCount((bits & (0 - bits)) - 1);
+					m_columnIndex[structureCount] = neighbor;
+					structureCount++;
+
+					dgUnsigned32* const neighborRow = &graph[neighbor * words];
+					dgInt32 acc = 0;
+					for (dgInt32 n = 0; n < words; n++) {
+						neighborRow[n] |= pivotRow[n];
+					}
+					neighborRow[neighbor >> 5] &= ~(dgUnsigned32(1) << (neighbor & 31));
+					neighborRow[pivot >> 5] &= ~(dgUnsigned32(1) << (pivot & 31));
+					for (dgInt32 n = 0; n < words; n++) {
+						acc += BitCount(neighborRow[n]);
+					}
+					degree[neighbor] = acc;
+				}
+			}
+			m_columnStart[k + 1] = structureCount;
+		}
+
+		// move everything to elimination order
+		dgStack<dgInt32> rowStartPool(count);
+		dgStack<dgInt32> rowCountPool(count);
+		dgStack<dgNodePair> pairsPool(count);
+		for (dgInt32 k = 0; k < count; k++) {
+			const dgInt32 i = permutation[k];
+			rowStartPool[k] = m_rowStart[i];
+			rowCountPool[k] = m_rowCount[i];
+			pairsPool[k] = m_pairs[i];
+		}
+
+		dgInt32 valueCount = 0;
+		for (dgInt32 k = 0; k < count; k++) {
+			m_rowStart[k] = rowStartPool[k];
+			m_rowCount[k] = rowCountPool[k];
+			m_pairs[k] = pairsPool[k];
+
+			const dgInt32 start = m_columnStart[k];
+			const dgInt32 end = m_columnStart[k + 1];
+			for (dgInt32 i = start; i < end; i++) {
+				m_columnIndex[i] = position[m_columnIndex[i]];
+			}
+			for (dgInt32 i = start + 1; i < end; i++) {
+				const dgInt32 tmp = m_columnIndex[i];
+				dgInt32 j = i;
+				for (; (j > start) && (m_columnIndex[j - 1] > tmp); j--) {
+					m_columnIndex[j] = m_columnIndex[j - 1];
+				}
+				m_columnIndex[j] = tmp;
+			}
+
+			m_diagOffset[k] = valueCount;
+			valueCount += rowCountPool[k] * rowCountPool[k];
+			for (dgInt32 i = start; i < end; i++) {
+				m_blockOffset[i] = valueCount;
+				valueCount += rowCountPool[m_columnIndex[i]] * rowCountPool[k];
+			}
+		}
+		m_values.ResizeIfNecessary(valueCount);
+		m_valueCount = valueCount;
+	}
+
+	DG_INLINE dgFloat32* FindBlock(dgInt32 row, dgInt32 column)
+	{
+		dgInt32 i0 = m_columnStart[column];
+		dgInt32 i1 = m_columnStart[column + 1] - 1;
+		while (i0 < i1) {
+			const dgInt32 mid = (i0 + i1) >> 1;
+			if (m_columnIndex[mid] < row) {
+				i0 = mid + 1;
+			} else {
+				i1 = mid;
+			}
+		}
+		dgAssert(m_columnIndex[i0] == row);
+		return &m_values[m_blockOffset[i0]];
+	}
+
+	void Factorize(const dgSkeletonContainer* const skeleton, const dgFloat32* const diagDamp)
+	{
+		D_TRACKTIME();
+		const dgInt32 count = m_superNodeCount;
+		const dgLeftHandSide* const leftHandSide = skeleton->m_leftHandSide;
+		const dgInt32* const rowsIndex = skeleton->m_matrixRowsIndex;
+		const dgNodePair* const rowPairs = skeleton->m_pairs;
+		dgFloat32* const values = &m_values[0];
+
+		memset(values, 0, m_valueCount * sizeof(dgFloat32));
+		for (dgInt32 k = 0; k < count; k++) {
+			const dgInt32 rowStart = m_rowStart[k];
+			const dgInt32 rows = m_rowCount[k];
+			dgFloat32* const diag = &values[m_diagOffset[k]];
+			for (dgInt32 i = 0; i < rows; i++) {
+				const dgLeftHandSide* const row_i = &leftHandSide[rowsIndex[rowStart + i]];
+				for (dgInt32 j = 0; j <= i; j++) {
+					const dgLeftHandSide* const row_j = &leftHandSide[rowsIndex[rowStart + j]];
+					const dgFloat32 value = CalculateRowCoupling(row_i, rowPairs[rowStart + i], row_j, rowPairs[rowStart + j]);
+					diag[i * rows + j] = value;
+					diag[j * rows + i] = value;
+				}
+				diag[i * rows + i] += diagDamp[rowStart + i];
+			}
+
+			for (dgInt32 n = m_columnStart[k]; n < m_columnStart[k + 1]; n++) {
+				const dgInt32 q = m_columnIndex[n];
+				if (AreCoupled(m_pairs[k], m_pairs[q])) {
+					const dgInt32 qStart = m_rowStart[q];
+					const dgInt32 qRows = m_rowCount[q];
+					dgFloat32* const block = &values[m_blockOffset[n]];
+					for (dgInt32 i = 0; i < qRows; i++) {
+						const dgLeftHandSide* const row_i = &leftHandSide[rowsIndex[qStart + i]];
+						for (dgInt32 j = 0; j < rows; j++) {
+							const dgLeftHandSide* const row_j = &leftHandSide[rowsIndex[rowStart + j]];
+							block[i * rows + j] = CalculateRowCoupling(row_i, rowPairs[qStart + i], row_j, rowPairs[rowStart + j]);
+						}
+					}
+				}
+			}
+		}
+
+		dgFloat32 backup[DG_SKELETON_SUPERNODE_MAX_ROWS * DG_SKELETON_SUPERNODE_MAX_ROWS];
+		for (dgInt32 k = 0; k < count; k++) {
+			const dgInt32 rows = m_rowCount[k];
+			dgFloat32* const diag = &values[m_diagOffset[k]];
+
+			memcpy(backup, diag, rows * rows * sizeof(dgFloat32));
+			dgFloat32 regularizer = DG_PSD_DAMP_TOL;
+			while (!dgCholeskyFactorization(rows, rows, diag)) {
+				// the updates from previous columns can make this block loose definiteness in single precision
+				memcpy(diag, backup, rows * rows * sizeof(dgFloat32));
+				for (dgInt32 i = 0; i < rows; i++) {
+					diag[i * rows + i] += backup[i * rows + i] * regularizer;
+				}
+				regularizer *= dgFloat32(4.0f);
+			}
+
+			const dgInt32 start = m_columnStart[k];
+			const dgInt32 end = m_columnStart[k + 1];
+			for (dgInt32 n = start; n < end; n++) {
+				// L_qk = A_qk * inv(L_kk)'
+				const dgInt32 qRows = m_rowCount[m_columnIndex[n]];
+				dgFloat32* const block = &values[m_blockOffset[n]];
+				for (dgInt32 i = 0; i < qRows; i++) {
+					dgFloat32* const row = &block[i * rows];
+					for (dgInt32 j = 0; j < rows; j++) {
+						const dgFloat32* const diagRow = &diag[j * rows];
+						dgFloat32 acc = row[j];
+						for (dgInt32 m = 0; m < j; m++) {
+							acc -= diagRow[m] * row[m];
+						}
+						row[j] = acc / diagRow[j];
+					}
+				}
+			}
+
+			for (dgInt32 n0 = start; n0 < end; n0++) {
+				const dgInt32 q0 = m_columnIndex[n0];
+				const dgInt32 q0Rows = m_rowCount[q0];
+				const dgFloat32* const block0 = &values[m_blockOffset[n0]];
+				for (dgInt32 n1 = start; n1 <= n0; n1++) {
+					const dgInt32 q1 = m_columnIndex[n1];
+					const dgInt32 q1Rows = m_rowCount[q1];
+					const dgFloat32* const block1 = &values[m_blockOffset[n1]];
+					dgFloat32* const target = (q0 == q1) ? &values[m_diagOffset[q0]] : FindBlock(q0, q1);
+					for (dgInt32 i = 0; i < q0Rows; i++) {
+						const dgFloat32* const row0 = &block0[i * rows];
+						for (dgInt32 j = 0; j < q1Rows; j++) {
+							target[i * q1Rows + j] -= dgDotProduct(rows, row0, &block1[j * rows]);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void Solve(dgFloat32* const x) const
+	{
+		const dgInt32 count = m_superNodeCount;
+		const dgFloat32* const values = &m_values[0];
+		for (dgInt32 k = 0; k < count; k++) {
+			const dgInt32 rows = m_rowCount[k];
+			const dgFloat32* const diag = &values[m_diagOffset[k]];
+			dgFloat32* const xk = &x[m_rowStart[k]];
+			for (dgInt32 i = 0; i < rows; i++) {
+				xk[i] = (xk[i] - dgDotProduct(i, &diag[i * rows], xk)) / diag[i * rows + i];
+			}
+			for (dgInt32 n = m_columnStart[k]; n < m_columnStart[k + 1]; n++) {
+				const dgInt32 q = m_columnIndex[n];
+				const dgFloat32* const block = &values[m_blockOffset[n]];
+				dgFloat32* const xq = &x[m_rowStart[q]];
+				for (dgInt32 i = 0; i < m_rowCount[q]; i++) {
+					xq[i] -= dgDotProduct(rows, &block[i * rows], xk);
+				}
+			}
+		}
+
+		for (dgInt32 k = count - 1; k >= 0; k--) {
+			const dgInt32 rows = m_rowCount[k];
+			const dgFloat32* const diag = &values[m_diagOffset[k]];
+			dgFloat32* const xk = &x[m_rowStart[k]];
+			for (dgInt32 n = m_columnStart[k]; n < m_columnStart[k + 1]; n++) {
+				const dgInt32 q = m_columnIndex[n];
+				const dgFloat32* const block = &values[m_blockOffset[n]];
+				const dgFloat32* const xq = &x[m_rowStart[q]];
+				for (dgInt32 i = 0; i < m_rowCount[q]; i++) {
+					dgMulAdd(rows, xk, xk, &block[i * rows], -xq[i]);
+				}
+			}
+			for (dgInt32 i = rows - 1; i >= 0; i--) {
+				dgFloat32 acc = xk[i];
+				for (dgInt32 j = i + 1; j < rows; j++) {
+					acc -= diag[j * rows + i] * xk[j];
+				}
+				xk[i] = acc / diag[i * rows + i];
+			}
+		}
+	}
+
+	dgArray<dgInt32> m_signatureRowCount;
+	dgArray<dgNodePair> m_signaturePairs;
+	dgArray<dgInt32> m_rowStart;
+	dgArray<dgInt32> m_rowCount;
+	dgArray<dgNodePair> m_pairs;
+	dgArray<dgInt32> m_columnStart;
+	dgArray<dgInt32> m_columnIndex;
+	dgArray<dgInt32> m_blockOffset;
+	dgArray<dgInt32> m_diagOffset;
+	dgArray<dgFloat32> m_values;
+	dgArray<dgFloat32> m_boundedMemory;
+	dgFloat32* m_boundedMatrix10;
+	dgFloat32* m_boundedDeltaForce;
+	dgFloat32* m_boundedMatrix11;
+	dgInt32 m_superNodeCount;
+	dgInt32 m_valueCount;
+	dgInt32 m_size;
+};
+
+// coupling pattern of the loop mass matrix, the rows of a skeleton only couple through shared bodies,
+// so the pattern only changes when the row layout or the body pairs of the rows change.
+class dgSkeletonContainer::dgLoopLayout
+{
+	public:
+	DG_CLASS_ALLOCATOR(allocator)
+	dgLoopLayout(dgMemoryAllocator* const allocator)
+		:m_signaturePairs(allocator)
+		,m_startJoint(allocator)
+		,m_row10Start(allocator)
+		,m_row10Columns(allocator)
+		,m_row11Start(allocator)
+		,m_row11Columns(allocator)
+		,m_rowCount(-1)
+		,m_auxiliaryRowCount(-1)
+	{
+	}
+
+	bool Init(const dgSkeletonContainer* const skeleton)
+	{
+		const dgInt32 rowCount = skeleton->m_rowCount;
+		const dgInt32 auxiliaryCount = skeleton->m_auxiliaryRowCount;
+		const dgNodePair* const pairs = skeleton->m_pairs;
+
+		bool changed = (rowCount != m_rowCount) || (auxiliaryCount != m_auxiliaryRowCount);
+		for (dgInt32 i = 0; (i < rowCount) && !changed; i++) {
+			changed = (pairs[i].m_m0 != m_signaturePairs[i].m_m0) || (pairs[i].m_m1 != m_signaturePairs[i].m_m1);
+		}
+		if (changed) {
+			m_rowCount = rowCount;
+			m_auxiliaryRowCount = auxiliaryCount;
+			for (dgInt32 i = 0; i < rowCount; i++) {
+				m_signaturePairs[i] = pairs[i];
+			}
+			BuildLayout(skeleton);
+		}
+		return changed;
+	}
+
+	void BuildLayout(const dgSkeletonContainer* const skeleton)
+	{
+		D_TRACKTIME();
+		const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
+		const dgNodePair* const pairs = &m_signaturePairs[0];
+
+		dgInt32* const rowNode = dgAlloca(dgInt32, primaryCount + 1);
+		for (dgInt32 i = 0, row = 0; i < skeleton->m_nodeCount - 1; i++) {
+			const dgNode* const node = skeleton->m_nodesOrder[i];
+			for (dgInt32 j = 0; j < node->m_dof; j++) {
+				rowNode[row] = node->m_index;
+				row++;
+			}
+		}
+
+		dgInt32 count = 0;
+		for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
+			const dgNodePair& pair_i = pairs[primaryCount + i];
+			dgInt32 startJoint = skeleton->m_nodeCount;
+			m_row10Start[i] = count;
+			for (dgInt32 j = 0; j < primaryCount; j++) {
+				if (dgSparseSolver::AreCoupled(pair_i, pairs[j])) {
+					m_row10Columns[count] = j;
+					startJoint = dgMin(startJoint, rowNode[j]);
+					count++;
+				}
+			}
+			m_startJoint[i] = (startJoint == skeleton->m_nodeCount) ? 0 : startJoint;
+		}
+		m_row10Start[m_auxiliaryRowCount] = count;
+
+		count = 0;
+		for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
+			const dgNodePair& pair_i = pairs[primaryCount + i];
+			m_row11Start[i] = count;
+			for (dgInt32 j = i + 1; j < m_auxiliaryRowCount; j++) {
+				if (dgSparseSolver::AreCoupled(pair_i, pairs[primaryCount + j])) {
+					m_row11Columns[count] = primaryCount + j;
+					count++;
+				}
+			}
+		}
+		m_row11Start[m_auxiliaryRowCount] = count;
+	}
+
+	static DG_INLINE dgFloat32 CalculateRowCoupling(const dgJacobian& JMinvM0, const dgJacobian& JMinvM1, const dgNodePair& pair_i, const dgLeftHandSide* const row_j, const dgNodePair& pair_j)
+	{
+		dgVector acc(dgVector::m_zero);
+		if (pair_i.m_m0 == pair_j.m_m0) {
+			acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
+		} else if (pair_i.m_m0 == pair_j.m_m1) {
+			acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
+		}
+
+		if (pair_i.m_m1 == pair_j.m_m1) {
+			acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
+		} else if (pair_i.m_m1 == pair_j.m_m0) {
+			acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
+		}
+		acc = acc.AddHorizontal();
+		return acc.GetScalar();
+	}
+
+	dgArray<dgNodePair> m_signaturePairs;
+	dgArray<dgInt32> m_startJoint;
+	dgArray<dgInt32> m_row10Start;
+	dgArray<dgInt32> m_row10Columns;
+	dgArray<dgInt32> m_row11Start;
+	dgArray<dgInt32> m_row11Columns;
+	dgInt32 m_rowCount;
+	dgInt32 m_auxiliaryRowCount;
+};
+
 dgSkeletonContainer::dgSkeletonContainer(dgWorld* const world, dgDynamicBody* const rootBody)
 	:m_world(world)
 	,m_skeleton(new (world->GetAllocator()) dgNode(rootBody))
@@ -383,16 +885,31 @@ dgSkeletonContainer::dgSkeletonContainer(dgWorld* const world, dgDynamicBody* co
 	,m_frictionIndex(NULL)
 	,m_matrixRowsIndex(NULL)
 	,m_listNode(NULL)
+	,m_sparseSolver(NULL)
+	,m_loopLayout(NULL)
+	,m_subtrees(NULL)
+	,m_trunkNodes(NULL)
+	,m_bodyMassArray(NULL)
+	,m_jointMassArray(NULL)
+	,m_forceArray(NULL)
+	,m_accelArray(NULL)
 	,m_loopingJoints(world->GetAllocator())
 	,m_auxiliaryMemoryBuffer(world->GetAllocator())
+	,m_parallelMemoryBuffer(world->GetAllocator())
 	,m_lru(0)
 	,m_blockSize(0)
+	,m_symbolicReuseCount(0)
+	,m_symbolicBuildCount(0)
 	,m_nodeCount(1)
 	,m_loopCount(0)
 	,m_dynamicsLoopCount(0)
 	,m_rowCount(0)
 	,m_loopRowCount(0)
 	,m_auxiliaryRowCount(0)
+	,m_solverMode(m_tree)
+	,m_subtreeCount(0)
+	,m_trunkCount(0)
+	,m_partitionThreadCount(0)
 {
 	if (rootBody->GetInvMass().m_w != dgFloat32 (0.0f)) {
 		rootBody->SetSkeleton(this);
@@ -414,6 +931,12 @@ dgSkeletonContainer::~dgSkeletonContainer()
 	if (m_nodesOrder) {
 		allocator->Free(m_nodesOrder);
 	}
+	if (m_sparseSolver) {
+		delete m_sparseSolver;
+	}
+	if (m_loopLayout) {
+		delete m_loopLayout;
+	}
 
 	delete m_skeleton;
 }
@@ -557,6 +1080,9 @@ void dgSkeletonContainer::Finalize(dgInt32 loopJointsCount, dgBilateralConstrain
 DG_INLINE void dgSkeletonContainer::CalculateLoopMassMatrixCoefficients(dgFloat32* const diagDamp)
 {
 	const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
+	const dgLoopLayout* const layout = m_loopLayout;
+	const dgInt32* const row10Columns = &layout->m_row10Columns[0];
+	const dgInt32* const row11Columns = &layout->m_row11Columns[0];
 	for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
 		const dgInt32 ii = m_matrixRowsIndex[primaryCount + i];
 		const dgLeftHandSide* const row_i = &m_leftHandSide[ii];
@@ -575,71 +1101,24 @@ DG_INLINE void dgSkeletonContainer::CalculateLoopMassMatrixCoefficients(dgFloat3
 		matrixRow11[i] = diagonal + rhs_i->m_diagDamp;
 		diagDamp[i] = matrixRow11[i] * (DG_PSD_DAMP_TOL * dgFloat32(4.0f));
 
-		const dgInt32 m0_i = m_pairs[primaryCount + i].m_m0;
-		const dgInt32 m1_i = m_pairs[primaryCount + i].m_m1;
-		for (dgInt32 j = i + 1; j < m_auxiliaryRowCount; j++) {
-			const dgInt32 jj = m_matrixRowsIndex[primaryCount + j];
-			const dgLeftHandSide* const row_j = &m_leftHandSide[jj];
-
-			const dgInt32 k = primaryCount + j;
-			dgVector acc(dgVector::m_zero);
-			const dgInt32 m0_j = m_pairs[k].m_m0;
-			const dgInt32 m1_j = m_pairs[k].m_m1;
-			bool hasEffect = false;
-			if (m0_i == m0_j) {
-				hasEffect = true;
-				acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
-			} else if (m0_i == m1_j) {
-				hasEffect = true;
-				acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
-			}
-
-			if (m1_i == m1_j) {
-				hasEffect = true;
-				acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
-			} else if (m1_i == m0_j) {
-				hasEffect = true;
-				acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
-			}
-
-			if (hasEffect) {
-				acc = acc.AddHorizontal();
-				dgFloat32 offDiagValue = acc.GetScalar();
-				matrixRow11[j] = offDiagValue;
-				m_massMatrix11[j * m_auxiliaryRowCount + i] = offDiagValue;
-			}
+		// only visit the rows that share a body with this row
+		const dgNodePair& pair_i = m_pairs[primaryCount + i];
+		const dgInt32 row11End = layout->m_row11Start[i + 1];
+		for (dgInt32 n = layout->m_row11Start[i]; n < row11End; n++) {
+			const dgInt32 k = row11Columns[n];
+			const dgInt32 j = k - primaryCount;
+			const dgLeftHandSide* const row_j = &m_leftHandSide[m_matrixRowsIndex[k]];
+			const dgFloat32 offDiagValue = dgLoopLayout::CalculateRowCoupling(JMinvM0, JMinvM1, pair_i, row_j, m_pairs[k]);
+			matrixRow11[j] = offDiagValue;
+			m_massMatrix11[j * m_auxiliaryRowCount + i] = offDiagValue;
 		}
 
 		dgFloat32* const matrixRow10 = &m_massMatrix10[primaryCount * i];
-		for (dgInt32 j = 0; j < primaryCount; j++) {
-			const dgInt32 jj = m_matrixRowsIndex[j];
-			const dgLeftHandSide* const row_j = &m_leftHandSide[jj];
-
-			const dgInt32 m0_j = m_pairs[j].m_m0;
-			const dgInt32 m1_j = m_pairs[j].m_m1;
-			dgVector acc(dgVector::m_zero);
-			bool hasEffect = false;
-			if (m0_i == m0_j) {
-				hasEffect = true;
-				acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
-			} else if (m0_i == m1_j) {
-				hasEffect = true;
-				acc += JMinvM0.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM0.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
-			}
-
-			if (m1_i == m1_j) {
-				hasEffect = true;
-				acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM1.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM1.m_angular;
-			} else if (m1_i == m0_j) {
-				hasEffect = true;
-				acc += JMinvM1.m_linear * row_j->m_Jt.m_jacobianM0.m_linear + JMinvM1.m_angular * row_j->m_Jt.m_jacobianM0.m_angular;
-			}
-
-			if (hasEffect) {
-				acc = acc.AddHorizontal();
-				dgFloat32 val = acc.GetScalar();
-				matrixRow10[j] = val;
-			}
+		const dgInt32 row10End = layout->m_row10Start[i + 1];
+		for (dgInt32 n = layout->m_row10Start[i]; n < row10End; n++) {
+			const dgInt32 j = row10Columns[n];
+			const dgLeftHandSide* const row_j = &m_leftHandSide[m_matrixRowsIndex[j]];
+			matrixRow10[j] = dgLoopLayout::CalculateRowCoupling(JMinvM0, JMinvM1, pair_i, row_j, m_pairs[j]);
 		}
 	}
 }
@@ -673,21 +1152,9 @@ void dgSkeletonContainer::FactorizeMatrix(dgInt32 size, dgInt32 stride, dgFloat3
 	} while (!isPsdMatrix);
 }
 
-void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoArray)
+void dgSkeletonContainer::InitAuxiliaryRows(const dgJointInfo* const jointInfoArray)
 {
 	const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
-	dgInt8* const memoryBuffer = CalculateBufferSizeInBytes(jointInfoArray);
-
-	m_frictionIndex = (dgInt32*)memoryBuffer;
-	m_matrixRowsIndex = (dgInt32*)&m_frictionIndex[m_rowCount];
-	m_pairs = (dgNodePair*)&m_matrixRowsIndex[m_rowCount];
-	m_massMatrix11 = (dgFloat32*)&m_pairs[m_rowCount];
-	m_massMatrix10 = (dgFloat32*)&m_massMatrix11[m_auxiliaryRowCount * m_auxiliaryRowCount];
-	m_deltaForce = &m_massMatrix10[m_auxiliaryRowCount * primaryCount];
-
-	dgForcePair* const forcePair = dgAlloca(dgForcePair, m_nodeCount);
-	dgForcePair* const accelPair = dgAlloca(dgForcePair, m_nodeCount);
-	dgFloat32* const diagDamp = dgAlloca(dgFloat32, m_auxiliaryRowCount);
 	dgInt32* const boundRow = dgAlloca(dgInt32, m_auxiliaryRowCount);
 
 	m_blockSize = 0;
@@ -772,6 +1239,35 @@ void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoA
 		m_frictionIndex[primaryCount + j] = tmpFrictionIndex;
 		m_matrixRowsIndex[primaryCount + j] = tmpMatrixRowsIndex;
 	}
+}
+
+void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoArray)
+{
+	const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
+	dgInt8* const memoryBuffer = CalculateBufferSizeInBytes(jointInfoArray);
+
+	m_frictionIndex = (dgInt32*)memoryBuffer;
+	m_matrixRowsIndex = (dgInt32*)&m_frictionIndex[m_rowCount];
+	m_pairs = (dgNodePair*)&m_matrixRowsIndex[m_rowCount];
+	m_massMatrix11 = (dgFloat32*)&m_pairs[m_rowCount];
+	m_massMatrix10 = (dgFloat32*)&m_massMatrix11[m_auxiliaryRowCount * m_auxiliaryRowCount];
+	m_deltaForce = &m_massMatrix10[m_auxiliaryRowCount * primaryCount];
+
+	dgForcePair* const forcePair = dgAlloca(dgForcePair, m_nodeCount);
+	dgForcePair* const accelPair = dgAlloca(dgForcePair, m_nodeCount);
+	dgFloat32* const diagDamp = dgAlloca(dgFloat32, m_auxiliaryRowCount);
+
+	InitAuxiliaryRows(jointInfoArray);
+
+	if (!m_loopLayout) {
+		m_loopLayout = new (m_world->GetAllocator()) dgLoopLayout(m_world->GetAllocator());
+	}
+	if (m_loopLayout->Init(this)) {
+		m_symbolicBuildCount++;
+	} else {
+		m_symbolicReuseCount++;
+	}
+	const dgLoopLayout* const layout = m_loopLayout;
 
 	memset(m_massMatrix10, 0, primaryCount * m_auxiliaryRowCount * sizeof(dgFloat32));
 	memset(m_massMatrix11, 0, m_auxiliaryRowCount * m_auxiliaryRowCount * sizeof(dgFloat32));
@@ -783,7 +1279,7 @@ void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoA
 
 	for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
 		dgInt32 entry = 0;
-		dgInt32 startjoint = m_nodeCount;
+		const dgInt32 startjoint = layout->m_startJoint[i];
 		const dgFloat32* const matrixRow10 = &m_massMatrix10[i * primaryCount];
 		for (dgInt32 j = 0; j < m_nodeCount - 1; j++) {
 			const dgNode* const node = m_nodesOrder[j];
@@ -793,15 +1289,12 @@ void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoA
 
 			const int count = node->m_dof;
 			for (dgInt32 k = 0; k < count; k++) {
-				const dgFloat32 value = matrixRow10[entry];
-				a[k] = value;
-				startjoint = (value == 0.0f) ? startjoint : dgMin (startjoint, index);
+				a[k] = matrixRow10[entry];
 				entry++;
 			}
 		}
 
 		entry = 0;
-		startjoint = (startjoint == m_nodeCount) ? 0 : startjoint;
 		dgAssert (startjoint < m_nodeCount);
 		SolveForward(forcePair, accelPair, startjoint);
 		SolveBackward(forcePair, forcePair);
@@ -819,17 +1312,13 @@ void dgSkeletonContainer::InitLoopMassMatrix(const dgJointInfo* const jointInfoA
 		}
 	}
 
-	dgInt16* const indexList = dgAlloca(dgInt16, primaryCount);
+	const dgInt32* const row10Columns = &layout->m_row10Columns[0];
 	for (dgInt32 i = 0; i < m_auxiliaryRowCount; i++) {
 		const dgFloat32* const matrixRow10 = &m_massMatrix10[i * primaryCount];
 		dgFloat32* const matrixRow11 = &m_massMatrix11[i * m_auxiliaryRowCount];
 
-		dgInt32 indexCount = 0;
-		for (dgInt32 k = 0; k < primaryCount; k++) {
-			indexList[indexCount] = dgInt16(k);
-			indexCount += (matrixRow10[k] != dgFloat32(0.0f)) ? 1 : 0;
-		}
-
+		const dgInt32* const indexList = &row10Columns[layout->m_row10Start[i]];
+		const dgInt32 indexCount = layout->m_row10Start[i + 1] - layout->m_row10Start[i];
 		for (dgInt32 j = i; j < m_auxiliaryRowCount; j++) {
 			dgFloat32 offDiagonal = matrixRow11[j];
 			const dgFloat32* const row10 = &m_deltaForce[j * primaryCount];
@@ -887,6 +1376,23 @@ bool dgSkeletonContainer::SanityCheck(const dgForcePair* const force, const dgFo
 	return true;
 }
 
+DG_INLINE void dgSkeletonContainer::SolveNodeForward(dgForcePair* const force, const dgForcePair* const accel, dgInt32 index) const
+{
+	dgNode* const node = m_nodesOrder[index];
+	dgAssert(node->m_joint);
+	dgAssert(node->m_index == index);
+	dgForcePair& f = force[index];
+	const dgForcePair& a = accel[index];
+	f.m_body = a.m_body;
+	f.m_joint = a.m_joint;
+	for (dgNode* child = node->m_child; child; child = child->m_sibling) {
+		dgAssert(child->m_joint);
+		dgAssert(child->m_parent->m_index == index);
+		child->BodyJacobianTimeMassForward(force[child->m_index], f);
+	}
+	node->JointJacobianTimeMassForward(f);
+}
+
 DG_INLINE void dgSkeletonContainer::SolveForward(dgForcePair* const force, const dgForcePair* const accel, dgInt32 startNode) const
 {
 	dgSpatialVector zero (dgSpatialVector::m_zero);
@@ -895,19 +1401,7 @@ DG_INLINE void dgSkeletonContainer::SolveForward(dgForcePair* const force, const
 		force[i].m_joint = zero;
 	}
 	for (dgInt32 i = startNode; i < m_nodeCount - 1; i++) {
-		dgNode* const node = m_nodesOrder[i];
-		dgAssert(node->m_joint);
-		dgAssert(node->m_index == i);
-		dgForcePair& f = force[i];
-		const dgForcePair& a = accel[i];
-		f.m_body = a.m_body;
-		f.m_joint = a.m_joint;
-		for (dgNode* child = node->m_child; child; child = child->m_sibling) {
-			dgAssert(child->m_joint);
-			dgAssert(child->m_parent->m_index == i);
-			child->BodyJacobianTimeMassForward(force[child->m_index], f);
-		}
-		node->JointJacobianTimeMassForward(f);
+		SolveNodeForward(force, accel, i);
 	}
 
 	force[m_nodeCount - 1] = accel[m_nodeCount - 1];
@@ -984,37 +1478,42 @@ DG_INLINE void dgSkeletonContainer::UpdateForces (dgJointInfo* const jointInfoAr
 	}
 }
 
+DG_INLINE void dgSkeletonContainer::CalculateNodeAccel(const dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgForcePair* const accel, dgInt32 index) const
+{
+	dgNode* const node = m_nodesOrder[index];
+	dgAssert(index == node->m_index);
+
+	dgForcePair& a = accel[index];
+	dgAssert(node->m_body);
+	a.m_body = dgSpatialVector::m_zero;
+	a.m_joint = dgSpatialVector::m_zero;
+
+	dgAssert(node->m_joint);
+	const dgJointInfo* const jointInfo = &jointInfoArray[node->m_joint->m_index];
+	dgAssert(jointInfo->m_joint == node->m_joint);
+
+	const dgInt32 first = jointInfo->m_pairStart;
+	const dgInt32 dof = jointInfo->m_pairCount;
+	const dgInt32 m0 = jointInfo->m_m0;
+	const dgInt32 m1 = jointInfo->m_m1;
+	const dgJacobian& y0 = internalForces[m0];
+	const dgJacobian& y1 = internalForces[m1];
+
+	for (dgInt32 j = 0; j < dof; j++) {
+		const dgInt32 k = node->m_sourceJacobianIndex[j];
+		const dgLeftHandSide* const row = &m_leftHandSide[first + k];
+		const dgRightHandSide* const rhs = &m_rightHandSide[first + k];
+		dgVector diag(row->m_JMinv.m_jacobianM0.m_linear * y0.m_linear + row->m_JMinv.m_jacobianM0.m_angular * y0.m_angular +
+					  row->m_JMinv.m_jacobianM1.m_linear * y1.m_linear + row->m_JMinv.m_jacobianM1.m_angular * y1.m_angular);
+		a.m_joint[j] = -(rhs->m_coordenateAccel - rhs->m_force * rhs->m_diagDamp - diag.AddHorizontal().GetScalar());
+	}
+}
+
 DG_INLINE void dgSkeletonContainer::CalculateJointAccel(dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgForcePair* const accel) const
 {
 	const dgSpatialVector zero (dgSpatialVector::m_zero);
 	for (dgInt32 i = 0; i < m_nodeCount - 1; i++) {
-		dgNode* const node = m_nodesOrder[i];
-		dgAssert(i == node->m_index);
-
-		dgForcePair& a = accel[i];
-		dgAssert(node->m_body);
-		a.m_body = zero;
-		a.m_joint = zero;
-
-		dgAssert(node->m_joint);
-		const dgJointInfo* const jointInfo = &jointInfoArray[node->m_joint->m_index];
-		dgAssert(jointInfo->m_joint == node->m_joint);
-
-		const dgInt32 first = jointInfo->m_pairStart;
-		const dgInt32 dof = jointInfo->m_pairCount;
-		const dgInt32 m0 = jointInfo->m_m0;
-		const dgInt32 m1 = jointInfo->m_m1;
-		const dgJacobian& y0 = internalForces[m0];
-		const dgJacobian& y1 = internalForces[m1];
-
-		for (dgInt32 j = 0; j < dof; j++) {
-			const dgInt32 k = node->m_sourceJacobianIndex[j];
-			const dgLeftHandSide* const row = &m_leftHandSide[first + k];
-			const dgRightHandSide* const rhs = &m_rightHandSide[first + k];
-			dgVector diag(row->m_JMinv.m_jacobianM0.m_linear * y0.m_linear + row->m_JMinv.m_jacobianM0.m_angular * y0.m_angular +
-						  row->m_JMinv.m_jacobianM1.m_linear * y1.m_linear + row->m_JMinv.m_jacobianM1.m_angular * y1.m_angular);
-			a.m_joint[j] = -(rhs->m_coordenateAccel - rhs->m_force * rhs->m_diagDamp - diag.AddHorizontal().GetScalar());
-		}
+		CalculateNodeAccel(jointInfoArray, internalForces, accel, i);
 	}
 	dgAssert((m_nodeCount - 1) == m_nodesOrder[m_nodeCount - 1]->m_index);
 	accel[m_nodeCount - 1].m_body = zero;
@@ -1180,6 +1679,150 @@ void dgSkeletonContainer::SolveAuxiliary(const dgJointInfo* const jointInfoArray
 	}
 }
 
+void dgSkeletonContainer::InitSparseMassMatrix(const dgJointInfo* const jointInfoArray)
+{
+	D_TRACKTIME();
+	m_auxiliaryMemoryBuffer.ResizeIfNecessary((m_rowCount * (2 * sizeof (dgInt32) + sizeof (dgNodePair)) + 1024) & -0x10);
+	m_frictionIndex = (dgInt32*)&m_auxiliaryMemoryBuffer[0];
+	m_matrixRowsIndex = (dgInt32*)&m_frictionIndex[m_rowCount];
+	m_pairs = (dgNodePair*)&m_matrixRowsIndex[m_rowCount];
+	InitAuxiliaryRows(jointInfoArray);
+
+	// all unbounded rows, primary and loops, go to the sparse factor, 
+	// the bounded rows are solved by an lcp on their dense schur complement
+	const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
+	const dgInt32 size = primaryCount + m_blockSize;
+	const dgInt32 boundedSize = m_auxiliaryRowCount - m_blockSize;
+
+	if (!m_sparseSolver) {
+		dgMemoryAllocator* const allocator = m_world->GetAllocator();
+		m_sparseSolver = new (allocator) dgSparseSolver(allocator);
+	}
+	dgSparseSolver* const solver = m_sparseSolver;
+	if (solver->Init(m_pairs, size)) {
+		m_symbolicBuildCount++;
+	} else {
+		m_symbolicReuseCount++;
+	}
+
+	dgFloat32* const diagDamp = dgAlloca(dgFloat32, size);
+	for (dgInt32 i = 0; i < size; i++) {
+		diagDamp[i] = m_rightHandSide[m_matrixRowsIndex[i]].m_diagDamp;
+	}
+	solver->Factorize(this, diagDamp);
+
+	if (boundedSize) {
+		solver->m_boundedMemory.ResizeIfNecessary(boundedSize * (2 * size + boundedSize) + 4);
+		solver->m_boundedMatrix10 = &solver->m_boundedMemory[0];
+		solver->m_boundedDeltaForce = &solver->m_boundedMatrix10[boundedSize * size];
+		solver->m_boundedMatrix11 = &solver->m_boundedDeltaForce[boundedSize * size];
+
+		dgFloat32* const boundedDamp = dgAlloca(dgFloat32, boundedSize);
+		for (dgInt32 i = 0; i < boundedSize; i++) {
+			const dgInt32 ii = size + i;
+			const dgLeftHandSide* const row_i = &m_leftHandSide[m_matrixRowsIndex[ii]];
+			const dgNodePair& pair_i = m_pairs[ii];
+			dgFloat32* const matrixRow10 = &solver->m_boundedMatrix10[i * size];
+			for (dgInt32 j = 0; j < size; j++) {
+				matrixRow10[j] = dgSparseSolver::AreCoupled(pair_i, m_pairs[j]) ? dgSparseSolver::CalculateRowCoupling(row_i, pair_i, &m_leftHandSide[m_matrixRowsIndex[j]], m_pairs[j]) : dgFloat32(0.0f);
+			}
+			dgFloat32* const deltaForce = &solver->m_boundedDeltaForce[i * size];
+			memcpy(deltaForce, matrixRow10, size * sizeof (dgFloat32));
+			solver->Solve(deltaForce);
+
+			// same regularizer than the dense loop matrix
+			dgFloat32* const matrixRow11 = &solver->m_boundedMatrix11[i * boundedSize];
+			const dgFloat32 damp = m_rightHandSide[m_matrixRowsIndex[ii]].m_diagDamp;
+			const dgFloat32 diagonal = dgSparseSolver::CalculateRowCoupling(row_i, pair_i, row_i, pair_i) + damp * dgFloat32(2.0f);
+			matrixRow11[i] = diagonal;
+			boundedDamp[i] = diagonal * (DG_PSD_DAMP_TOL * dgFloat32(4.0f));
+			for (dgInt32 j = i + 1; j < boundedSize; j++) {
+				const dgInt32 jj = size + j;
+				matrixRow11[j] = dgSparseSolver::AreCoupled(pair_i, m_pairs[jj]) ? dgSparseSolver::CalculateRowCoupling(row_i, pair_i, &m_leftHandSide[m_matrixRowsIndex[jj]], m_pairs[jj]) : dgFloat32(0.0f);
+			}
+		}
+
+		for (dgInt32 i = 0; i < boundedSize; i++) {
+			const dgFloat32* const matrixRow10 = &solver->m_boundedMatrix10[i * size];
+			dgFloat32* const matrixRow11 = &solver->m_boundedMatrix11[i * boundedSize];
+			for (dgInt32 j = i; j < boundedSize; j++) {
+				const dgFloat32 value = matrixRow11[j] - dgDotProduct(size, matrixRow10, &solver->m_boundedDeltaForce[j * size]);
+				matrixRow11[j] = value;
+				solver->m_boundedMatrix11[j * boundedSize + i] = value;
+			}
+			matrixRow11[i] = dgMax(matrixRow11[i], boundedDamp[i]);
+		}
+	}
+}
+
+void dgSkeletonContainer::SolveSparse(dgJacobian* const internalForces) const
+{
+	D_TRACKTIME();
+	const dgInt32 primaryCount = m_rowCount - m_auxiliaryRowCount;
+	const dgInt32 size = primaryCount + m_blockSize;
+	const dgInt32 boundedSize = m_auxiliaryRowCount - m_blockSize;
+	const dgSparseSolver* const solver = m_sparseSolver;
+
+	dgFloat32* const f = dgAlloca(dgFloat32, m_rowCount);
+	dgFloat32* const b = dgAlloca(dgFloat32, boundedSize + 1);
+	for (dgInt32 i = 0; i < m_rowCount; i++) {
+		const dgInt32 index = m_matrixRowsIndex[i];
+		const dgLeftHandSide* const row = &m_leftHandSide[index];
+		const dgRightHandSide* const rhs = &m_rightHandSide[index];
+		const dgJacobian& y0 = internalForces[m_pairs[i].m_m0];
+		const dgJacobian& y1 = internalForces[m_pairs[i].m_m1];
+		dgVector acc(row->m_JMinv.m_jacobianM0.m_linear * y0.m_linear + row->m_JMinv.m_jacobianM0.m_angular * y0.m_angular +
+					 row->m_JMinv.m_jacobianM1.m_linear * y1.m_linear + row->m_JMinv.m_jacobianM1.m_angular * y1.m_angular);
+		const dgFloat32 residual = rhs->m_coordenateAccel - acc.AddHorizontal().GetScalar();
+		if (i < size) {
+			f[i] = residual - rhs->m_force * rhs->m_diagDamp;
+		} else {
+			b[i - size] = residual;
+			f[i] = dgFloat32(0.0f);
+		}
+	}
+	solver->Solve(f);
+
+	if (boundedSize) {
+		dgFloat32* const u = dgAlloca(dgFloat32, boundedSize);
+		dgFloat32* const u0 = dgAlloca(dgFloat32, boundedSize);
+		dgFloat32* const low = dgAlloca(dgFloat32, boundedSize);
+		dgFloat32* const high = dgAlloca(dgFloat32, boundedSize);
+		dgInt32* const normalIndex = dgAlloca(dgInt32, boundedSize);
+		for (dgInt32 i = 0; i < boundedSize; i++) {
+			const dgRightHandSide* const rhs = &m_rightHandSide[m_matrixRowsIndex[size + i]];
+			b[i] -= dgDotProduct(size, &solver->m_boundedMatrix10[i * size], f);
+			normalIndex[i] = m_frictionIndex[size + i];
+			u0[i] = rhs->m_force;
+			low[i] = rhs->m_lowerBoundFrictionCoefficent;
+			high[i] = rhs->m_upperBoundFrictionCoefficent;
+		}
+
+		SolveLcp(boundedSize, boundedSize, solver->m_boundedMatrix11, u0, u, b, low, high, normalIndex);
+
+		for (dgInt32 i = 0; i < boundedSize; i++) {
+			const dgFloat32 s = u[i];
+			f[size + i] = s;
+			dgMulAdd(size, f, f, &solver->m_boundedDeltaForce[i * size], -s);
+		}
+	}
+
+	for (dgInt32 i = 0; i < m_rowCount; i++) {
+		const dgInt32 index = m_matrixRowsIndex[i];
+		dgRightHandSide* const rhs = &m_rightHandSide[index];
+		const dgLeftHandSide* const row = &m_leftHandSide[index];
+		const dgInt32 m0 = m_pairs[i].m_m0;
+		const dgInt32 m1 = m_pairs[i].m_m1;
+
+		rhs->m_force += f[i];
+		dgVector jointForce(f[i]);
+		internalForces[m0].m_linear += row->m_Jt.m_jacobianM0.m_linear * jointForce;
+		internalForces[m0].m_angular += row->m_Jt.m_jacobianM0.m_angular * jointForce;
+		internalForces[m1].m_linear += row->m_Jt.m_jacobianM1.m_linear * jointForce;
+		internalForces[m1].m_angular += row->m_Jt.m_jacobianM1.m_angular * jointForce;
+	}
+}
+
 dgInt8* dgSkeletonContainer::CalculateBufferSizeInBytes (const dgJointInfo* const jointInfoArray)
 {
 	dgInt32 rowCount = 0;
@@ -1216,7 +1859,6 @@ dgInt8* dgSkeletonContainer::CalculateBufferSizeInBytes (const dgJointInfo* cons
 void dgSkeletonContainer::InitMassMatrix(const dgJointInfo* const jointInfoArray, const dgLeftHandSide* const leftHandSide, dgRightHandSide* const rightHandSide)
 {
 	D_TRACKTIME();
-	dgInt32 rowCount = 0;
 	dgInt32 auxiliaryCount = 0;
 	m_leftHandSide = leftHandSide;
 	m_rightHandSide = rightHandSide;
@@ -1227,12 +1869,26 @@ void dgSkeletonContainer::InitMassMatrix(const dgJointInfo* const jointInfoArray
 	if (m_nodesOrder) {
 		for (dgInt32 i = 0; i < m_nodeCount - 1; i++) {
 			dgNode* const node = m_nodesOrder[i];
-			const dgJointInfo& info = jointInfoArray[node->m_joint->m_index];
-			rowCount += info.m_pairCount;
 			auxiliaryCount += node->Factorize(jointInfoArray, leftHandSide, rightHandSide, bodyMassArray, jointMassArray);
 		}
 		m_nodesOrder[m_nodeCount - 1]->Factorize(jointInfoArray, leftHandSide, rightHandSide, bodyMassArray, jointMassArray);
 	}
+	InitAuxiliaryMassMatrix(jointInfoArray, auxiliaryCount);
+}
+
+void dgSkeletonContainer::InitAuxiliaryMassMatrix(const dgJointInfo* const jointInfoArray, dgInt32 auxiliaryCount)
+{
+	dgInt32 rowCount = 0;
+	dgInt32 solverMode = m_tree;
+	if (m_nodesOrder) {
+		for (dgInt32 i = 0; i < m_nodeCount - 1; i++) {
+			dgNode* const node = m_nodesOrder[i];
+			rowCount += jointInfoArray[node->m_joint->m_index].m_pairCount;
+			solverMode |= node->m_body->m_skeletonSolverMode;
+		}
+		// the root has no joint, but its body can also request the sparse solver
+		solverMode |= m_nodesOrder[m_nodeCount - 1]->m_body->m_skeletonSolverMode;
+	}
 	m_rowCount = dgInt16 (rowCount);
 	m_auxiliaryRowCount = dgInt16 (auxiliaryCount);
 
@@ -1246,7 +1902,11 @@ void dgSkeletonContainer::InitMassMatrix(const dgJointInfo* const jointInfoArray
 	m_rowCount += m_loopRowCount;
 	m_auxiliaryRowCount += m_loopRowCount;
 
-	if (m_auxiliaryRowCount) {
+	// a skeleton without loops or bounded rows is already solved exactly in linear time
+	m_solverMode = m_auxiliaryRowCount ? dgInt16 (solverMode) : dgInt16 (m_tree);
+	if (m_solverMode == m_sparse) {
+		InitSparseMassMatrix(jointInfoArray);
+	} else if (m_auxiliaryRowCount) {
 		InitLoopMassMatrix(jointInfoArray);
 	}
 }
@@ -1254,6 +1914,11 @@ void dgSkeletonContainer::InitMassMatrix(const dgJointInfo* const jointInfoArray
 void dgSkeletonContainer::CalculateJointForce(dgJointInfo* const jointInfoArray, const dgBodyInfo* const bodyArray, dgJacobian* const internalForces)
 {
 	D_TRACKTIME();
+	if (m_solverMode == m_sparse) {
+		SolveSparse(internalForces);
+		return;
+	}
+
 	dgForcePair* const force = dgAlloca(dgForcePair, m_nodeCount);
 	dgForcePair* const accel = dgAlloca(dgForcePair, m_nodeCount);
 
@@ -1266,3 +1931,200 @@ void dgSkeletonContainer::CalculateJointForce(dgJointInfo* const jointInfoArray,
 	}
 }
 
+
+dgInt32 dgSkeletonContainer::InitParallelPartition(dgInt32 threadCount)
+{
+	if ((threadCount < 2) || (m_nodeCount < DG_SKELETON_PARALLEL_NODE_COUNT) || !m_nodesOrder) {
+		m_subtreeCount = 0;
+		m_partitionThreadCount = 0;
+		return 0;
+	}
+
+	if (m_partitionThreadCount == threadCount) {
+		return m_subtreeCount;
+	}
+	m_partitionThreadCount = dgInt16 (threadCount);
+
+	const dgInt32 matrixSize = (m_nodeCount * sizeof (dgSpatialMatrix) + 63) & -64;
+	const dgInt32 forceSize = (m_nodeCount * sizeof (dgForcePair) + 63) & -64;
+	const dgInt32 subtreeSize = (m_nodeCount * sizeof (dgSubtree) + 63) & -64;
+	const dgInt32 trunkSize = (m_nodeCount * sizeof (dgInt16) + 63) & -64;
+	m_parallelMemoryBuffer.ResizeIfNecessary(2 * matrixSize + 2 * forceSize + subtreeSize + trunkSize);
+
+	dgInt8* const memory = &m_parallelMemoryBuffer[0];
+	m_bodyMassArray = (dgSpatialMatrix*)memory;
+	m_jointMassArray = (dgSpatialMatrix*)&memory[matrixSize];
+	m_forceArray = (dgForcePair*)&memory[2 * matrixSize];
+	m_accelArray = (dgForcePair*)&memory[2 * matrixSize + forceSize];
+	m_subtrees = (dgSubtree*)&memory[2 * matrixSize + 2 * forceSize];
+	m_trunkNodes = (dgInt16*)&memory[2 * matrixSize + 2 * forceSize + subtreeSize];
+
+	// nodes are sorted in post order, so the descendants of a node are the range just below it
+	dgInt32* const subtreeSizes = dgAlloca(dgInt32, m_nodeCount);
+	for (dgInt32 i = 0; i < m_nodeCount; i++) {
+		dgInt32 size = 1;
+		for (dgNode* child = m_nodesOrder[i]->m_child; child; child = child->m_sibling) {
+			size += subtreeSizes[child->m_index];
+		}
+		subtreeSizes[i] = size;
+	}
+
+	// descend from the root until the branches are small enough to be a single work item
+	const dgInt32 maxSubtreeSize = dgMax(DG_SKELETON_PARALLEL_MIN_SUBTREE, m_nodeCount / (2 * threadCount));
+	dgInt8* const isTrunk = dgAlloca(dgInt8, m_nodeCount);
+	memset(isTrunk, 0, m_nodeCount * sizeof (dgInt8));
+
+	dgInt32 stack = 1;
+	dgNode** const stackPool = dgAlloca(dgNode*, m_nodeCount);
+	stackPool[0] = m_skeleton;
+	while (stack) {
+		stack--;
+		dgNode* const node = stackPool[stack];
+		if (subtreeSizes[node->m_index] > maxSubtreeSize) {
+			isTrunk[node->m_index] = 1;
+			for (dgNode* child = node->m_child; child; child = child->m_sibling) {
+				stackPool[stack] = child;
+				stack++;
+			}
+		}
+	}
+	dgAssert(isTrunk[m_nodeCount - 1]);
+
+	// sibling branches are contiguous, merge them into work items of about the same size
+	m_trunkCount = 0;
+	m_subtreeCount = 0;
+	dgInt32 start = -1;
+	for (dgInt32 i = 0; i < m_nodeCount - 1; i++) {
+		if (isTrunk[i]) {
+			if (start >= 0) {
+				m_subtrees[m_subtreeCount].m_start = dgInt16 (start);
+				m_subtrees[m_subtreeCount].m_end = dgInt16 (i - 1);
+				m_subtreeCount++;
+				start = -1;
+			}
+			m_trunkNodes[m_trunkCount] = dgInt16 (i);
+			m_trunkCount++;
+		} else {
+			if (start < 0) {
+				start = i;
+			}
+			const dgNode* const parent = m_nodesOrder[i]->m_parent;
+			if (isTrunk[parent->m_index]) {
+				const dgInt32 first = i - subtreeSizes[i] + 1;
+				if ((first > start) && ((i - start + 1) > maxSubtreeSize)) {
+					m_subtrees[m_subtreeCount].m_start = dgInt16 (start);
+					m_subtrees[m_subtreeCount].m_end = dgInt16 (first - 1);
+					m_subtreeCount++;
+					start = first;
+				}
+			}
+		}
+	}
+	dgAssert(start < 0);
+
+	if (m_subtreeCount < 2) {
+		m_subtreeCount = 0;
+	}
+	return m_subtreeCount;
+}
+
+void dgSkeletonContainer::InitSubtreeMassMatrix(const dgJointInfo* const jointInfoArray, const dgLeftHandSide* const leftHandSide, dgRightHandSide* const rightHandSide, dgInt32 index)
+{
+	D_TRACKTIME();
+	dgSubtree& subtree = m_subtrees[index];
+	dgInt32 auxiliaryCount = 0;
+	for (dgInt32 i = subtree.m_start; i <= subtree.m_end; i++) {
+		auxiliaryCount += m_nodesOrder[i]->Factorize(jointInfoArray, leftHandSide, rightHandSide, m_bodyMassArray, m_jointMassArray);
+	}
+	subtree.m_auxiliaryRowCount = auxiliaryCount;
+}
+
+void dgSkeletonContainer::InitTrunkMassMatrix(const dgJointInfo* const jointInfoArray, const dgLeftHandSide* const leftHandSide, dgRightHandSide* const rightHandSide)
+{
+	D_TRACKTIME();
+	m_leftHandSide = leftHandSide;
+	m_rightHandSide = rightHandSide;
+
+	dgInt32 auxiliaryCount = 0;
+	for (dgInt32 i = 0; i < m_subtreeCount; i++) {
+		auxiliaryCount += m_subtrees[i].m_auxiliaryRowCount;
+	}
+	for (dgInt32 i = 0; i < m_trunkCount; i++) {
+		dgNode* const node = m_nodesOrder[m_trunkNodes[i]];
+		auxiliaryCount += node->Factorize(jointInfoArray, leftHandSide, rightHandSide, m_bodyMassArray, m_jointMassArray);
+	}
+	m_nodesOrder[m_nodeCount - 1]->Factorize(jointInfoArray, leftHandSide, rightHandSide, m_bodyMassArray, m_jointMassArray);
+	InitAuxiliaryMassMatrix(jointInfoArray, auxiliaryCount);
+}
+
+void dgSkeletonContainer::SolveSubtreeForward(dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgInt32 index) const
+{
+	D_TRACKTIME();
+	const dgSubtree& subtree = m_subtrees[index];
+	for (dgInt32 i = subtree.m_start; i <= subtree.m_end; i++) {
+		CalculateNodeAccel(jointInfoArray, internalForces, m_accelArray, i);
+		SolveNodeForward(m_forceArray, m_accelArray, i);
+	}
+}
+
+void dgSkeletonContainer::SolveTrunk(dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces) const
+{
+	D_TRACKTIME();
+	dgForcePair* const force = m_forceArray;
+	dgForcePair* const accel = m_accelArray;
+	for (dgInt32 i = 0; i < m_trunkCount; i++) {
+		const dgInt32 index = m_trunkNodes[i];
+		CalculateNodeAccel(jointInfoArray, internalForces, accel, index);
+		SolveNodeForward(force, accel, index);
+	}
+
+	dgNode* const root = m_nodesOrder[m_nodeCount - 1];
+	accel[m_nodeCount - 1].m_body = dgSpatialVector::m_zero;
+	accel[m_nodeCount - 1].m_joint = dgSpatialVector::m_zero;
+	force[m_nodeCount - 1] = accel[m_nodeCount - 1];
+	for (dgNode* child = root->m_child; child; child = child->m_sibling) {
+		child->BodyJacobianTimeMassForward(force[child->m_index], force[m_nodeCount - 1]);
+	}
+
+	for (dgInt32 i = 0; i < m_trunkCount; i++) {
+		const dgInt32 index = m_trunkNodes[i];
+		dgNode* const node = m_nodesOrder[index];
+		node->BodyDiagInvTimeSolution(force[index]);
+		node->JointDiagInvTimeSolution(force[index]);
+	}
+	root->BodyDiagInvTimeSolution(force[m_nodeCount - 1]);
+
+	for (dgInt32 i = m_trunkCount - 1; i >= 0; i--) {
+		const dgInt32 index = m_trunkNodes[i];
+		dgNode* const node = m_nodesOrder[index];
+		node->JointJacobianTimeSolutionBackward(force[index], force[node->m_parent->m_index]);
+		node->BodyJacobianTimeSolutionBackward(force[index]);
+	}
+}
+
+void dgSkeletonContainer::SolveSubtreeBackward(dgInt32 index) const
+{
+	D_TRACKTIME();
+	dgForcePair* const force = m_forceArray;
+	const dgSubtree& subtree = m_subtrees[index];
+	for (dgInt32 i = subtree.m_start; i <= subtree.m_end; i++) {
+		dgNode* const node = m_nodesOrder[i];
+		node->BodyDiagInvTimeSolution(force[i]);
+		node->JointDiagInvTimeSolution(force[i]);
+	}
+	for (dgInt32 i = subtree.m_end; i >= subtree.m_start; i--) {
+		dgNode* const node = m_nodesOrder[i];
+		node->JointJacobianTimeSolutionBackward(force[i], force[node->m_parent->m_index]);
+		node->BodyJacobianTimeSolutionBackward(force[i]);
+	}
+}
+
+void dgSkeletonContainer::UpdateSubtreeForces(dgJointInfo* const jointInfoArray, dgJacobian* const internalForces) const
+{
+	D_TRACKTIME();
+	if (m_auxiliaryRowCount) {
+		SolveAuxiliary(jointInfoArray, internalForces, m_accelArray, m_forceArray);
+	} else {
+		UpdateForces(jointInfoArray, internalForces, m_forceArray);
+	}
+}
@@ -26,6 +26,10 @@
 #include "dgContact.h"
 #include "dgBilateralConstraint.h"
 
+#define DG_SKELETON_SUPERNODE_MAX_ROWS		12
+#define DG_SKELETON_PARALLEL_NODE_COUNT		32
+#define DG_SKELETON_PARALLEL_MIN_SUBTREE	8
+
 class dgDynamicBody;
 
 class dgSkeletonContainer
@@ -36,6 +40,15 @@ class dgSkeletonContainer
 	class dgForcePair;
 	class dgMatriData;
 	class dgBodyJointMatrixDataPair;
+	class dgSparseSolver;
+	class dgSubtree;
+	class dgLoopLayout;
+
+	enum dgSolverMode
+	{
+		m_tree,
+		m_sparse,
+	};
 
 	DG_CLASS_ALLOCATOR(allocator)
 	dgSkeletonContainer(dgWorld* const world, dgDynamicBody* const rootBody);
@@ -57,6 +70,8 @@ class dgSkeletonContainer
 	void ClearSelfCollision();
 	void AddSelfCollisionJoint(dgConstraint* const joint);
 
+	dgInt32 GetSolverMode() const { return m_solverMode; }
+	void GetFactorizationStats(dgInt32& reuseCount, dgInt32& buildCount) const { reuseCount = m_symbolicReuseCount; buildCount = m_symbolicBuildCount; }
 	dgInt32 GetLru() const { return m_lru; }
 	void SetLru(dgInt32 lru) { m_lru = lru; }
 
@@ -71,17 +86,31 @@ class dgSkeletonContainer
 	DG_INLINE void SolveForward(dgForcePair* const force, const dgForcePair* const accel, dgInt32 startNode = 0) const;
 	DG_INLINE void UpdateForces(dgJointInfo* const jointInfoArray, dgJacobian* const internalForces, const dgForcePair* const force) const;
 	DG_INLINE void CalculateJointAccel (dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgForcePair* const accel) const;
+	DG_INLINE void CalculateNodeAccel (const dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgForcePair* const accel, dgInt32 index) const;
+	DG_INLINE void SolveNodeForward (dgForcePair* const force, const dgForcePair* const accel, dgInt32 index) const;
 
 	dgNode* FindNode(dgDynamicBody* const node) const;
 	void SortGraph(dgNode* const root, dgInt32& index);
 		
 	void InitLoopMassMatrix (const dgJointInfo* const jointInfoArray);
+	void InitAuxiliaryMassMatrix (const dgJointInfo* const jointInfoArray, dgInt32 auxiliaryCount);
+	void InitAuxiliaryRows (const dgJointInfo* const jointInfoArray);
+	void InitSparseMassMatrix (const dgJointInfo* const jointInfoArray);
+	void SolveSparse (dgJacobian* const internalForces) const;
 	dgInt8* CalculateBufferSizeInBytes (const dgJointInfo* const jointInfoArray);
 	void SolveAuxiliary (const dgJointInfo* const jointInfoArray, dgJacobian* const internalForces, const dgForcePair* const accel, dgForcePair* const force) const;
 	void SolveLcp(dgInt32 stride, dgInt32 size, const dgFloat32* const matrix, const dgFloat32* const x0, dgFloat32* const x, const dgFloat32* const b, const dgFloat32* const low, const dgFloat32* const high, const dgInt32* const normalIndex) const;
 	void SolveBlockLcp(dgInt32 size, dgInt32 blockSize, const dgFloat32* const x0, dgFloat32* const x, dgFloat32* const b, const dgFloat32* const low, const dgFloat32* const high, const dgInt32* const normalIndex) const;
 	void FactorizeMatrix(dgInt32 size, dgInt32 stride, dgFloat32* const matrix, dgFloat32* const diagDamp) const;
 
+	dgInt32 InitParallelPartition (dgInt32 threadCount);
+	void InitSubtreeMassMatrix (const dgJointInfo* const jointInfoArray, const dgLeftHandSide* const leftHandSide, dgRightHandSide* const rightHandSide, dgInt32 subtree);
+	void InitTrunkMassMatrix (const dgJointInfo* const jointInfoArray, const dgLeftHandSide* const leftHandSide, dgRightHandSide* const rightHandSide);
+	void SolveSubtreeForward (dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces, dgInt32 subtree) const;
+	void SolveTrunk (dgJointInfo* const jointInfoArray, const dgJacobian* const internalForces) const;
+	void SolveSubtreeBackward (dgInt32 subtree) const;
+	void UpdateSubtreeForces (dgJointInfo* const jointInfoArray, dgJacobian* const internalForces) const;
+
 	dgWorld* m_world;
 	dgNode* m_skeleton;
 	dgNode** m_nodesOrder;
@@ -95,16 +124,31 @@ class dgSkeletonContainer
 	dgInt32* m_frictionIndex;
 	dgInt32* m_matrixRowsIndex;
 	dgSkeletonList::dgListNode* m_listNode;
+	dgSparseSolver* m_sparseSolver;
+	dgLoopLayout* m_loopLayout;
+	dgSubtree* m_subtrees;
+	dgInt16* m_trunkNodes;
+	dgSpatialMatrix* m_bodyMassArray;
+	dgSpatialMatrix* m_jointMassArray;
+	dgForcePair* m_forceArray;
+	dgForcePair* m_accelArray;
 	dgArray<dgConstraint*> m_loopingJoints;
 	dgArray<dgInt8> m_auxiliaryMemoryBuffer;
+	dgArray<dgInt8> m_parallelMemoryBuffer;
 	dgInt32 m_lru;
 	dgInt32 m_blockSize;
+	dgInt32 m_symbolicReuseCount;
+	dgInt32 m_symbolicBuildCount;
 	dgInt16 m_nodeCount;
 	dgInt16 m_loopCount;
 	dgInt16 m_dynamicsLoopCount;
 	dgInt16 m_rowCount;
 	dgInt16 m_loopRowCount;
 	dgInt16 m_auxiliaryRowCount;
+	dgInt16 m_solverMode;
+	dgInt16 m_subtreeCount;
+	dgInt16 m_trunkCount;
+	dgInt16 m_partitionThreadCount;
 
 	friend class dgWorld;
 	friend class dgParallelBodySolver;
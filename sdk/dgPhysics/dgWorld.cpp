@@ -229,6 +229,7 @@ dgWorld::dgWorld(dgMemoryAllocator* const allocator)
 	,m_onPostUpdateCallback(NULL)
 	,m_listeners(allocator)
 	,m_perInstanceData(allocator)
+	,m_meshScratchPool(allocator)
 	,m_bodiesMemory (allocator, 64)
 	,m_jointsMemory (allocator, 64)
 	,m_clusterMemory (allocator, 64)
@@ -256,6 +257,7 @@ dgWorld::dgWorld(dgMemoryAllocator* const allocator)
 
 	m_onCollisionInstanceDestruction = NULL;
 	m_onCollisionInstanceCopyConstrutor = NULL;
+	m_onCollisionLodSelect = NULL;
 
 	m_onSerializeJointCallback = NULL;	
 	m_onDeserializeJointCallback = NULL;	
@@ -267,10 +269,13 @@ dgWorld::dgWorld(dgMemoryAllocator* const allocator)
 	m_defualtBodyGroupID = CreateBodyGroupID();
 	m_genericLRUMark = 0;
 	m_clusterLRU = 0;
+	m_sharedShapeCache = false;
+	m_lightweightSubsteps = false;
 
 	m_useParallelSolver = 1;
 
 	m_solverIterations = DG_DEFAULT_SOLVER_ITERATION_COUNT;
+	m_solverMaxIterations = 0;
 	m_dynamicsLru = 0;
 	m_numberOfSubsteps = 1;
 		
@@ -898,7 +903,13 @@ void dgWorld::FlushCache()
 	SortMasterList();
 }
 
-void dgWorld::StepDynamics (dgFloat32 timestep)
+void dgWorld::ShiftOrigin(const dgVector& offset)
+{
+	dgAssert(m_inUpdate == 0);
+	m_broadPhase->ShiftOrigin(offset);
+}
+
+void dgWorld::StepDynamics (dgFloat32 timestep, bool reuseContacts)
 {
 	//SerializeToFile ("xxx.bin");
 
@@ -909,7 +920,11 @@ void dgWorld::StepDynamics (dgFloat32 timestep)
 
 	D_TRACKTIME();
 	UpdateSkeletons();
-	UpdateBroadphase(timestep);
+	if (reuseContacts) {
+		m_broadPhase->UpdateSubstepContacts(timestep);
+	} else {
+		UpdateBroadphase(timestep);
+	}
 	UpdateDynamics (timestep);
 
 	if (m_listeners.GetCount()) {
@@ -969,7 +984,7 @@ void dgWorld::RunStep ()
 
 	dgFloat32 step = m_savetimestep / m_numberOfSubsteps;
 	for (dgUnsigned32 i = 0; i < m_numberOfSubsteps; i ++) {
-		StepDynamics (step);
+		StepDynamics (step, i && m_lightweightSubsteps);
 
 		dgDeadBodies& bodyList = *this;
 		dgDeadJoints& jointList = *this;
@@ -1041,6 +1056,11 @@ void dgWorld::SetCollisionInstanceConstructorDestructor (OnCollisionInstanceDupl
 	m_onCollisionInstanceCopyConstrutor = constructor;
 }
 
+void dgWorld::SetCollisionLodCallback (OnCollisionLodSelect callback)
+{
+	m_onCollisionLodSelect = callback;
+}
+
 dgInt32 dgWorld::GetBroadPhaseType() const
 {
 	return dgInt32 (m_broadPhase->GetType());
@@ -1143,6 +1163,51 @@ void dgWorld::DestroyInverseDynamics(dgInverseDynamics* const inverseDynamics)
 	delete inverseDynamics;
 }
 
+class dgInverseDynamicsSyncDescriptor
+{
+	public:
+	dgWorld* m_world;
+	dgFloat32 m_timestep;
+};
+
+void dgWorld::UpdateInverseDynamics(dgInverseDynamicsList::dgListNode* node, dgFloat32 timestep, dgInt32 threadID)
+{
+	const dgInt32 threadsCount = GetThreadCount();
+	while (node) {
+		node->GetInfo()->Update(timestep, threadID);
+		for (dgInt32 i = 0; i < threadsCount; i++) {
+			node = node ? node->GetNext() : NULL;
+		}
+	}
+}
+
+void dgWorld::UpdateInverseDynamicsKernel(void* const context, void* const nodePtr, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgInverseDynamicsSyncDescriptor* const descriptor = (dgInverseDynamicsSyncDescriptor*)context;
+	dgInverseDynamicsList::dgListNode* const node = (dgInverseDynamicsList::dgListNode*) nodePtr;
+	descriptor->m_world->UpdateInverseDynamics(node, descriptor->m_timestep, threadID);
+}
+
+void dgWorld::UpdateInverseDynamics(dgFloat32 timestep)
+{
+	D_TRACKTIME();
+	// rigs do not share joints, so each one is solved by a single thread
+	dgAssert(m_inUpdate == 0);
+	dgInverseDynamicsSyncDescriptor descriptor;
+	descriptor.m_world = this;
+	descriptor.m_timestep = timestep;
+
+	const dgInverseDynamicsList& ikList = *this;
+	dgInverseDynamicsList::dgListNode* node = ikList.GetFirst();
+	const dgInt32 threadsCount = GetThreadCount();
+	for (dgInt32 i = 0; i < threadsCount; i++) {
+		QueueJob(UpdateInverseDynamicsKernel, &descriptor, node, "dgWorld::UpdateInverseDynamics");
+		node = node ? node->GetNext() : NULL;
+	}
+	SynchronizationBarrier();
+}
+
 dgDeadJoints::dgDeadJoints(dgMemoryAllocator* const allocator)
 	:dgTree<dgConstraint*, void* >(allocator)
 	,m_lock(0)
@@ -26,8 +26,11 @@
 #include "dgContact.h"
 #include "dgCollision.h"
 #include "dgBroadPhase.h"
+#include "dgCollisionMesh.h"
 #include "dgWorldPlugins.h"
 #include "dgCollisionScene.h"
+#include "dgCollisionShapeCache.h"
+#include "dgCollisionHeightField.h"
 #include "dgBodyMasterList.h"
 #include "dgWorldDynamicUpdate.h"
 #include "dgBilateralConstraint.h"
@@ -178,6 +181,7 @@ class dgWorld
 	typedef void (dgApi *OnBodyDeserialize) (dgBody& me, void* const userData, dgDeserialize funt, void* const serilalizeObject);
 	typedef void (dgApi *OnCollisionInstanceDestroy) (const dgWorld* const world, const dgCollisionInstance* const collision);
 	typedef void (dgApi *OnCollisionInstanceDuplicate) (const dgWorld* const world, dgCollisionInstance* const collision, const dgCollisionInstance* const sourceCollision);
+	typedef dgInt32 (dgApi *OnCollisionLodSelect) (const dgBody* const body, const dgCollisionInstance* const collision, dgInt32 lodCount, dgInt32 threadIndex);
 
 	typedef void (dgApi *OnJointSerializationCallback) (const dgUserConstraint* const joint, dgSerialize funt, void* const serilalizeObject);
 	typedef void (dgApi *OnJointDeserializationCallback) (const dgBody* const body0, const dgBody* const body1, dgDeserialize funt, void* const serilalizeObject);
@@ -244,6 +248,10 @@ class dgWorld
 
 	dgInt32 GetSolverIterations() const;
 	void SetSolverIterations (dgInt32 mode);
+	dgInt32 GetSolverMaxIterations() const;
+	void SetSolverMaxIterations (dgInt32 maxIterations);
+	dgInt32 GetSolverIslandCount() const;
+	const dgBodyCluster* GetSolverIsland(dgInt32 index) const;
 
 	OnPostUpdateCallback GetPostUpdateCallback() const;
 	void SetPostUpdateCallback (OnPostUpdateCallback callback);
@@ -252,6 +260,7 @@ class dgWorld
 	dgInt32 GetParallelSolverOnLargeIsland() const;
 
 	void FlushCache();
+	void ShiftOrigin(const dgVector& offset);
 
 	virtual dgUnsigned64 GetTimeInMicrosenconds() const;
 	
@@ -260,7 +269,7 @@ class dgWorld
 
 	void Update (dgFloat32 timestep);
 	void UpdateAsync (dgFloat32 timestep);
-	void StepDynamics (dgFloat32 timestep);
+	void StepDynamics (dgFloat32 timestep, bool reuseContacts = false);
 	
 	dgInt32 Collide (const dgCollisionInstance* const collisionA, const dgMatrix& matrixA, 
 					 const dgCollisionInstance* const collisionB, const dgMatrix& matrixB, 
@@ -340,8 +349,10 @@ class dgWorld
 	dgCollisionInstance* CreateMassSpringDamperSystem (dgInt32 shapeID, dgInt32 pointCount, const dgFloat32* const points, dgInt32 srideInBytes, const dgFloat32* const pointsMass, dgInt32 linksCount, const dgInt32* const links, const dgFloat32* const linksSpring, const dgFloat32* const LinksDamper);
 
 	dgCollisionInstance* CreateBVH ();	
+	dgCollisionInstance* CreateBVHFromImage (const void* const image, dgInt32 sizeInBytes);	
 	dgCollisionInstance* CreateStaticUserMesh (const dgVector& boxP0, const dgVector& boxP1, const dgUserMeshCreation& data);
 	dgCollisionInstance* CreateHeightField (dgInt32 width, dgInt32 height, dgInt32 contructionMode, dgInt32 elevationDataType, const void* const elevationMap, const dgInt8* const atributeMap, dgFloat32 verticalScale, dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z);
+	dgCollisionInstance* CreatePagedHeightField (dgInt32 width, dgInt32 height, dgInt32 contructionMode, dgInt32 elevationDataType, dgFloat32 minElevation, dgFloat32 maxElevation, dgFloat32 verticalScale, dgFloat32 horizontalScale_x, dgFloat32 horizontalScale_z, dgCollisionHeightFieldPageProvider pageProvider, void* const providerUserData, dgInt32 memoryBudgetInBytes);
 	dgCollisionInstance* CreateScene ();	
 
 	dgBroadPhaseAggregate* CreateAggreGate() const; 
@@ -349,8 +360,10 @@ class dgWorld
 
 	dgInverseDynamics* CreateInverseDynamics();
 	void DestroyInverseDynamics(dgInverseDynamics* const inverseDynamics);
+	void UpdateInverseDynamics(dgFloat32 timestep);
 
 	void SetCollisionInstanceConstructorDestructor (OnCollisionInstanceDuplicate constructor, OnCollisionInstanceDestroy destructor);
+	void SetCollisionLodCallback (OnCollisionLodSelect callback);
 
 	static void OnDeserializeFromFile(void* const userData, void* const buffer, dgInt32 size);
 	static void OnSerializeToFile(void* const userData, const void* const buffer, dgInt32 size);
@@ -373,7 +386,13 @@ class dgWorld
 
 	void SerializeCollision (dgCollisionInstance* const shape, dgSerialize deserialization, void* const userData) const;
 	dgCollisionInstance* CreateCollisionFromSerialization (dgDeserialize deserialization, void* const userData);
+	dgInt32 CreateCollisionLod (dgCollisionInstance* const instance, dgCollisionInstance::dgLodType type, dgInt32 maxVertexCount);
 	void ReleaseCollision(const dgCollision* const collision);
+
+	bool GetSharedShapeCache() const;
+	void SetSharedShapeCache(bool state);
+	void ShareCollisionShape (dgCollisionInstance* const instance);
+	dgMemoryAllocator* GetShapeAllocator(dgCollisionID id) const;
 	
 	dgUpVectorConstraint* CreateUpVectorConstraint (const dgVector& pin, dgBody *body);
 	
@@ -421,6 +440,10 @@ class dgWorld
 
 	void SetSubsteps (dgInt32 subSteps);
 	dgInt32 GetSubsteps () const;
+	void SetLightweightSubsteps (bool state);
+	bool GetLightweightSubsteps () const;
+
+	dgPolygonMeshScratchPool& GetMeshScratchPool();
 	
 	private:
 	class dgAdressDistPair
@@ -476,22 +499,31 @@ class dgWorld
 	virtual void Execute (dgInt32 threadID);
 	virtual void TickCallback (dgInt32 threadID);
 	void UpdateTransforms(dgBodyMasterList::dgListNode* node, dgInt32 threadID);
+	void UpdateInverseDynamics(dgInverseDynamicsList::dgListNode* node, dgFloat32 timestep, dgInt32 threadID);
 
 	static dgUnsigned32 dgApi GetPerformanceCount ();
 	static void UpdateTransforms(void* const context, void* const node, dgInt32 threadID);
+	static void UpdateInverseDynamicsKernel(void* const context, void* const node, dgInt32 threadID);
 	static dgInt32 SortFaces (const dgAdressDistPair* const A, const dgAdressDistPair* const B, void* const context);
 	static dgInt32 CompareJointByInvMass (const dgBilateralConstraint* const jointA, const dgBilateralConstraint* const jointB, void* notUsed);
 
+	const dgCollision* FindCachedShape (dgUnsigned32 signature, dgCollisionID id);
+	const dgCollision* AddCachedShape (const dgCollision* const shape);
+	dgCollisionInstance* CreateCachedInstance (const dgCollision* const shape, dgInt32 shapeID, const dgMatrix& offsetMatrix);
+
 	dgUnsigned32 m_numberOfSubsteps;
 	dgUnsigned32 m_dynamicsLru;
 	dgUnsigned32 m_inUpdate;
 	dgUnsigned32 m_solverIterations;
+	dgUnsigned32 m_solverMaxIterations;
 	dgUnsigned32 m_bodyGroupID;
 	dgUnsigned32 m_defualtBodyGroupID;
 	dgUnsigned32 m_bodiesUniqueID;
 	dgUnsigned32 m_useParallelSolver;
 	dgUnsigned32 m_genericLRUMark;
 	dgInt32 m_clusterLRU;
+	bool m_sharedShapeCache;
+	bool m_lightweightSubsteps;
 
 	dgFloat32 m_freezeAccel2;
 	dgFloat32 m_freezeAlpha2;
@@ -517,12 +549,14 @@ class dgWorld
 	OnDestroyContact m_onDestroyContact;
 	OnCollisionInstanceDestroy	m_onCollisionInstanceDestruction;
 	OnCollisionInstanceDuplicate m_onCollisionInstanceCopyConstrutor;
+	OnCollisionLodSelect m_onCollisionLodSelect;
 	OnJointSerializationCallback m_onSerializeJointCallback;	
 	OnJointDeserializationCallback m_onDeserializeJointCallback;	
 	OnPostUpdateCallback m_onPostUpdateCallback;
 
 	dgListenerList m_listeners;
 	dgTree<void*, unsigned> m_perInstanceData;
+	dgPolygonMeshScratchPool m_meshScratchPool;
 	dgArray<dgBodyInfo> m_bodiesMemory; 
 	dgArray<dgJointInfo> m_jointsMemory; 
 	dgArray<dgBodyCluster> m_clusterMemory;
@@ -579,6 +613,21 @@ inline dgMemoryAllocator* dgWorld::GetAllocator() const
 	return m_allocator;
 }
 
+inline bool dgWorld::GetSharedShapeCache() const
+{
+	return m_sharedShapeCache;
+}
+
+inline void dgWorld::SetSharedShapeCache(bool state)
+{
+	m_sharedShapeCache = state;
+}
+
+inline dgMemoryAllocator* dgWorld::GetShapeAllocator(dgCollisionID id) const
+{
+	return (m_sharedShapeCache && dgCollisionShapeCache::IsCacheable(id)) ? dgCollisionShapeCache::GetCache().GetAllocator() : m_allocator;
+}
+
 inline dgBroadPhase* dgWorld::GetBroadPhase() const
 {
 	return m_broadPhase;
@@ -594,6 +643,21 @@ inline dgInt32 dgWorld::GetSubsteps () const
 	return m_numberOfSubsteps;
 }
 
+inline void dgWorld::SetLightweightSubsteps (bool state)
+{
+	m_lightweightSubsteps = state;
+}
+
+inline bool dgWorld::GetLightweightSubsteps () const
+{
+	return m_lightweightSubsteps;
+}
+
+inline dgPolygonMeshScratchPool& dgWorld::GetMeshScratchPool()
+{
+	return m_meshScratchPool;
+}
+
 inline dgFloat32 dgWorld::GetUpdateTime() const
 {
 	return m_lastExecutionTime;
@@ -624,6 +688,26 @@ inline dgInt32 dgWorld::GetSolverIterations() const
 	return m_solverIterations;
 }
 
+inline void dgWorld::SetSolverMaxIterations(dgInt32 maxIterations)
+{
+	m_solverMaxIterations = dgUnsigned32(dgMax(0, maxIterations));
+}
+
+inline dgInt32 dgWorld::GetSolverMaxIterations() const
+{
+	return dgMax(m_solverIterations, m_solverMaxIterations);
+}
+
+inline dgInt32 dgWorld::GetSolverIslandCount() const
+{
+	return m_inUpdate ? 0 : m_clusters;
+}
+
+inline const dgBodyCluster* dgWorld::GetSolverIsland(dgInt32 index) const
+{
+	return ((index >= 0) && (index < GetSolverIslandCount())) ? &m_clusterMemory[index] : NULL;
+}
+
 DG_INLINE dgBody* dgWorld::FindRoot(dgBody* const body) const
 {
 	dgBody* node = body;
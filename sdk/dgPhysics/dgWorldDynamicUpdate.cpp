@@ -50,6 +50,14 @@ class dgWorldDynamicUpdateSyncDescriptor
 	dgInt32 m_firstCluster;
 };
 
+class dgUnionFindSyncDescriptor
+{
+	public:
+	dgJointInfo* m_jointArray;
+	dgInt32 m_jointCount;
+	dgInt32 m_atomicCounter;
+};
+
 
 void dgJacobianMemory::Init(dgWorld* const world, dgInt32 rowsCount, dgInt32 bodyCount)
 {
@@ -216,29 +224,33 @@ void dgWorldDynamicUpdate::BuildClusters(dgFloat32 timestep)
 	}
 
 	// form all disjoints sets
-	for (dgInt32 i = 0; i < jointCount; i ++) {
-		const dgConstraint* const joint = baseJointArray[i].m_joint;
-		dgBody* const body0 = joint->GetBody0();
-		dgBody* const body1 = joint->GetBody1(); 
-		const dgFloat32 invMass0 = body0->m_invMass.m_w;
-		const dgFloat32 invMass1 = body1->m_invMass.m_w;
-
-		dgInt32 resting = body0->m_equilibrium & body1->m_equilibrium;
-		body0->m_resting = resting | (invMass0 == dgFloat32(0.0f));
-		body1->m_resting = resting | (invMass1 == dgFloat32(0.0f));
-
-		if ((invMass0 > dgFloat32 (0.0f)) && (invMass1 > dgFloat32 (0.0f))) {
-			//dgAssert (body0->IsRTTIType(dgBody::m_dynamicBodyRTTI | dgBody::m_dynamicBodyAsymatric));
-			//dgAssert (body1->IsRTTIType(dgBody::m_dynamicBodyRTTI | dgBody::m_dynamicBodyAsymatric));
-			world->UnionSet(joint);
-		} else if (invMass1 == dgFloat32 (0.0f)) {
-			dgBody* const root = world->FindRootAndSplit(body0);
-			root->m_disjointInfo.m_jointCount += 1;
-			root->m_disjointInfo.m_rowCount += joint->m_maxDOF;
-		} else {
-			dgBody* const root = world->FindRootAndSplit(body1);
-			root->m_disjointInfo.m_jointCount += 1;
-			root->m_disjointInfo.m_rowCount += joint->m_maxDOF;
+	if ((world->GetThreadCount() > 1) && (jointCount >= DG_PARALLEL_UNION_FIND_CUT_OFF)) {
+		UnionSetsParallel(baseJointArray, jointCount);
+	} else {
+		for (dgInt32 i = 0; i < jointCount; i ++) {
+			const dgConstraint* const joint = baseJointArray[i].m_joint;
+			dgBody* const body0 = joint->GetBody0();
+			dgBody* const body1 = joint->GetBody1(); 
+			const dgFloat32 invMass0 = body0->m_invMass.m_w;
+			const dgFloat32 invMass1 = body1->m_invMass.m_w;
+
+			dgInt32 resting = body0->m_equilibrium & body1->m_equilibrium;
+			body0->m_resting = resting | (invMass0 == dgFloat32(0.0f));
+			body1->m_resting = resting | (invMass1 == dgFloat32(0.0f));
+
+			if ((invMass0 > dgFloat32 (0.0f)) && (invMass1 > dgFloat32 (0.0f))) {
+				//dgAssert (body0->IsRTTIType(dgBody::m_dynamicBodyRTTI | dgBody::m_dynamicBodyAsymatric));
+				//dgAssert (body1->IsRTTIType(dgBody::m_dynamicBodyRTTI | dgBody::m_dynamicBodyAsymatric));
+				world->UnionSet(joint);
+			} else if (invMass1 == dgFloat32 (0.0f)) {
+				dgBody* const root = world->FindRootAndSplit(body0);
+				root->m_disjointInfo.m_jointCount += 1;
+				root->m_disjointInfo.m_rowCount += joint->m_maxDOF;
+			} else {
+				dgBody* const root = world->FindRootAndSplit(body1);
+				root->m_disjointInfo.m_jointCount += 1;
+				root->m_disjointInfo.m_rowCount += joint->m_maxDOF;
+			}
 		}
 	}
 
@@ -278,6 +290,8 @@ void dgWorldDynamicUpdate::BuildClusters(dgFloat32 timestep)
 				cluster.m_bodyCount = 2;
 				cluster.m_jointCount = 0;
 				cluster.m_rowCount = 0;
+				cluster.m_solverPasses = 0;
+				cluster.m_solverResidual = dgFloat32 (0.0f);
 				cluster.m_hasSoftBodies = 0;
 				cluster.m_isContinueCollision = 0;
 				cluster.m_bodyStart = root->m_index;
@@ -308,6 +322,8 @@ void dgWorldDynamicUpdate::BuildClusters(dgFloat32 timestep)
 				cluster.m_bodyCount = root->m_disjointInfo.m_bodyCount + 1;
 				cluster.m_jointCount = root->m_disjointInfo.m_jointCount;
 				cluster.m_rowCount = root->m_disjointInfo.m_rowCount;
+				cluster.m_solverPasses = 0;
+				cluster.m_solverResidual = dgFloat32 (0.0f);
 				cluster.m_hasSoftBodies = 0;
 				cluster.m_bodyStart = root->m_index;
 				cluster.m_isContinueCollision = 0;
@@ -422,6 +438,121 @@ void dgWorldDynamicUpdate::BuildClusters(dgFloat32 timestep)
 	m_softBodiesCount = softBodiesCount;
 }
 
+DG_INLINE dgBody* dgWorldDynamicUpdate::FindRootParallel(dgBody* const body)
+{
+	// path halving, parents only move up the tree so a stale read still lands on an ancestor
+	dgBody* node = body;
+	dgBody* parent = node->m_disjointInfo.m_parent;
+	while (parent != node) {
+		dgBody* const grandParent = parent->m_disjointInfo.m_parent;
+		node->m_disjointInfo.m_parent = grandParent;
+		node = parent;
+		parent = grandParent;
+	}
+	return node;
+}
+
+void dgWorldDynamicUpdate::UnionSetsKernel (void* const context, void* const, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgUnionFindSyncDescriptor* const descriptor = (dgUnionFindSyncDescriptor*) context;
+	const dgJointInfo* const jointArray = descriptor->m_jointArray;
+	const dgInt32 jointCount = descriptor->m_jointCount;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, DG_PARALLEL_UNION_FIND_BATCH); i < jointCount; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, DG_PARALLEL_UNION_FIND_BATCH)) {
+		const dgInt32 count = dgMin (jointCount - i, DG_PARALLEL_UNION_FIND_BATCH);
+		for (dgInt32 j = 0; j < count; j ++) {
+			const dgConstraint* const joint = jointArray[i + j].m_joint;
+			dgBody* const body0 = joint->GetBody0();
+			dgBody* const body1 = joint->GetBody1();
+			if ((body0->m_invMass.m_w > dgFloat32 (0.0f)) && (body1->m_invMass.m_w > dgFloat32 (0.0f))) {
+				for (;;) {
+					dgBody* root0 = FindRootParallel(body0);
+					dgBody* root1 = FindRootParallel(body1);
+					if (root0 == root1) {
+						break;
+					}
+					// always link the higher address root under the lower one, 
+					// this prevents cycles and makes the final root of each set independent of the thread schedule
+					if (root0 > root1) {
+						dgSwap(root0, root1);
+					}
+					if (dgInterlockedCompareExchange((void**)&root1->m_disjointInfo.m_parent, root0, root1) == root1) {
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+void dgWorldDynamicUpdate::CountSetsKernel (void* const context, void* const, dgInt32 threadID)
+{
+	D_TRACKTIME();
+	dgUnionFindSyncDescriptor* const descriptor = (dgUnionFindSyncDescriptor*) context;
+	const dgJointInfo* const jointArray = descriptor->m_jointArray;
+	const dgInt32 jointCount = descriptor->m_jointCount;
+
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, DG_PARALLEL_UNION_FIND_BATCH); i < jointCount; i = dgAtomicExchangeAndAdd(&descriptor->m_atomicCounter, DG_PARALLEL_UNION_FIND_BATCH)) {
+		const dgInt32 count = dgMin (jointCount - i, DG_PARALLEL_UNION_FIND_BATCH);
+		for (dgInt32 j = 0; j < count; j ++) {
+			const dgConstraint* const joint = jointArray[i + j].m_joint;
+			dgBody* const body0 = joint->GetBody0();
+			dgBody* const body1 = joint->GetBody1();
+			dgBody* const body = (body1->m_invMass.m_w == dgFloat32 (0.0f)) ? body0 : body1;
+			dgBody* const root = FindRootParallel(body);
+			dgAtomicExchangeAndAdd(&root->m_disjointInfo.m_jointCount, 1);
+			dgAtomicExchangeAndAdd(&root->m_disjointInfo.m_rowCount, joint->m_maxDOF);
+
+			// each body that is not a root moves its count to the root only once, 
+			// the body count of a non root body is not used after this point.
+			if (body0->m_invMass.m_w > dgFloat32 (0.0f)) {
+				if ((body0 != root) && (dgAtomicExchangeAndAdd(&body0->m_disjointInfo.m_bodyCount, -1) == 1)) {
+					dgAtomicExchangeAndAdd(&root->m_disjointInfo.m_bodyCount, 1);
+				}
+			}
+			if (body1->m_invMass.m_w > dgFloat32 (0.0f)) {
+				if ((body1 != root) && (dgAtomicExchangeAndAdd(&body1->m_disjointInfo.m_bodyCount, -1) == 1)) {
+					dgAtomicExchangeAndAdd(&root->m_disjointInfo.m_bodyCount, 1);
+				}
+			}
+		}
+	}
+}
+
+void dgWorldDynamicUpdate::UnionSetsParallel(dgJointInfo* const jointArray, dgInt32 jointCount)
+{
+	D_TRACKTIME();
+	dgWorld* const world = (dgWorld*) this;
+
+	// the resting flags share a bit field with other body flags, they can not be written concurrently
+	for (dgInt32 i = 0; i < jointCount; i ++) {
+		const dgConstraint* const joint = jointArray[i].m_joint;
+		dgBody* const body0 = joint->GetBody0();
+		dgBody* const body1 = joint->GetBody1(); 
+		dgInt32 resting = body0->m_equilibrium & body1->m_equilibrium;
+		body0->m_resting = resting | (body0->m_invMass.m_w == dgFloat32(0.0f));
+		body1->m_resting = resting | (body1->m_invMass.m_w == dgFloat32(0.0f));
+	}
+
+	dgUnionFindSyncDescriptor descriptor;
+	descriptor.m_jointArray = jointArray;
+	descriptor.m_jointCount = jointCount;
+
+	const dgInt32 threadCount = world->GetThreadCount();
+	descriptor.m_atomicCounter = 0;
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		world->QueueJob (UnionSetsKernel, &descriptor, world, "dgWorldDynamicUpdate::UnionSetsKernel");
+	}
+	world->SynchronizationBarrier();
+
+	descriptor.m_atomicCounter = 0;
+	for (dgInt32 i = 0; i < threadCount; i ++) {
+		world->QueueJob (CountSetsKernel, &descriptor, world, "dgWorldDynamicUpdate::CountSetsKernel");
+	}
+	world->SynchronizationBarrier();
+}
+
 dgInt32 dgWorldDynamicUpdate::CompareBodyJacobianPair(const dgBodyJacobianPair* const infoA, const dgBodyJacobianPair* const infoB, void* notUsed)
 {
 	if (infoA->m_bodyIndex < infoB->m_bodyIndex) {
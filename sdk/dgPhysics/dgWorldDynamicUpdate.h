@@ -35,9 +35,12 @@
 #define	DG_FREEZZING_VELOCITY_DRAG			dgFloat32 (0.9f)
 #define	DG_PSD_DAMP_TOL						dgFloat32 (1.0e-3f)
 #define	DG_SOLVER_MAX_ERROR					(DG_FREEZE_MAG * dgFloat32 (0.5f))
+#define	DG_SOLVER_MIN_CONVERGENCE_RATE		dgFloat32 (0.9f)
 
 #define DG_CCD_EXTRA_CONTACT_COUNT			(8 * 3)
 #define DG_PARALLEL_JOINT_COUNT_CUT_OFF		(64)
+#define DG_PARALLEL_UNION_FIND_CUT_OFF		(2048)
+#define DG_PARALLEL_UNION_FIND_BATCH		(64)
 //#define DG_PARALLEL_JOINT_COUNT_CUT_OFF	(2)
 
 
@@ -116,6 +119,8 @@ class dgBodyCluster
 	dgInt32 m_bodyStart;
 	dgInt32 m_jointStart;	
 	dgInt32 m_rowStart;
+	dgInt32 m_solverPasses;
+	dgFloat32 m_solverResidual;
 	dgInt16 m_hasSoftBodies;
 	dgInt16 m_isContinueCollision;
 };
@@ -248,6 +253,11 @@ class dgWorldDynamicUpdate
 	static dgInt32 CompareClusterInfos (const dgBodyCluster* const clusterA, const dgBodyCluster* const clusterB, void* notUsed);
 
 	void BuildClusters(dgFloat32 timestep);
+	void UnionSetsParallel(dgJointInfo* const jointArray, dgInt32 jointCount);
+
+	static dgBody* FindRootParallel(dgBody* const body);
+	static void UnionSetsKernel (void* const context, void* const worldContext, dgInt32 threadID);
+	static void CountSetsKernel (void* const context, void* const worldContext, dgInt32 threadID);
 
 	dgBodyCluster MergeClusters(const dgBodyCluster* const clusterArray, dgInt32 clustersCount) const;
 	dgInt32 SortClusters(const dgBodyCluster* const cluster, dgFloat32 timestep, dgInt32 threadID) const;
@@ -258,12 +268,12 @@ class dgWorldDynamicUpdate
 
 	void BuildJacobianMatrix (dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
 	void ResolveClusterForces (dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
-	void IntegrateReactionsForces(const dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
+	void IntegrateReactionsForces(dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
 	void BuildJacobianMatrix (const dgBodyInfo* const bodyInfo, dgJointInfo* const jointInfo, dgJacobian* const internalForces, dgLeftHandSide* const matrixRow, dgRightHandSide* const rightHandSide, dgFloat32 forceImpulseScale) const;
-	void CalculateClusterReactionForces(const dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
+	void CalculateClusterReactionForces(dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const;
 
 	void IntegrateInslandParallel(dgParallelClusterArray* const clusters, dgInt32 threadID);
-	void CalculateReactionForcesParallel(const dgBodyCluster* const clusters, dgInt32 clustersCount, dgFloat32 timestep);
+	void CalculateReactionForcesParallel(dgBodyCluster* const clusters, dgInt32 clustersCount, dgFloat32 timestep);
 
 	dgFloat32 CalculateJointForce(const dgJointInfo* const jointInfo, const dgBodyInfo* const bodyArray, dgJacobian* const internalForces, const dgLeftHandSide* const matrixRow, dgRightHandSide* const rightHandSide) const;
 	dgFloat32 CalculateJointForce_3_13(const dgJointInfo* const jointInfo, const dgBodyInfo* const bodyArray, dgJacobian* const internalForces, const dgLeftHandSide* const matrixRow, dgRightHandSide* const rightHandSide) const;
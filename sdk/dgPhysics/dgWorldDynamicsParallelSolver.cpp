@@ -49,7 +49,7 @@ class dgWorldDynamicUpdate::dgParallelClusterArray
 	dgInt32 m_atomicIndex;
 };
 
-void dgWorldDynamicUpdate::CalculateReactionForcesParallel(const dgBodyCluster* const clusterArray, dgInt32 clustersCount, dgFloat32 timestep)
+void dgWorldDynamicUpdate::CalculateReactionForcesParallel(dgBodyCluster* const clusterArray, dgInt32 clustersCount, dgFloat32 timestep)
 {
 	DG_TRACKTIME();
 	dgWorld* const world = (dgWorld*) this;
@@ -59,10 +59,15 @@ void dgWorldDynamicUpdate::CalculateReactionForcesParallel(const dgBodyCluster*
 	dgJointInfo* const jointArray = &world->m_jointsMemory[m_joints];
 
 	if (world->GetCurrentPlugin()) {
+		// plugins run a fixed number of passes, they do not apply the iteration budget nor report convergence stats
 		dgWorldPlugin* const plugin = world->GetCurrentPlugin()->GetInfo().m_plugin;
 		plugin->CalculateJointForces(cluster, bodyArray, jointArray, timestep);
 	} else {
 		m_parallelSolver.CalculateJointForces(cluster, bodyArray, jointArray, timestep);
+		for (dgInt32 i = 0; i < clustersCount; i++) {
+			clusterArray[i].m_solverPasses = m_parallelSolver.m_passCount;
+			clusterArray[i].m_solverResidual = m_parallelSolver.m_residual;
+		}
 	}
 
 	dgParallelClusterArray integrateCluster(clusterArray, clustersCount, timestep);
@@ -160,6 +165,8 @@ dgBodyCluster dgWorldDynamicUpdate::MergeClusters(const dgBodyCluster* const clu
 	cluster.m_rowCount = rowsCount;
 
 	cluster.m_rowStart = 0;
+	cluster.m_solverPasses = 0;
+	cluster.m_solverResidual = dgFloat32(0.0f);
 	cluster.m_isContinueCollision = 0;
 	cluster.m_hasSoftBodies = 0;
 
@@ -836,7 +843,24 @@ void dgParallelBodySolver::InitSkeletons(dgInt32 threadID)
 
 	for (dgInt32 i = threadID; i < count; i += threadCounts) {
 		dgSkeletonContainer* const skeleton = skeletonArray[i];
-		skeleton->InitMassMatrix(m_jointArray, leftHandSide, rightHandSide);
+		if (skeleton->m_subtreeCount) {
+			skeleton->InitTrunkMassMatrix(m_jointArray, leftHandSide, rightHandSide);
+		} else {
+			skeleton->InitMassMatrix(m_jointArray, leftHandSide, rightHandSide);
+		}
+	}
+}
+
+void dgParallelBodySolver::InitSkeletonSubtrees(dgInt32 threadID)
+{
+	dgRightHandSide* const rightHandSide = &m_world->m_solverMemory.m_righHandSizeBuffer[0];
+	const dgLeftHandSide* const leftHandSide = &m_world->m_solverMemory.m_leftHandSizeBuffer[0];
+
+	const dgInt32 count = m_skeletonSubtreeCount;
+	const dgSkeletonSubtree* const subtreeArray = &m_skeletonSubtreeArray[0];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1)) {
+		const dgSkeletonSubtree& subtree = subtreeArray[i];
+		subtree.m_skeleton->InitSubtreeMassMatrix(m_jointArray, leftHandSide, rightHandSide, subtree.m_subtree);
 	}
 }
 
@@ -849,7 +873,51 @@ void dgParallelBodySolver::UpdateSkeletons(dgInt32 threadID)
 
 	for (dgInt32 i = threadID; i < count; i += threadCounts) {
 		dgSkeletonContainer* const skeleton = skeletonArray[i];
-		skeleton->CalculateJointForce(m_jointArray, m_bodyArray, internalForces);
+		if (skeleton->m_subtreeCount && (skeleton->m_solverMode == dgSkeletonContainer::m_tree)) {
+			skeleton->UpdateSubtreeForces(m_jointArray, internalForces);
+		} else {
+			skeleton->CalculateJointForce(m_jointArray, m_bodyArray, internalForces);
+		}
+	}
+}
+
+void dgParallelBodySolver::SolveSkeletonSubtreesForward(dgInt32 threadID)
+{
+	const dgInt32 count = m_skeletonSubtreeCount;
+	const dgSkeletonSubtree* const subtreeArray = &m_skeletonSubtreeArray[0];
+	const dgJacobian* const internalForces = &m_world->m_solverMemory.m_internalForcesBuffer[0];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1)) {
+		const dgSkeletonSubtree& subtree = subtreeArray[i];
+		if (subtree.m_skeleton->m_solverMode == dgSkeletonContainer::m_tree) {
+			subtree.m_skeleton->SolveSubtreeForward(m_jointArray, internalForces, subtree.m_subtree);
+		}
+	}
+}
+
+void dgParallelBodySolver::SolveSkeletonTrunks(dgInt32 threadID)
+{
+	const dgInt32 count = m_skeletonCount;
+	const dgInt32 threadCounts = m_world->GetThreadCount();
+	dgSkeletonContainer** const skeletonArray = &m_skeletonArray[0];
+	const dgJacobian* const internalForces = &m_world->m_solverMemory.m_internalForcesBuffer[0];
+
+	for (dgInt32 i = threadID; i < count; i += threadCounts) {
+		dgSkeletonContainer* const skeleton = skeletonArray[i];
+		if (skeleton->m_subtreeCount && (skeleton->m_solverMode == dgSkeletonContainer::m_tree)) {
+			skeleton->SolveTrunk(m_jointArray, internalForces);
+		}
+	}
+}
+
+void dgParallelBodySolver::SolveSkeletonSubtreesBackward(dgInt32 threadID)
+{
+	const dgInt32 count = m_skeletonSubtreeCount;
+	const dgSkeletonSubtree* const subtreeArray = &m_skeletonSubtreeArray[0];
+	for (dgInt32 i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1); i < count; i = dgAtomicExchangeAndAdd(&m_skeletonSubtreeAtomicIndex, 1)) {
+		const dgSkeletonSubtree& subtree = subtreeArray[i];
+		if (subtree.m_skeleton->m_solverMode == dgSkeletonContainer::m_tree) {
+			subtree.m_skeleton->SolveSubtreeBackward(subtree.m_subtree);
+		}
 	}
 }
 
@@ -865,9 +933,55 @@ void dgParallelBodySolver::UpdateSkeletonsKernel(void* const context, void* cons
 	me->UpdateSkeletons(threadID);
 }
 
+void dgParallelBodySolver::InitSkeletonSubtreesKernel(void* const context, void* const, dgInt32 threadID)
+{
+	dgParallelBodySolver* const me = (dgParallelBodySolver*)context;
+	me->InitSkeletonSubtrees(threadID);
+}
+
+void dgParallelBodySolver::SolveSkeletonTrunksKernel(void* const context, void* const, dgInt32 threadID)
+{
+	dgParallelBodySolver* const me = (dgParallelBodySolver*)context;
+	me->SolveSkeletonTrunks(threadID);
+}
+
+void dgParallelBodySolver::SolveSkeletonSubtreesForwardKernel(void* const context, void* const, dgInt32 threadID)
+{
+	dgParallelBodySolver* const me = (dgParallelBodySolver*)context;
+	me->SolveSkeletonSubtreesForward(threadID);
+}
+
+void dgParallelBodySolver::SolveSkeletonSubtreesBackwardKernel(void* const context, void* const, dgInt32 threadID)
+{
+	dgParallelBodySolver* const me = (dgParallelBodySolver*)context;
+	me->SolveSkeletonSubtreesBackward(threadID);
+}
+
 void dgParallelBodySolver::InitSkeletons()
 {
 	const dgInt32 threadCounts = m_world->GetThreadCount();
+
+	// large skeletons are split into independent branches that are factorized concurrently, 
+	// the trunk of each skeleton joins them after the barrier.
+	m_skeletonSubtreeCount = 0;
+	for (dgInt32 i = 0; i < m_skeletonCount; i++) {
+		dgSkeletonContainer* const skeleton = m_skeletonArray[i];
+		const dgInt32 subtreeCount = skeleton->InitParallelPartition(threadCounts);
+		for (dgInt32 j = 0; j < subtreeCount; j++) {
+			m_skeletonSubtreeArray[m_skeletonSubtreeCount].m_skeleton = skeleton;
+			m_skeletonSubtreeArray[m_skeletonSubtreeCount].m_subtree = j;
+			m_skeletonSubtreeCount++;
+		}
+	}
+
+	if (m_skeletonSubtreeCount) {
+		m_skeletonSubtreeAtomicIndex = 0;
+		for (dgInt32 i = 0; i < threadCounts; i++) {
+			m_world->QueueJob(InitSkeletonSubtreesKernel, this, NULL, "dgParallelBodySolver::InitSkeletonSubtrees");
+		}
+		m_world->SynchronizationBarrier();
+	}
+
 	for (dgInt32 i = 0; i < threadCounts; i++) {
 		m_world->QueueJob(InitSkeletonsKernel, this, NULL, "dgParallelBodySolver::InitSkeletonsKernel");
 	}
@@ -877,6 +991,25 @@ void dgParallelBodySolver::InitSkeletons()
 void dgParallelBodySolver::UpdateSkeletons()
 {
 	const dgInt32 threadCounts = m_world->GetThreadCount();
+	if (m_skeletonSubtreeCount) {
+		m_skeletonSubtreeAtomicIndex = 0;
+		for (dgInt32 i = 0; i < threadCounts; i++) {
+			m_world->QueueJob(SolveSkeletonSubtreesForwardKernel, this, NULL, "dgParallelBodySolver::SolveSkeletonSubtreesForward");
+		}
+		m_world->SynchronizationBarrier();
+
+		for (dgInt32 i = 0; i < threadCounts; i++) {
+			m_world->QueueJob(SolveSkeletonTrunksKernel, this, NULL, "dgParallelBodySolver::SolveSkeletonTrunks");
+		}
+		m_world->SynchronizationBarrier();
+
+		m_skeletonSubtreeAtomicIndex = 0;
+		for (dgInt32 i = 0; i < threadCounts; i++) {
+			m_world->QueueJob(SolveSkeletonSubtreesBackwardKernel, this, NULL, "dgParallelBodySolver::SolveSkeletonSubtreesBackward");
+		}
+		m_world->SynchronizationBarrier();
+	}
+
 	for (dgInt32 i = 0; i < threadCounts; i++) {
 		m_world->QueueJob(UpdateSkeletonsKernel, this, NULL, "dgParallelBodySolver::UpdateSkeletons");
 	}
@@ -1334,20 +1467,35 @@ void dgParallelBodySolver::CalculateJointsForce(dgInt32 threadID)
 void dgParallelBodySolver::CalculateForces()
 {
 	const dgInt32 passes = m_solverPasses;
+	const dgInt32 maxPasses = passes + m_world->GetSolverMaxIterations() - m_world->GetSolverIterations();
 	m_firstPassCoef = dgFloat32(0.0f);
+	m_passCount = 0;
+	m_residual = dgFloat32(0.0f);
 	const dgInt32 threadCounts = m_world->GetThreadCount();
 
 	InitSkeletons();
 	for (dgInt32 step = 0; step < 4; step++) {
 		CalculateJointsAcceleration();
 		dgFloat32 accNorm = DG_SOLVER_MAX_ERROR * dgFloat32(2.0f);
-		for (dgInt32 k = 0; (k < passes) && (accNorm > DG_SOLVER_MAX_ERROR); k++) {
+		dgFloat32 prevAccNorm = accNorm;
+		dgFloat32 residual = dgFloat32(0.0f);
+		for (dgInt32 k = 0; (k < maxPasses) && (accNorm > DG_SOLVER_MAX_ERROR); k++) {
+			if ((k >= passes) && (accNorm > prevAccNorm * DG_SOLVER_MIN_CONVERGENCE_RATE)) {
+				break;
+			}
 			CalculateJointsForce();
+			m_passCount++;
+			prevAccNorm = accNorm;
 			accNorm = dgFloat32(0.0f);
+			residual = dgFloat32(0.0f);
 			for (dgInt32 i = 0; i < threadCounts; i++) {
 				accNorm = dgMax(accNorm, m_accelNorm[i]);
+				residual += m_accelNorm[i];
 			}
 		}
+		// the exit test uses the largest thread partial sum, the stats report the 
+		// sum over all joints like the single island solver, so it does not depend on the thread count
+		m_residual = dgMax(m_residual, residual);
 		UpdateSkeletons();
 		IntegrateBodiesVelocity();
 	}
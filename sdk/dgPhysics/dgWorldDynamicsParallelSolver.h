@@ -205,6 +205,13 @@ class dgParallelBodySolver
 		dgInt32 m_lock;
 	};
 
+	class dgSkeletonSubtree
+	{
+		public:
+		dgSkeletonContainer* m_skeleton;
+		dgInt32 m_subtree;
+	};
+
 	~dgParallelBodySolver() {}
 	dgParallelBodySolver(dgMemoryAllocator* const allocator);
 
@@ -227,6 +234,10 @@ class dgParallelBodySolver
 	void InitBodyArray(dgInt32 threadID);
 	void InitSkeletons(dgInt32 threadID);
 	void UpdateSkeletons(dgInt32 threadID);
+	void InitSkeletonSubtrees(dgInt32 threadID);
+	void SolveSkeletonTrunks(dgInt32 threadID);
+	void SolveSkeletonSubtreesForward(dgInt32 threadID);
+	void SolveSkeletonSubtreesBackward(dgInt32 threadID);
 	void InitJacobianMatrix(dgInt32 threadID);
 	void UpdateForceFeedback(dgInt32 threadID);
 	void TransposeMassMatrix(dgInt32 threadID);
@@ -240,6 +251,10 @@ class dgParallelBodySolver
 	static void InitSkeletonsKernel(void* const context, void* const, dgInt32 threadID);
 	static void InitBodyArrayKernel(void* const context, void* const, dgInt32 threadID);
 	static void UpdateSkeletonsKernel(void* const context, void* const, dgInt32 threadID);
+	static void SolveSkeletonTrunksKernel(void* const context, void* const, dgInt32 threadID);
+	static void InitSkeletonSubtreesKernel(void* const context, void* const, dgInt32 threadID);
+	static void SolveSkeletonSubtreesForwardKernel(void* const context, void* const, dgInt32 threadID);
+	static void SolveSkeletonSubtreesBackwardKernel(void* const context, void* const, dgInt32 threadID);
 	static void InitJacobianMatrixKernel(void* const context, void* const, dgInt32 threadID);
 	static void UpdateForceFeedbackKernel(void* const context, void* const, dgInt32 threadID);
 	static void TransposeMassMatrixKernel(void* const context, void* const, dgInt32 threadID);
@@ -269,15 +284,20 @@ class dgParallelBodySolver
 	dgFloat32 m_timestepRK;
 	dgFloat32 m_invTimestepRK;
 	dgFloat32 m_firstPassCoef;
+	dgFloat32 m_residual;
 	dgFloat32 m_accelNorm[DG_MAX_THREADS_HIVE_COUNT];
 	dgInt32 m_hasJointFeeback[DG_MAX_THREADS_HIVE_COUNT];
 	dgArray<dgSkeletonContainer*> m_skeletonArray; 
+	dgArray<dgSkeletonSubtree> m_skeletonSubtreeArray;
 
 	dgInt32 m_jointCount;
 	dgInt32 m_solverPasses;
+	dgInt32 m_passCount;
 	dgInt32 m_threadCounts;
 	dgInt32 m_soaRowsCount;
 	dgInt32 m_skeletonCount;
+	dgInt32 m_skeletonSubtreeCount;
+	dgInt32 m_skeletonSubtreeAtomicIndex;
 	dgInt32 m_jacobianMatrixRowAtomicIndex;
 	dgInt32* m_soaRowStart;
 	dgInt32* m_bodyRowStart;
@@ -302,12 +322,17 @@ DG_INLINE dgParallelBodySolver::dgParallelBodySolver(dgMemoryAllocator* const al
 	,m_timestepRK(dgFloat32(0.0f))
 	,m_invTimestepRK(dgFloat32(0.0f))
 	,m_firstPassCoef(dgFloat32(0.0f))
+	,m_residual(dgFloat32(0.0f))
 	,m_skeletonArray(allocator)
+	,m_skeletonSubtreeArray(allocator)
 	,m_jointCount(0)
 	,m_solverPasses(0)
+	,m_passCount(0)
 	,m_threadCounts(0)
 	,m_soaRowsCount(0)
 	,m_skeletonCount(0)
+	,m_skeletonSubtreeCount(0)
+	,m_skeletonSubtreeAtomicIndex(0)
 	,m_jacobianMatrixRowAtomicIndex(0)
 	,m_soaRowStart(NULL)
 	,m_bodyRowStart(NULL)
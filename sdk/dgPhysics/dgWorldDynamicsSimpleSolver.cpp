@@ -980,7 +980,7 @@ void dgWorldDynamicUpdate::CalculateNetAcceleration(dgBody* const body, const dg
 }
 
 
-void dgWorldDynamicUpdate::IntegrateReactionsForces(const dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const
+void dgWorldDynamicUpdate::IntegrateReactionsForces(dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const
 {
 	if (cluster->m_jointCount == 0) {
 		IntegrateExternalForce(cluster, timestep, threadID);
@@ -1247,7 +1247,7 @@ dgJacobian dgWorldDynamicUpdate::IntegrateForceAndToque(dgDynamicBody* const bod
 }
 
 
-void dgWorldDynamicUpdate::CalculateClusterReactionForces(const dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const
+void dgWorldDynamicUpdate::CalculateClusterReactionForces(dgBodyCluster* const cluster, dgInt32 threadID, dgFloat32 timestep) const
 {
 	D_TRACKTIME();
 	dgWorld* const world = (dgWorld*) this;
@@ -1293,7 +1293,10 @@ void dgWorldDynamicUpdate::CalculateClusterReactionForces(const dgBodyCluster* c
 	}
 
 	const dgInt32 passes = world->m_solverIterations;
+	const dgInt32 maxPasses = world->GetSolverMaxIterations();
 	const dgFloat32 maxAccNorm = DG_SOLVER_MAX_ERROR * DG_SOLVER_MAX_ERROR;
+	dgInt32 passCount = 0;
+	dgFloat32 residual = dgFloat32(0.0f);
 	for (dgInt32 step = 0; step < derivativesEvaluationsRK4; step++) {
 
 		for (dgInt32 i = 0; i < jointCount; i++) {
@@ -1309,7 +1312,14 @@ void dgWorldDynamicUpdate::CalculateClusterReactionForces(const dgBodyCluster* c
 		joindDesc.m_firstPassCoefFlag = dgFloat32(1.0f);
 	
 		dgFloat32 accNorm = maxAccNorm * dgFloat32(2.0f);
-		for (dgInt32 i = 0; (i < passes) && (accNorm > maxAccNorm); i++) {
+		dgFloat32 prevAccNorm = accNorm;
+		for (dgInt32 i = 0; (i < maxPasses) && (accNorm > maxAccNorm); i++) {
+			// past the base budget keep iterating only while the residual is still dropping
+			if ((i >= passes) && (accNorm > prevAccNorm * DG_SOLVER_MIN_CONVERGENCE_RATE)) {
+				break;
+			}
+			passCount++;
+			prevAccNorm = accNorm;
 			accNorm = dgFloat32(0.0f);
 			for (dgInt32 j = 0; j < jointCount; j++) {
 				dgJointInfo* const jointInfo = &constraintArray[j];
@@ -1321,6 +1331,7 @@ void dgWorldDynamicUpdate::CalculateClusterReactionForces(const dgBodyCluster* c
 				}
 			}
 		}
+		residual = dgMax(residual, accNorm);
 		for (dgInt32 j = 0; j < skeletonCount; j++) {
 			skeletonArray[j]->CalculateJointForce(constraintArray, bodyArray, internalForces);
 		}
@@ -1363,6 +1374,9 @@ void dgWorldDynamicUpdate::CalculateClusterReactionForces(const dgBodyCluster* c
 		}
 	}
 
+	cluster->m_solverPasses += passCount;
+	cluster->m_solverResidual = dgMax(cluster->m_solverResidual, residual);
+
 	dgInt32 hasJointFeeback = 0;
 	if (timestepRK != dgFloat32(0.0f)) {
 		for (dgInt32 i = 0; i < jointCount; i++) {